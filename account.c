@@ -1,9 +1,55 @@
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+#include <limits.h>
 #include <pthread.h>
+#include <time.h>
 #include "account.h"
+#include "dashboard.h"
+#include "metrics.h"
+#include "timeutil.h"
 #include "visualization.h"
 
+// 导出的指标，account_register_metrics 之前都是NULL，更新时不做任何事
+static Metric *accounts_metric;
+static Metric *balance_metric;
+static Metric *deposits_metric;
+static Metric *withdrawals_metric;
+static Metric *transfers_ok_metric;
+static Metric *transfers_failed_metric;
+static Metric *lock_waits_metric;
+static Metric *amount_metric;
+static Metric *duration_metric;
+
+/**
+ * 注册账户与转账相关的指标。只更新原子变量，抓取时不需要获取任何账户锁
+ */
+void account_register_metrics() {
+    static const double amount_bounds[] = { 10, 50, 100, 250, 500, 1000, 5000 };
+    static const double duration_bounds[] = { 1e-6, 5e-6, 1e-5, 5e-5, 1e-4, 5e-4, 1e-3, 1e-2 };
+
+    accounts_metric = metrics_gauge("bank_accounts", "当前账户数", NULL);
+    balance_metric = metrics_gauge("bank_balance_total", "所有账户余额之和", NULL);
+    deposits_metric = metrics_counter("bank_deposits_total", "存款操作次数（含转账入账）", NULL);
+    withdrawals_metric = metrics_counter("bank_withdrawals_total", "取款操作次数（含转账出账）", NULL);
+    transfers_ok_metric = metrics_counter("bank_transfers_total", "转账次数", "result=\"ok\"");
+    transfers_failed_metric = metrics_counter("bank_transfers_total", "转账次数", "result=\"failed\"");
+    lock_waits_metric = metrics_counter("bank_lock_waits_total", "加锁时账户锁已被占用的次数", NULL);
+    amount_metric = metrics_histogram("bank_transfer_amount", "转账金额", NULL, amount_bounds,
+                                      sizeof(amount_bounds) / sizeof(amount_bounds[0]));
+    duration_metric = metrics_histogram("bank_transfer_duration_seconds", "转账耗时（含等待账户锁）", NULL,
+                                        duration_bounds, sizeof(duration_bounds) / sizeof(duration_bounds[0]));
+}
+
+// 加锁，锁已被其他线程持有时计入仪表盘的锁等待次数
+static void lock_account(Account* account) {
+    if (pthread_mutex_trylock(&account->mutex) != 0) {
+        dashboard_count(DASH_LOCK_WAITS, 1);
+        metric_inc(lock_waits_metric, 1);
+        pthread_mutex_lock(&account->mutex);
+    }
+}
+
 /**
  * 创建一个新账户
  * @param id 账户ID
@@ -25,6 +71,7 @@ Account* create_account(int id, double initial_balance) {
     // 初始化余额历史记录
     new_account->history_capacity = 20;
     new_account->history_size = 0;
+    new_account->history_limit = 0;
     new_account->history = (double*)malloc(sizeof(double) * new_account->history_capacity);
     
     if (new_account->history == NULL) {
@@ -44,6 +91,8 @@ Account* create_account(int id, double initial_balance) {
         return NULL;
     }
     
+    metric_add(accounts_metric, 1);
+    metric_add(balance_metric, initial_balance);
     print_colored("账户 %d 创建成功，初始余额: ¥%.2f\n", CYAN, id, initial_balance);
     return new_account;
 }
@@ -55,6 +104,9 @@ Account* create_account(int id, double initial_balance) {
 void destroy_account(Account* account) {
     if (account == NULL) return;
     
+    metric_add(accounts_metric, -1);
+    metric_add(balance_metric, -account->balance);
+    
     // 销毁互斥锁
     pthread_mutex_destroy(&account->mutex);
     
@@ -73,13 +125,23 @@ void destroy_account(Account* account) {
 
 /**
  * 记录账户余额历史
+ * 设置了 history_limit 时，记录数达到上限后只保留较新的一半，数组仍按时间顺序排列
  * @param account 目标账户
  */
 void record_balance_history(Account* account) {
     if (account == NULL) return;
     
+    if (account->history_limit > 0 && account->history_size >= account->history_limit) {
+        int keep = account->history_limit / 2;
+        memmove(account->history, account->history + account->history_size - keep, sizeof(double) * keep);
+        account->history_size = keep;
+    }
+    
     // 如果需要扩展历史记录数组
     if (account->history_size >= account->history_capacity) {
+        if (account->history_capacity > INT_MAX / 2) {
+            return; // 容量已达上限，不记录此次历史
+        }
         int new_capacity = account->history_capacity * 2;
         double* new_history = (double*)realloc(account->history, 
                                              sizeof(double) * new_capacity);
@@ -107,6 +169,8 @@ int deposit(Account* account, double amount) {
     
     // 更新余额
     account->balance += amount;
+    metric_inc(deposits_metric, 1);
+    metric_add(balance_metric, amount);
     
     // 记录历史
     record_balance_history(account);
@@ -137,6 +201,8 @@ int withdraw(Account* account, double amount) {
     
     // 更新余额
     account->balance -= amount;
+    metric_inc(withdrawals_metric, 1);
+    metric_add(balance_metric, -amount);
     
     // 记录历史
     record_balance_history(account);
@@ -160,6 +226,7 @@ int transfer(Account* from, Account* to, double amount) {
     }
     
     int result = -1;
+    double start = duration_metric != NULL ? now_ms() : 0.0;
     
     // 根据账户ID确定锁定顺序，防止死锁
     Account* first = (from->account_id < to->account_id) ? from : to;
@@ -170,9 +237,9 @@ int transfer(Account* from, Account* to, double amount) {
     
     // 按顺序锁定账户
     print_colored("正在锁定账户 %d\n", BLUE, first->account_id);
-    pthread_mutex_lock(&first->mutex);
+    lock_account(first);
     print_colored("正在锁定账户 %d\n", BLUE, second->account_id);
-    pthread_mutex_lock(&second->mutex);
+    lock_account(second);
     
     // 执行转账
     if (withdraw(from, amount) == 0) {
@@ -195,6 +262,12 @@ int transfer(Account* from, Account* to, double amount) {
     print_colored("解锁账户 %d\n", BLUE, first->account_id);
     pthread_mutex_unlock(&first->mutex);
     
+    dashboard_count(result == 0 ? DASH_TRANSFERS : DASH_FAILURES, 1);
+    metric_inc(result == 0 ? transfers_ok_metric : transfers_failed_metric, 1);
+    metric_observe(amount_metric, amount);
+    if (duration_metric != NULL) {
+        metric_observe(duration_metric, (now_ms() - start) / 1000.0);
+    }
     return result;
 }
 
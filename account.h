@@ -11,6 +11,7 @@ typedef struct {
     double* history;         // 余额历史记录
     int history_size;        // 历史记录大小
     int history_capacity;    // 历史记录容量
+    int history_limit;       // 最多保留的历史条数，0 表示不限制
 } Account;
 
 // 交易结构
@@ -28,5 +29,6 @@ int withdraw(Account* account, double amount);
 int transfer(Account* from, Account* to, double amount);
 void print_account_info(Account* account);
 void record_balance_history(Account* account);
+void account_register_metrics();
 
 #endif // ACCOUNT_H
\ No newline at end of file
@@ -0,0 +1,716 @@
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <math.h>
+#include <signal.h>
+#include <time.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include "bank_server.h"
+#include "metrics.h"
+#include "timeutil.h"
+#include "visualization.h"
+
+#define SERVER_EVENTS 64            // 每次 epoll_wait 最多取回的事件数
+#define SERVER_BACKLOG 128
+#define SERVER_OUT_SIZE (SERVER_BUFFER_SIZE / sizeof(BankRequest) * sizeof(BankResponse))
+
+// 一个客户端连接，只由接管它的工作线程访问
+typedef struct Connection {
+    int fd;
+    int writing;                // 应答没有写完，正在等待 EPOLLOUT（此时不再读取新请求）
+    size_t in_length;
+    size_t out_length;
+    size_t out_sent;
+    struct Connection *prev;
+    struct Connection *next;
+    char in[SERVER_BUFFER_SIZE];
+    char out[SERVER_OUT_SIZE];
+} Connection;
+
+// 工作线程：各自有一个 epoll 实例，接收线程通过管道把新连接的描述符交给它
+typedef struct {
+    int epoll_fd;
+    int pipe_read;
+    int pipe_write;
+    pthread_t thread;
+    Connection *connections;    // 该线程当前的所有连接
+    unsigned long long requests;
+    unsigned long long accepted;
+} ServerWorker;
+
+static Account **server_accounts = NULL;
+static int num_server_accounts = 0;
+
+// 停止信号写入这个管道，唤醒接收线程
+static int stop_pipe[2] = { -1, -1 };
+
+static Metric *requests_metric;
+static Metric *connections_metric;
+
+static Account* find_account(int id) {
+    if (id < 1 || id > num_server_accounts) return NULL;
+    return server_accounts[id - 1];
+}
+
+static double locked_balance(Account *account) {
+    pthread_mutex_lock(&account->mutex);
+    double balance = account->balance;
+    pthread_mutex_unlock(&account->mutex);
+    return balance;
+}
+
+// 执行一个请求。存取款在这里加账户锁，转账由 transfer 按账户ID顺序加锁
+static void execute_request(const BankRequest *request, BankResponse *response) {
+    response->tag = request->tag;
+    response->status = BANK_OK;
+    response->balance = 0.0;
+
+    if (request->op < BANK_OP_QUERY || request->op > BANK_OP_TRANSFER) {
+        response->status = BANK_ERR_OP;
+        return;
+    }
+    Account *account = find_account(request->account);
+    if (account == NULL) {
+        response->status = BANK_ERR_ACCOUNT;
+        return;
+    }
+    if (request->op != BANK_OP_QUERY && !(isfinite(request->amount) && request->amount > 0)) {
+        response->status = BANK_ERR_AMOUNT;
+        response->balance = locked_balance(account);
+        return;
+    }
+
+    switch (request->op) {
+        case BANK_OP_QUERY:
+            response->balance = locked_balance(account);
+            break;
+        case BANK_OP_DEPOSIT:
+            pthread_mutex_lock(&account->mutex);
+            deposit(account, request->amount);
+            response->balance = account->balance;
+            pthread_mutex_unlock(&account->mutex);
+            break;
+        case BANK_OP_WITHDRAW:
+            pthread_mutex_lock(&account->mutex);
+            if (withdraw(account, request->amount) != 0) {
+                response->status = BANK_ERR_FUNDS;
+            }
+            response->balance = account->balance;
+            pthread_mutex_unlock(&account->mutex);
+            break;
+        case BANK_OP_TRANSFER: {
+            // 同一账户加两次锁会死锁，直接拒绝
+            Account *to = find_account(request->to_account);
+            if (to == NULL || to == account) {
+                response->status = BANK_ERR_ACCOUNT;
+            } else if (transfer(account, to, request->amount) != 0) {
+                response->status = BANK_ERR_FUNDS;
+            }
+            response->balance = locked_balance(account);
+            break;
+        }
+    }
+}
+
+static void close_connection(ServerWorker *worker, Connection *conn) {
+    epoll_ctl(worker->epoll_fd, EPOLL_CTL_DEL, conn->fd, NULL);
+    close(conn->fd);
+    if (conn->prev != NULL) conn->prev->next = conn->next;
+    else worker->connections = conn->next;
+    if (conn->next != NULL) conn->next->prev = conn->prev;
+    free(conn);
+    metric_add(connections_metric, -1);
+}
+
+static void watch(ServerWorker *worker, Connection *conn, unsigned int events) {
+    struct epoll_event event;
+    event.events = events;
+    event.data.ptr = conn;
+    epoll_ctl(worker->epoll_fd, EPOLL_CTL_MOD, conn->fd, &event);
+}
+
+/**
+ * 尽量写出待发的应答。写不完时改为等待可写，写完后恢复读取
+ * @return 成功返回0，连接出错返回-1
+ */
+static int flush_output(ServerWorker *worker, Connection *conn) {
+    while (conn->out_sent < conn->out_length) {
+        ssize_t n = send(conn->fd, conn->out + conn->out_sent, conn->out_length - conn->out_sent,
+                         MSG_NOSIGNAL);
+        if (n < 0 && errno == EINTR) continue;
+        if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            if (!conn->writing) {
+                conn->writing = 1;
+                watch(worker, conn, EPOLLOUT);
+            }
+            return 0;
+        }
+        if (n < 0) return -1;
+        conn->out_sent += (size_t)n;
+    }
+
+    conn->out_length = 0;
+    conn->out_sent = 0;
+    if (conn->writing) {
+        conn->writing = 0;
+        watch(worker, conn, EPOLLIN);
+    }
+    return 0;
+}
+
+/**
+ * 读取一次，执行缓冲区中所有完整的请求，应答一次写出。
+ * 客户端流水线发送的请求在一次读取中成批到达，系统调用次数与请求数无关
+ * @return 成功返回0，连接已关闭或出错返回-1
+ */
+static int handle_input(ServerWorker *worker, Connection *conn) {
+    ssize_t n = recv(conn->fd, conn->in + conn->in_length, sizeof(conn->in) - conn->in_length, 0);
+    if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR)) return 0;
+    if (n <= 0) return -1;
+    conn->in_length += (size_t)n;
+
+    size_t count = conn->in_length / sizeof(BankRequest);
+    for (size_t i = 0; i < count; i++) {
+        BankRequest request;
+        BankResponse response;
+        memcpy(&request, conn->in + i * sizeof(BankRequest), sizeof(request));
+        execute_request(&request, &response);
+        memcpy(conn->out + i * sizeof(BankResponse), &response, sizeof(response));
+    }
+
+    // 不完整的请求留在缓冲区开头，等待下次读取补齐
+    size_t used = count * sizeof(BankRequest);
+    memmove(conn->in, conn->in + used, conn->in_length - used);
+    conn->in_length -= used;
+
+    worker->requests += count;
+    metric_inc(requests_metric, count);
+    conn->out_length = count * sizeof(BankResponse);
+    conn->out_sent = 0;
+    return flush_output(worker, conn);
+}
+
+// 接管接收线程交来的新连接，管道关闭时返回-1
+static int adopt_connections(ServerWorker *worker) {
+    int fds[64];
+    while (1) {
+        ssize_t n = read(worker->pipe_read, fds, sizeof(fds));
+        if (n < 0 && errno == EINTR) continue;
+        if (n < 0) return 0;
+        if (n == 0) return -1;
+
+        for (size_t i = 0; i < (size_t)n / sizeof(int); i++) {
+            Connection *conn = (Connection*)malloc(sizeof(Connection));
+            if (conn == NULL) {
+                close(fds[i]);
+                continue;
+            }
+            memset(conn, 0, offsetof(Connection, in));
+            conn->fd = fds[i];
+
+            struct epoll_event event;
+            event.events = EPOLLIN;
+            event.data.ptr = conn;
+            if (epoll_ctl(worker->epoll_fd, EPOLL_CTL_ADD, conn->fd, &event) != 0) {
+                close(conn->fd);
+                free(conn);
+                continue;
+            }
+            conn->next = worker->connections;
+            if (worker->connections != NULL) worker->connections->prev = conn;
+            worker->connections = conn;
+            worker->accepted++;
+            metric_add(connections_metric, 1);
+        }
+    }
+}
+
+// 工作线程的事件循环，接收线程关闭管道后关闭所有连接并退出
+static void* server_worker(void *arg) {
+    ServerWorker *worker = (ServerWorker*)arg;
+    struct epoll_event events[SERVER_EVENTS];
+    int running = 1;
+
+    while (running) {
+        int n = epoll_wait(worker->epoll_fd, events, SERVER_EVENTS, -1);
+        if (n < 0 && errno == EINTR) continue;
+        if (n < 0) break;
+
+        for (int i = 0; i < n; i++) {
+            Connection *conn = (Connection*)events[i].data.ptr;
+            if (conn == NULL) {
+                if (adopt_connections(worker) != 0) running = 0;
+                continue;
+            }
+
+            int result = 0;
+            if (conn->writing) {
+                if (events[i].events & (EPOLLOUT | EPOLLERR | EPOLLHUP)) {
+                    result = flush_output(worker, conn);
+                }
+            } else if (events[i].events & (EPOLLIN | EPOLLERR | EPOLLHUP)) {
+                result = handle_input(worker, conn);
+            }
+            if (result != 0) {
+                close_connection(worker, conn);
+            }
+        }
+    }
+
+    while (worker->connections != NULL) {
+        close_connection(worker, worker->connections);
+    }
+    return NULL;
+}
+
+static void handle_stop_signal(int sig) {
+    (void)sig;
+    stop_bank_server();
+}
+
+// 小请求连续发送，关闭 Nagle 算法避免应答被延迟
+static void set_nodelay(int fd, int family) {
+    if (family == AF_INET) {
+        int one = 1;
+        setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+    }
+}
+
+static int open_listener(const struct sockaddr_storage *storage, socklen_t length) {
+    int fd = socket(storage->ss_family, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (fd < 0) return -1;
+
+    if (bind_socket_address(fd, storage, length) != 0 || listen(fd, SERVER_BACKLOG) != 0) {
+        int saved = errno;
+        close(fd);
+        errno = saved;
+        return -1;
+    }
+    return fd;
+}
+
+/**
+ * 通知正在运行的服务器停止（可在信号处理函数中调用）
+ */
+void stop_bank_server() {
+    if (stop_pipe[1] >= 0) {
+        char byte = 1;
+        ssize_t ignored = write(stop_pipe[1], &byte, 1);
+        (void)ignored;
+    }
+}
+
+/**
+ * 运行交易服务器，直到收到 SIGINT/SIGTERM 或调用 stop_bank_server。
+ * 接收线程只负责接受连接并轮流分配给 num_workers 个工作线程，之后该连接的读写和请求处理
+ * 都在同一个工作线程中完成，同一连接的应答顺序与请求顺序一致
+ * @param address 端口号（监听 127.0.0.1）、主机:端口，或 unix:路径
+ * @param accounts 账户数组，请求中的账户ID k 对应 accounts[k-1]
+ * @return 成功返回0，失败返回-1
+ */
+int run_bank_server(const char *address, Account **accounts, int num_accounts, int num_workers) {
+    if (num_workers <= 0) num_workers = SERVER_DEFAULT_WORKERS;
+    if (num_workers > SERVER_MAX_WORKERS) num_workers = SERVER_MAX_WORKERS;
+
+    struct sockaddr_storage storage;
+    socklen_t length;
+    if (parse_socket_address(address, &storage, &length) != 0) return -1;
+
+    int listen_fd = open_listener(&storage, length);
+    if (listen_fd < 0) {
+        perror("启动交易服务失败");
+        return -1;
+    }
+    if (pipe2(stop_pipe, O_CLOEXEC | O_NONBLOCK) != 0) {
+        perror("启动交易服务失败");
+        close(listen_fd);
+        return -1;
+    }
+
+    server_accounts = accounts;
+    num_server_accounts = num_accounts;
+
+    ServerWorker workers[SERVER_MAX_WORKERS];
+    int started = 0;
+    for (int w = 0; w < num_workers; w++) {
+        ServerWorker *worker = &workers[w];
+        int fds[2];
+        memset(worker, 0, sizeof(*worker));
+        worker->epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+        if (worker->epoll_fd < 0 || pipe2(fds, O_CLOEXEC) != 0) {
+            if (worker->epoll_fd >= 0) close(worker->epoll_fd);
+            break;
+        }
+        worker->pipe_read = fds[0];
+        worker->pipe_write = fds[1];
+        fcntl(worker->pipe_read, F_SETFL, O_NONBLOCK);
+
+        struct epoll_event event;
+        event.events = EPOLLIN;
+        event.data.ptr = NULL;
+        epoll_ctl(worker->epoll_fd, EPOLL_CTL_ADD, worker->pipe_read, &event);
+
+        if (pthread_create(&worker->thread, NULL, server_worker, worker) != 0) {
+            close(worker->epoll_fd);
+            close(worker->pipe_read);
+            close(worker->pipe_write);
+            break;
+        }
+        started++;
+    }
+
+    int accept_epoll = epoll_create1(EPOLL_CLOEXEC);
+    struct epoll_event event;
+    event.events = EPOLLIN;
+    event.data.fd = listen_fd;
+    if (accept_epoll >= 0) epoll_ctl(accept_epoll, EPOLL_CTL_ADD, listen_fd, &event);
+    event.data.fd = stop_pipe[0];
+    if (accept_epoll >= 0) epoll_ctl(accept_epoll, EPOLL_CTL_ADD, stop_pipe[0], &event);
+
+    struct sigaction action, old_int, old_term;
+    memset(&action, 0, sizeof(action));
+    action.sa_handler = handle_stop_signal;
+    sigemptyset(&action.sa_mask);
+    sigaction(SIGINT, &action, &old_int);
+    sigaction(SIGTERM, &action, &old_term);
+
+    int result = (started > 0 && accept_epoll >= 0) ? 0 : -1;
+    if (result == 0) {
+        print_colored("交易服务: %s, %d 个工作线程, %d 个账户 (Ctrl+C 停止)\n", CYAN, address, started,
+                     num_accounts);
+    }
+    // 请求处理期间账户操作的逐条日志会淹没输出
+    int was_quiet = is_quiet_mode();
+    set_quiet_mode(1);
+    double start = now_ms();
+
+    int next_worker = 0;
+    int running = result == 0;
+    while (running) {
+        struct epoll_event ready[2];
+        int n = epoll_wait(accept_epoll, ready, 2, -1);
+        if (n < 0 && errno == EINTR) continue;
+        if (n < 0) break;
+
+        for (int i = 0; i < n; i++) {
+            if (ready[i].data.fd == stop_pipe[0]) {
+                running = 0;
+                continue;
+            }
+            // 一次接受所有排队的连接
+            while (1) {
+                int fd = accept4(listen_fd, NULL, NULL, SOCK_NONBLOCK | SOCK_CLOEXEC);
+                if (fd < 0) {
+                    if (errno == EINTR || errno == ECONNABORTED) continue;
+                    break;
+                }
+                set_nodelay(fd, storage.ss_family);
+                ServerWorker *worker = &workers[next_worker];
+                next_worker = (next_worker + 1) % started;
+                if (write(worker->pipe_write, &fd, sizeof(fd)) != (ssize_t)sizeof(fd)) {
+                    close(fd);
+                }
+            }
+        }
+    }
+
+    double elapsed = now_ms() - start;
+    sigaction(SIGINT, &old_int, NULL);
+    sigaction(SIGTERM, &old_term, NULL);
+
+    // 关闭管道的写端，工作线程读到文件结束后关闭各自的连接并退出
+    unsigned long long requests = 0, accepted = 0;
+    for (int w = 0; w < started; w++) {
+        close(workers[w].pipe_write);
+    }
+    for (int w = 0; w < started; w++) {
+        pthread_join(workers[w].thread, NULL);
+        close(workers[w].pipe_read);
+        close(workers[w].epoll_fd);
+        requests += workers[w].requests;
+        accepted += workers[w].accepted;
+    }
+    set_quiet_mode(was_quiet);
+
+    if (accept_epoll >= 0) close(accept_epoll);
+    close(listen_fd);
+    if (storage.ss_family == AF_UNIX) {
+        unlink(((struct sockaddr_un*)&storage)->sun_path);
+    }
+    close(stop_pipe[0]);
+    close(stop_pipe[1]);
+    stop_pipe[0] = stop_pipe[1] = -1;
+
+    if (result == 0) {
+        print_colored("\n交易服务已停止: %llu 个连接, %llu 个请求, 运行 %.1f s, 平均 %.0f 请求/秒\n", GREEN,
+                     accepted, requests, elapsed / 1000.0, elapsed > 0 ? requests * 1000.0 / elapsed : 0.0);
+    }
+    return result;
+}
+
+/**
+ * 连接交易服务器
+ * @param address 与 run_bank_server 相同的地址格式
+ * @return 套接字描述符，失败返回-1
+ */
+int bank_connect(const char *address) {
+    struct sockaddr_storage storage;
+    socklen_t length;
+    if (parse_socket_address(address, &storage, &length) != 0) return -1;
+
+    int fd = socket(storage.ss_family, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (fd < 0) return -1;
+    if (connect(fd, (struct sockaddr*)&storage, length) != 0) {
+        close(fd);
+        return -1;
+    }
+    set_nodelay(fd, storage.ss_family);
+    return fd;
+}
+
+/**
+ * 一次发出 count 个请求（流水线），再按顺序读回 count 个应答
+ * @param count 请求数，不超过 CLIENT_MAX_PIPELINE
+ * @return 成功返回0，连接出错返回-1
+ */
+int bank_call(int fd, const BankRequest *requests, BankResponse *responses, int count) {
+    if (count <= 0 || count > CLIENT_MAX_PIPELINE) return -1;
+
+    const char *data = (const char*)requests;
+    size_t remaining = sizeof(BankRequest) * (size_t)count;
+    while (remaining > 0) {
+        ssize_t n = send(fd, data, remaining, MSG_NOSIGNAL);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) return -1;
+        data += n;
+        remaining -= (size_t)n;
+    }
+
+    char *out = (char*)responses;
+    remaining = sizeof(BankResponse) * (size_t)count;
+    while (remaining > 0) {
+        ssize_t n = recv(fd, out, remaining, 0);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) return -1;
+        out += n;
+        remaining -= (size_t)n;
+    }
+    return 0;
+}
+
+// 负载测试的一个客户端线程
+typedef struct {
+    const char *address;
+    int num_accounts;
+    int requests;
+    int pipeline;
+    unsigned int seed;
+    long long completed;
+    long long failed;           // 业务失败（余额不足等）的应答数
+    int error;                  // 连接出错或应答编号不匹配
+} LoadClient;
+
+static void* load_client(void *arg) {
+    LoadClient *client = (LoadClient*)arg;
+    BankRequest requests[CLIENT_MAX_PIPELINE];
+    BankResponse responses[CLIENT_MAX_PIPELINE];
+
+    int fd = bank_connect(client->address);
+    if (fd < 0) {
+        client->error = 1;
+        return NULL;
+    }
+
+    // 操作比例：转账50%，存款20%，取款20%，查询10%
+    uint32_t tag = 0;
+    while (client->completed < client->requests) {
+        int batch = client->pipeline;
+        if (batch > client->requests - client->completed) batch = (int)(client->requests - client->completed);
+
+        for (int i = 0; i < batch; i++) {
+            int roll = (int)(rand_r(&client->seed) % 10);
+            requests[i].tag = tag++;
+            requests[i].op = roll < 5 ? BANK_OP_TRANSFER : roll < 7 ? BANK_OP_DEPOSIT
+                           : roll < 9 ? BANK_OP_WITHDRAW : BANK_OP_QUERY;
+            requests[i].reserved = 0;
+            requests[i].account = 1 + (int)(rand_r(&client->seed) % (unsigned int)client->num_accounts);
+            requests[i].to_account = 1 + (int)(rand_r(&client->seed) % (unsigned int)client->num_accounts);
+            requests[i].amount = 1.0 + rand_r(&client->seed) % 100;
+        }
+        if (bank_call(fd, requests, responses, batch) != 0) {
+            client->error = 1;
+            break;
+        }
+        for (int i = 0; i < batch; i++) {
+            if (responses[i].tag != requests[i].tag) client->error = 1;
+            if (responses[i].status != BANK_OK) client->failed++;
+        }
+        if (client->error) break;
+        client->completed += batch;
+    }
+    close(fd);
+    return NULL;
+}
+
+// 对运行中的服务器做负载测试
+static int run_load_test(const char *address, int clients, int requests, int pipeline, int num_accounts) {
+    LoadClient *states = (LoadClient*)calloc((size_t)clients, sizeof(LoadClient));
+    pthread_t *threads = (pthread_t*)malloc(sizeof(pthread_t) * (size_t)clients);
+    if (states == NULL || threads == NULL) {
+        free(states);
+        free(threads);
+        return 1;
+    }
+
+    print_colored("负载测试: %s, %d 个连接, 每个连接 %d 个请求, 流水线深度 %d\n", CYAN, address,
+                 clients, requests, pipeline);
+
+    double start = now_ms();
+    int started = 0;
+    for (int c = 0; c < clients; c++) {
+        states[c].address = address;
+        states[c].num_accounts = num_accounts;
+        states[c].requests = requests;
+        states[c].pipeline = pipeline;
+        states[c].seed = (unsigned int)time(NULL) + (unsigned int)c * 7919u;
+        if (pthread_create(&threads[c], NULL, load_client, &states[c]) != 0) break;
+        started++;
+    }
+
+    long long completed = 0, failed = 0;
+    int errors = 0;
+    for (int c = 0; c < started; c++) {
+        pthread_join(threads[c], NULL);
+        completed += states[c].completed;
+        failed += states[c].failed;
+        errors += states[c].error;
+    }
+    double elapsed = now_ms() - start;
+
+    print_colored("完成 %lld 个请求, 耗时 %.1f ms, %.0f 请求/秒, 业务失败 %lld\n", GREEN, completed, elapsed,
+                 elapsed > 0 ? completed * 1000.0 / elapsed : 0.0, failed);
+    if (errors > 0 || started < clients) {
+        print_colored("%d 个连接出错\n", RED, errors + clients - started);
+    }
+
+    free(states);
+    free(threads);
+    return (errors > 0 || started < clients) ? 1 : 0;
+}
+
+static void print_server_usage(const char *prog) {
+    print_colored("用法: %s [指标导出选项] -S 地址 [-W 工作线程] [-A 账户数] [-B 初始余额]\n", YELLOW, prog);
+    print_colored("      %s -C 地址 [-c 连接数] [-n 每连接请求数] [-p 流水线深度] [-A 账户数]\n", YELLOW, prog);
+    print_colored("  -S 地址    以服务器模式运行: 端口、主机:端口 或 unix:路径\n", WHITE);
+    print_colored("  -W 线程    工作线程数 (默认 %d)\n", WHITE, SERVER_DEFAULT_WORKERS);
+    print_colored("  -A 数量    账户数，账户ID为 1~数量 (默认 %d)\n", WHITE, SERVER_DEFAULT_ACCOUNTS);
+    print_colored("  -B 金额    每个账户的初始余额 (默认 10000)\n", WHITE);
+    print_colored("  -C 地址    对运行中的服务器做负载测试\n", WHITE);
+    print_colored("  -c 数量    负载测试的连接数 (默认 4)\n", WHITE);
+    print_colored("  -n 数量    每个连接发送的请求数 (默认 1000000)\n", WHITE);
+    print_colored("  -p 深度    每批流水线发送的请求数，1~%d (默认 64)\n", WHITE, CLIENT_MAX_PIPELINE);
+}
+
+/**
+ * 交易服务命令行入口：-S 运行服务器，-C 运行负载测试客户端
+ * @return 进程退出码
+ */
+int bank_server_main(int argc, char *argv[]) {
+    const char *serve_address = NULL;
+    const char *client_address = NULL;
+    int workers = SERVER_DEFAULT_WORKERS;
+    int num_accounts = SERVER_DEFAULT_ACCOUNTS;
+    double balance = 10000.0;
+    int clients = 4;
+    int requests = 1000000;
+    int pipeline = 64;
+
+    for (int i = 1; i < argc; i += 2) {
+        const char *opt = argv[i];
+        const char *value = (i + 1 < argc) ? argv[i + 1] : NULL;
+
+        if (value == NULL || opt[0] != '-' || opt[1] == '\0' || opt[2] != '\0') {
+            print_server_usage(argv[0]);
+            return 1;
+        }
+
+        switch (opt[1]) {
+            case 'S': serve_address = value; break;
+            case 'C': client_address = value; break;
+            case 'W': workers = atoi(value); break;
+            case 'A': num_accounts = atoi(value); break;
+            case 'B': balance = atof(value); break;
+            case 'c': clients = atoi(value); break;
+            case 'n': requests = atoi(value); break;
+            case 'p': pipeline = atoi(value); break;
+            default:
+                print_server_usage(argv[0]);
+                return 1;
+        }
+    }
+
+    if ((serve_address == NULL) == (client_address == NULL) || num_accounts <= 0) {
+        print_server_usage(argv[0]);
+        return 1;
+    }
+    if (client_address != NULL) {
+        if (clients <= 0 || requests <= 0 || pipeline <= 0 || pipeline > CLIENT_MAX_PIPELINE) {
+            print_server_usage(argv[0]);
+            return 1;
+        }
+        return run_load_test(client_address, clients, requests, pipeline, num_accounts);
+    }
+
+    if (metrics_enabled()) {
+        requests_metric = metrics_counter("bank_server_requests_total", "交易服务处理的请求数", NULL);
+        connections_metric = metrics_gauge("bank_server_connections", "交易服务当前的连接数", NULL);
+    }
+
+    Account **accounts = (Account**)malloc(sizeof(Account*) * (size_t)num_accounts);
+    if (accounts == NULL) {
+        print_colored("内存不足\n", RED);
+        return 1;
+    }
+    set_quiet_mode(1);
+    int created = 0;
+    for (; created < num_accounts; created++) {
+        accounts[created] = create_account(created + 1, balance);
+        if (accounts[created] == NULL) break;
+        accounts[created]->history_limit = SERVER_HISTORY_LIMIT;
+    }
+    set_quiet_mode(0);
+
+    int result = 1;
+    if (created == num_accounts) {
+        double initial = balance * num_accounts;
+        result = run_bank_server(serve_address, accounts, num_accounts, workers) == 0 ? 0 : 1;
+
+        // 存取款会改变总额，转账不会
+        double final_sum = 0.0;
+        for (int i = 0; i < num_accounts; i++) {
+            final_sum += accounts[i]->balance;
+        }
+        print_colored("账户总余额: ¥%.2f -> ¥%.2f\n", WHITE, initial, final_sum);
+    } else {
+        print_colored("创建账户失败\n", RED);
+    }
+
+    set_quiet_mode(1);
+    for (int i = 0; i < created; i++) {
+        destroy_account(accounts[i]);
+    }
+    set_quiet_mode(0);
+    free(accounts);
+    return result;
+}
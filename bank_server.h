@@ -0,0 +1,56 @@
+#ifndef BANK_SERVER_H
+#define BANK_SERVER_H
+
+#include <stdint.h>
+#include "account.h"
+
+#define SERVER_DEFAULT_WORKERS 4
+#define SERVER_MAX_WORKERS 64
+#define SERVER_DEFAULT_ACCOUNTS 1000
+#define SERVER_BUFFER_SIZE 65536    // 每个连接的接收缓冲区，一次最多处理其中的全部完整请求
+#define CLIENT_MAX_PIPELINE 1024    // bank_call 一次发出的最多请求数，应答总量不超过套接字缓冲区
+#define SERVER_HISTORY_LIMIT 4096   // 服务模式下每个账户保留的余额历史条数，长时间运行不会耗尽内存
+
+// 二进制协议：客户端连续发送定长请求，不必等待应答就可以发送下一个（流水线），
+// 服务器对每个连接按请求顺序返回定长应答。字段均为本机字节序，只用于本机通信
+typedef enum {
+    BANK_OP_QUERY = 1,          // 查询余额
+    BANK_OP_DEPOSIT,            // 存款
+    BANK_OP_WITHDRAW,           // 取款
+    BANK_OP_TRANSFER            // 从 account 转账到 to_account
+} BankOp;
+
+typedef enum {
+    BANK_OK = 0,
+    BANK_ERR_ACCOUNT,           // 账户不存在，或转账的两个账户相同
+    BANK_ERR_FUNDS,             // 余额不足
+    BANK_ERR_AMOUNT,            // 金额不是正数
+    BANK_ERR_OP                 // 未知操作
+} BankStatus;
+
+typedef struct {
+    uint32_t tag;               // 客户端自定的请求编号，应答中原样返回
+    uint16_t op;                // BankOp
+    uint16_t reserved;
+    int32_t account;
+    int32_t to_account;         // 仅转账使用
+    double amount;
+} BankRequest;
+
+typedef struct {
+    uint32_t tag;
+    int32_t status;             // BankStatus
+    double balance;             // 操作完成后 account 的余额
+} BankResponse;
+
+// 服务器函数
+int run_bank_server(const char *address, Account **accounts, int num_accounts, int num_workers);
+void stop_bank_server();
+
+// 客户端函数
+int bank_connect(const char *address);
+int bank_call(int fd, const BankRequest *requests, BankResponse *responses, int count);
+
+int bank_server_main(int argc, char *argv[]);
+
+#endif // BANK_SERVER_H
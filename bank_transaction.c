@@ -6,10 +6,17 @@
 #include <string.h>
 #include <math.h>
 #include "account.h"
+#include "bank_server.h"
+#include "dashboard.h"
+#include "export.h"
+#include "metrics.h"
+#include "timeutil.h"
 #include "visualization.h"
 
 #define NUM_ACCOUNTS 5
 #define NUM_TRANSACTIONS 10
+#define DASHBOARD_THREADS 4
+#define DASHBOARD_TRANSFERS 200000
 #define MAX_TRANSFER_AMOUNT 1000.0
 #define MAX_ACCOUNTS 100
 
@@ -44,6 +51,158 @@ void* perform_random_transfer(void* arg) {
     return NULL;
 }
 
+// 仪表盘压力测试的工作线程参数
+typedef struct {
+    Dashboard *dashboard;
+    int transfers;
+    unsigned int seed;
+} StressWorker;
+
+// 仪表盘压力测试的工作线程：不输出日志，只累加仪表盘计数器，剩余的转账数作为队列深度
+void* stress_transfer_worker(void* arg) {
+    StressWorker *worker = (StressWorker*)arg;
+    dashboard_attach(worker->dashboard);
+
+    for (int i = 0; i < worker->transfers; i++) {
+        int from_idx = rand_r(&worker->seed) % num_accounts;
+        int to_idx = rand_r(&worker->seed) % (num_accounts - 1);
+        if (to_idx >= from_idx) to_idx++;
+
+        double amount = ((double)rand_r(&worker->seed) / RAND_MAX) * MAX_TRANSFER_AMOUNT + 1.0;
+        transfer(accounts[from_idx], accounts[to_idx], amount);
+        dashboard_set_depth(worker->transfers - i - 1);
+    }
+
+    dashboard_detach();
+    return NULL;
+}
+
+// 仪表盘压力测试：多个线程并发转账，实时显示吞吐量、失败次数与锁等待
+void run_dashboard_test() {
+    clear_screen();
+    print_title("银行账户交易系统 - 实时仪表盘");
+
+    if (num_accounts < 2) {
+        print_colored("请先创建至少两个账户.\n\n", YELLOW);
+        return;
+    }
+
+    char buffer[100];
+    int num_threads = DASHBOARD_THREADS;
+    int transfers = DASHBOARD_TRANSFERS;
+    print_colored("请输入线程数 (默认 %d): ", YELLOW, num_threads);
+    if (fgets(buffer, sizeof(buffer), stdin) && atoi(buffer) > 0) {
+        num_threads = atoi(buffer);
+    }
+    if (num_threads > DASHBOARD_MAX_THREADS) num_threads = DASHBOARD_MAX_THREADS;
+    print_colored("请输入每个线程的转账次数 (默认 %d): ", YELLOW, transfers);
+    if (fgets(buffer, sizeof(buffer), stdin) && atoi(buffer) > 0) {
+        transfers = atoi(buffer);
+    }
+
+    double initial_sum = 0.0;
+    for (int i = 0; i < num_accounts; i++) {
+        initial_sum += accounts[i]->balance;
+    }
+
+    Dashboard *dashboard = create_dashboard("并发转账", num_threads, DASHBOARD_DEFAULT_HZ);
+    pthread_t threads[DASHBOARD_MAX_THREADS];
+    StressWorker workers[DASHBOARD_MAX_THREADS];
+    if (dashboard == NULL) {
+        print_colored("创建仪表盘失败\n", RED);
+        return;
+    }
+
+    print_colored("\n", WHITE);
+    // 转账日志会打乱仪表盘，工作线程运行期间静默
+    set_quiet_mode(1);
+    start_dashboard(dashboard);
+
+    int started = 0;
+    for (int i = 0; i < num_threads; i++) {
+        workers[i].dashboard = dashboard;
+        workers[i].transfers = transfers;
+        workers[i].seed = (unsigned int)time(NULL) + i * 7919;
+        if (pthread_create(&threads[i], NULL, stress_transfer_worker, &workers[i]) != 0) {
+            break;
+        }
+        started++;
+    }
+    for (int i = 0; i < started; i++) {
+        pthread_join(threads[i], NULL);
+    }
+
+    stop_dashboard(dashboard);
+    destroy_dashboard(dashboard);
+    set_quiet_mode(0);
+
+    double final_sum = 0.0;
+    for (int i = 0; i < num_accounts; i++) {
+        final_sum += accounts[i]->balance;
+    }
+    if (fabs(final_sum - initial_sum) < 0.01) {
+        print_colored("\n验证成功: 系统总资金保持不变 (¥%.2f)\n", GREEN, final_sum);
+    } else {
+        print_colored("\n验证失败: 系统总资金从 ¥%.2f 变为 ¥%.2f\n", RED, initial_sum, final_sum);
+    }
+    draw_account_chart(accounts, num_accounts);
+}
+
+// 导出一个文件并报告大小与耗时
+static void report_export(const char *path, long long bytes, double elapsed) {
+    if (bytes < 0) {
+        print_colored("导出失败: %s\n", RED, path);
+    } else {
+        print_colored("  %-32s %12lld 字节  %8.1f ms\n", GREEN, path, bytes, elapsed);
+    }
+}
+
+// 把账户表和余额历史导出为CSV和列式文件
+void run_export() {
+    clear_screen();
+    print_title("导出账户数据");
+
+    if (num_accounts == 0) {
+        print_colored("没有可导出的账户.\n\n", YELLOW);
+        return;
+    }
+
+    char prefix[256] = "bank_export";
+    char buffer[256];
+    print_colored("请输入文件名前缀 (默认 %s): ", YELLOW, prefix);
+    if (fgets(buffer, sizeof(buffer), stdin) != NULL) {
+        buffer[strcspn(buffer, "\r\n")] = '\0';
+        if (buffer[0] != '\0') {
+            snprintf(prefix, sizeof(prefix), "%s", buffer);
+        }
+    }
+
+    // 导出期间其他线程不会修改账户，直接读取余额和历史
+    char path[512];
+    double start;
+    long long bytes;
+
+    snprintf(path, sizeof(path), "%s_accounts.csv", prefix);
+    start = now_ms();
+    bytes = export_accounts_csv(path, accounts, num_accounts);
+    report_export(path, bytes, now_ms() - start);
+
+    snprintf(path, sizeof(path), "%s_accounts.col", prefix);
+    start = now_ms();
+    bytes = export_accounts_columns(path, accounts, num_accounts);
+    report_export(path, bytes, now_ms() - start);
+
+    snprintf(path, sizeof(path), "%s_history.csv", prefix);
+    start = now_ms();
+    bytes = export_histories_csv(path, accounts, num_accounts);
+    report_export(path, bytes, now_ms() - start);
+
+    snprintf(path, sizeof(path), "%s_history.col", prefix);
+    start = now_ms();
+    bytes = export_histories_columns(path, accounts, num_accounts);
+    report_export(path, bytes, now_ms() - start);
+}
+
 // 运行自动测试 - 使用现有账户
 void run_automated_test() {
     clear_screen();
@@ -91,7 +250,7 @@ void run_automated_test() {
         }
         
         // 线程创建间隔
-        usleep(500000);  // 500ms
+        display_delay(500000);  // 500ms
     }
     
     // 等待所有交易完成
@@ -128,13 +287,34 @@ void run_automated_test() {
 }
 
 // 交互式模式的主函数
-int main() {
+int main(int argc, char *argv[]) {
     // 初始化随机数生成器
     srand(time(NULL));
     
+    // 可选的指标导出：bank_system [-m 地址] [-o 文件] [-i 毫秒] [交易服务选项]
+    int used = metrics_options(argc, argv);
+    if (used < 0) {
+        print_colored("用法: %s [指标导出选项] [-S 地址 | -C 地址 ...]\n", YELLOW, argv[0]);
+        print_metrics_usage();
+        return 1;
+    }
+    if (metrics_enabled()) {
+        account_register_metrics();
+    }
+    
+    // 其余参数为交易服务或负载测试选项，不进入交互式菜单
+    if (used < argc - 1) {
+        argv[used] = argv[0];
+        int result = bank_server_main(argc - used, argv + used);
+        metrics_shutdown();
+        return result;
+    }
+    
     int choice;
     char buffer[100];
     
+    // 菜单在备用屏幕中显示，退出后恢复原来的终端内容
+    enter_alternate_screen();
     while (1) {
         clear_screen();
         print_title("银行账户交易系统");
@@ -425,8 +605,16 @@ int main() {
                 run_automated_test();
                 break;
                 
+            case 9:  // 实时仪表盘压力测试
+                run_dashboard_test();
+                break;
+                
+            case 10:  // 导出账户数据
+                run_export();
+                break;
+                
             case 0:  // 退出
-                clear_screen();
+                leave_alternate_screen();
                 print_title("系统退出");
                 print_colored("正在清理资源...\n", YELLOW);
                 
@@ -435,6 +623,7 @@ int main() {
                     destroy_account(accounts[i]);
                 }
                 
+                metrics_shutdown();
                 print_colored("感谢使用银行交易系统!\n", GREEN);
                 return 0;
                 
@@ -446,5 +635,6 @@ int main() {
         getchar();
     }
     
+    metrics_shutdown();
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,447 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <math.h>
+#include "process_control.h"
+#include "simulator.h"
+#include "timeutil.h"
+#include "visualization.h"
+
+// 调度原语基准测试：ProcessQueue 的入队/出队/按pid移除，各调度策略每次调度决策的开销，
+// 记录执行段（甘特图）带来的额外开销，以及余额历史图表的降采样和账户总览的汇总。
+// 链接时用 -Wl,--wrap=malloc 等统计被测代码的内存分配次数
+
+#define BENCH_MIN_NS 50000000LL     // 每个测量点至少累计运行 50ms
+#define BENCH_MAX_RESULTS 256
+#define BENCH_TABLE_RULE "--------------------------------------------------------------------------------------------"
+
+// 一个测量点的结果
+typedef struct {
+    char name[32];              // 基准名称，如 queue.enqueue、sched.RR
+    int size;                   // 队列规模
+    double ns_per_op;
+    double allocs_per_op;
+} BenchResult;
+
+// 内存分配计数（基准测试为单线程）
+static long long alloc_count = 0;
+
+void *__real_malloc(size_t size);
+void *__real_calloc(size_t nmemb, size_t size);
+void *__real_realloc(void *ptr, size_t size);
+
+void *__wrap_malloc(size_t size) {
+    alloc_count++;
+    return __real_malloc(size);
+}
+
+void *__wrap_calloc(size_t nmemb, size_t size) {
+    alloc_count++;
+    return __real_calloc(nmemb, size);
+}
+
+void *__wrap_realloc(void *ptr, size_t size) {
+    alloc_count++;
+    return __real_realloc(ptr, size);
+}
+
+// 累计的测量值
+typedef struct {
+    long long ns;
+    long long ops;
+    long long allocs;
+} BenchCounter;
+
+static void add_result(BenchResult *results, int *count, const char *name, int size, const BenchCounter *c) {
+    if (*count >= BENCH_MAX_RESULTS || c->ops == 0) return;
+
+    BenchResult *r = &results[(*count)++];
+    snprintf(r->name, sizeof(r->name), "%s", name);
+    r->size = size;
+    r->ns_per_op = (double)c->ns / c->ops;
+    r->allocs_per_op = (double)c->allocs / c->ops;
+}
+
+// 测量规模为 size 的队列上的入队、出队、按pid移除和移到队尾
+static void bench_queue(PCB *pool, int size, BenchResult *results, int *count) {
+    BenchCounter enq = {0, 0, 0}, deq = {0, 0, 0}, rem = {0, 0, 0}, mov = {0, 0, 0};
+
+    // 按 pid 操作时用素数步长打乱访问顺序，覆盖队列各处的进程（规模为10的幂，与步长互素）
+    const long long stride = 7919;
+
+    while (enq.ns < BENCH_MIN_NS || deq.ns < BENCH_MIN_NS || rem.ns < BENCH_MIN_NS || mov.ns < BENCH_MIN_NS) {
+        ProcessQueue *queue = create_queue();
+        if (queue == NULL) return;
+
+        long long a0 = alloc_count, t0 = now_ns();
+        for (int i = 0; i < size; i++) {
+            enqueue(queue, &pool[i]);
+        }
+        enq.ns += now_ns() - t0;
+        enq.allocs += alloc_count - a0;
+        enq.ops += size;
+
+        a0 = alloc_count;
+        t0 = now_ns();
+        for (int j = 0; j < size; j++) {
+            move_to_tail(queue, pool[j * stride % size].pid);
+        }
+        mov.ns += now_ns() - t0;
+        mov.allocs += alloc_count - a0;
+        mov.ops += size;
+
+        a0 = alloc_count;
+        t0 = now_ns();
+        for (int j = 0; j < size; j++) {
+            remove_process(queue, pool[j * stride % size].pid);
+        }
+        rem.ns += now_ns() - t0;
+        rem.allocs += alloc_count - a0;
+        rem.ops += size;
+
+        for (int i = 0; i < size; i++) {
+            enqueue(queue, &pool[i]);
+        }
+        a0 = alloc_count;
+        t0 = now_ns();
+        while (dequeue(queue) != NULL) {
+        }
+        deq.ns += now_ns() - t0;
+        deq.allocs += alloc_count - a0;
+        deq.ops += size;
+
+        destroy_queue(queue);  // 队列已空，只释放队列本身
+        if (size >= 1000000) break;  // 大规模时单轮已足够
+    }
+
+    add_result(results, count, "queue.enqueue", size, &enq);
+    add_result(results, count, "queue.dequeue", size, &deq);
+    add_result(results, count, "queue.remove", size, &rem);
+    add_result(results, count, "queue.move_tail", size, &mov);
+}
+
+// 所有进程在时刻0同时就绪，就绪队列规模即为 size；测量每次调度决策的平均开销
+static void bench_policy(SchedAlgorithm algorithm, const PCB *workload, PCB *processes, int size,
+                         BenchResult *results, int *count) {
+    SchedConfig config;
+    sched_config_defaults(&config, algorithm);
+    config.time_quantum = 2;
+    config.random_seed = 1;
+    BenchCounter c = {0, 0, 0};
+
+    while (c.ns < BENCH_MIN_NS) {
+        memcpy(processes, workload, sizeof(PCB) * size);
+
+        long long a0 = alloc_count, t0 = now_ns();
+        int result = run_simulation(processes, size, &config);
+        c.ns += now_ns() - t0;
+        c.allocs += alloc_count - a0;
+        if (result < 0) return;
+
+        for (int i = 0; i < size; i++) {
+            c.ops += processes[i].dispatch_count;
+        }
+        if (size >= 1000000) break;
+    }
+
+    char name[32];
+    snprintf(name, sizeof(name), "sched.%s", sched_algorithm_name(algorithm));
+    add_result(results, count, name, size, &c);
+}
+
+// RR 在不记录与记录到预分配 ExecTrace 两种情况下交替运行，测量记录执行段的开销
+// @return 记录时每次调度决策的耗时相对不记录时的增加比例，失败返回负数
+static double bench_trace(const PCB *workload, PCB *processes, int size, ExecTrace *trace,
+                          BenchResult *results, int *count) {
+    SchedConfig config;
+    sched_config_defaults(&config, ALGO_RR);
+    config.time_quantum = 2;
+    BenchCounter plain = {0, 0, 0};
+    BenchCounter traced = {0, 0, 0};
+
+    while (plain.ns < BENCH_MIN_NS || traced.ns < BENCH_MIN_NS) {
+        for (int k = 0; k < 2; k++) {
+            BenchCounter *c = k ? &traced : &plain;
+            config.trace = k ? trace : NULL;
+            trace->count = 0;
+            trace->dropped = 0;
+            memcpy(processes, workload, sizeof(PCB) * size);
+
+            long long a0 = alloc_count, t0 = now_ns();
+            int result = run_simulation(processes, size, &config);
+            c->ns += now_ns() - t0;
+            c->allocs += alloc_count - a0;
+            if (result < 0) return -1.0;
+
+            for (int i = 0; i < size; i++) {
+                c->ops += processes[i].dispatch_count;
+            }
+        }
+        if (size >= 1000000) break;
+    }
+    if (trace->dropped > 0) {
+        print_colored("执行记录缓冲区不足，丢弃了 %lld 段\n", YELLOW, trace->dropped);
+    }
+
+    add_result(results, count, "trace.RR", size, &traced);
+    double base = (double)plain.ns / plain.ops;
+    return ((double)traced.ns / traced.ops - base) / base;
+}
+
+// 把 size 个样本降采样为图表的60列，测量每个样本的平均开销
+static void bench_downsample(const double *values, int size, BenchResult *results, int *count) {
+    double mins[60], maxs[60];
+    BenchCounter c = {0, 0, 0};
+
+    while (c.ns < BENCH_MIN_NS) {
+        long long a0 = alloc_count, t0 = now_ns();
+        downsample_minmax(values, (size_t)size, 60, mins, maxs);
+        c.ns += now_ns() - t0;
+        c.allocs += alloc_count - a0;
+        c.ops += size;
+    }
+
+    add_result(results, count, "chart.downsample", size, &c);
+}
+
+// 对 size 个账户计算一次总览，测量每个账户的平均开销
+static void bench_overview(Account **accounts, int size, BenchResult *results, int *count) {
+    AccountOverview overview;
+    BenchCounter c = {0, 0, 0};
+
+    while (c.ns < BENCH_MIN_NS) {
+        long long a0 = alloc_count, t0 = now_ns();
+        compute_account_overview(accounts, size, &overview);
+        c.ns += now_ns() - t0;
+        c.allocs += alloc_count - a0;
+        c.ops += size;
+    }
+
+    add_result(results, count, "chart.overview", size, &c);
+}
+
+// 读取基准文件，返回读到的条目数，文件不存在返回-1
+static int load_baseline(const char *path, BenchResult *baseline, int max) {
+    FILE *file = fopen(path, "r");
+    if (file == NULL) return -1;
+
+    char line[256];
+    int n = 0;
+    while (n < max && fgets(line, sizeof(line), file) != NULL) {
+        if (line[0] == '#' || line[0] == '\n') continue;
+        BenchResult *r = &baseline[n];
+        if (sscanf(line, "%31s %d %lf %lf", r->name, &r->size, &r->ns_per_op, &r->allocs_per_op) == 4) {
+            n++;
+        }
+    }
+    fclose(file);
+    return n;
+}
+
+static int save_results(const char *path, const BenchResult *results, int count) {
+    FILE *file = fopen(path, "w");
+    if (file == NULL) {
+        perror("无法写入基准文件");
+        return -1;
+    }
+
+    fprintf(file, "# 名称 规模 ns/op allocs/op\n");
+    for (int i = 0; i < count; i++) {
+        fprintf(file, "%s %d %.3f %.4f\n", results[i].name, results[i].size,
+                results[i].ns_per_op, results[i].allocs_per_op);
+    }
+    fclose(file);
+    return 0;
+}
+
+static const BenchResult* find_baseline(const BenchResult *baseline, int count, const BenchResult *r) {
+    for (int i = 0; i < count; i++) {
+        if (baseline[i].size == r->size && strcmp(baseline[i].name, r->name) == 0) {
+            return &baseline[i];
+        }
+    }
+    return NULL;
+}
+
+/**
+ * 打印结果表并与基准比较
+ * @return 退化的测量点个数
+ */
+static int report(const BenchResult *results, int count, const BenchResult *baseline, int baseline_count,
+                  double threshold) {
+    int regressions = 0;
+
+    print_colored("%s\n", WHITE, BENCH_TABLE_RULE);
+    print_colored("| %-16s | %-9s | %-12s | %-10s | %-10s | %-14s |\n", WHITE,
+                 "基准", "规模", "ns/op", "allocs/op", "基准ns/op", "变化");
+    print_colored("%s\n", WHITE, BENCH_TABLE_RULE);
+
+    for (int i = 0; i < count; i++) {
+        const BenchResult *r = &results[i];
+        const BenchResult *base = find_baseline(baseline, baseline_count, r);
+
+        if (base == NULL) {
+            print_colored("| %-16s | %-9d | %-12.2f | %-10.4f | %-10s | %-14s |\n", WHITE,
+                         r->name, r->size, r->ns_per_op, r->allocs_per_op, "-", "-");
+            continue;
+        }
+
+        double change = base->ns_per_op > 0 ? (r->ns_per_op / base->ns_per_op - 1.0) * 100 : 0.0;
+        int slower = change > threshold;
+        int more_allocs = r->allocs_per_op > base->allocs_per_op + 0.0005;
+        char verdict[32];
+        snprintf(verdict, sizeof(verdict), "%+.1f%%%s", change,
+                 more_allocs ? " 分配增加" : (slower ? " 退化" : ""));
+
+        if (slower || more_allocs) regressions++;
+        print_colored("| %-16s | %-9d | %-12.2f | %-10.4f | %-10.2f | %-14s |\n",
+                     (slower || more_allocs) ? RED : (change < -threshold ? GREEN : WHITE),
+                     r->name, r->size, r->ns_per_op, r->allocs_per_op, base->ns_per_op, verdict);
+    }
+    print_colored("%s\n", WHITE, BENCH_TABLE_RULE);
+    return regressions;
+}
+
+static void print_bench_usage(const char *prog) {
+    print_colored("用法: %s [选项]\n", YELLOW, prog);
+    print_colored("  -q 规模    队列基准的最大规模 (默认 10000000)\n", WHITE);
+    print_colored("  -p 规模    调度策略基准的最大规模 (默认 1000000)\n", WHITE);
+    print_colored("  -c 规模    图表降采样基准的最大样本数 (默认 10000000)\n", WHITE);
+    print_colored("  -a 规模    账户总览基准的最大账户数 (默认 1000000)\n", WHITE);
+    print_colored("  -b 文件    与该基准文件比较，出现退化时以状态码1退出\n", WHITE);
+    print_colored("  -o 文件    把本次结果写为新的基准文件\n", WHITE);
+    print_colored("  -t 百分比  ns/op 超过基准多少视为退化 (默认 10)\n", WHITE);
+}
+
+int main(int argc, char *argv[]) {
+    int max_queue = 10000000;
+    int max_policy = 1000000;
+    int max_chart = 10000000;
+    int max_accounts = 1000000;
+    const char *baseline_path = NULL;
+    const char *output_path = NULL;
+    double threshold = 10.0;
+
+    for (int i = 1; i < argc; i += 2) {
+        const char *opt = argv[i];
+        const char *value = (i + 1 < argc) ? argv[i + 1] : NULL;
+
+        if (value == NULL || opt[0] != '-' || opt[1] == '\0' || opt[2] != '\0') {
+            print_bench_usage(argv[0]);
+            return 2;
+        }
+
+        switch (opt[1]) {
+            case 'q': max_queue = atoi(value); break;
+            case 'p': max_policy = atoi(value); break;
+            case 'c': max_chart = atoi(value); break;
+            case 'a': max_accounts = atoi(value); break;
+            case 'b': baseline_path = value; break;
+            case 'o': output_path = value; break;
+            case 't': threshold = atof(value); break;
+            default:
+                print_bench_usage(argv[0]);
+                return 2;
+        }
+    }
+
+    int max_size = max_queue > max_policy ? max_queue : max_policy;
+    if (max_size < 10) max_size = 10;
+
+    // 所有规模共用一份进程数据：服务时间 1~8，优先级 1~10，全部在时刻0到达
+    PCB *workload = (PCB*)malloc(sizeof(PCB) * max_size);
+    PCB *processes = (PCB*)malloc(sizeof(PCB) * (max_policy >= 10 ? max_policy : 10));
+    BenchResult *results = (BenchResult*)malloc(sizeof(BenchResult) * BENCH_MAX_RESULTS);
+    BenchResult *baseline = (BenchResult*)malloc(sizeof(BenchResult) * BENCH_MAX_RESULTS);
+    // 余额历史样本：随机游走
+    double *history = (double*)malloc(sizeof(double) * (max_chart >= 1 ? max_chart : 1));
+    // 账户只填写总览读取的ID和余额，余额跨越多个数量级
+    Account *account_pool = (Account*)calloc(max_accounts >= 1 ? max_accounts : 1, sizeof(Account));
+    Account **accounts = (Account**)malloc(sizeof(Account*) * (max_accounts >= 1 ? max_accounts : 1));
+    // RR 时间片为2、服务时间不超过8，每个进程最多4个执行段；预先分配，记录期间不再分配内存
+    ExecTrace *trace = create_exec_trace((max_policy >= 10 ? max_policy : 10) * 4);
+    double trace_overhead[16];
+    int trace_sizes[16];
+    int num_trace = 0;
+    if (workload == NULL || processes == NULL || results == NULL || baseline == NULL || history == NULL ||
+        account_pool == NULL || accounts == NULL || trace == NULL) {
+        print_colored("内存不足\n", RED);
+        return 2;
+    }
+    for (int i = 0; i < max_size; i++) {
+        char name[32];
+        snprintf(name, sizeof(name), "P%d", i + 1);
+        init_pcb(&workload[i], i + 1, name, 1 + i % 10, 0, 1 + (i * 7) % 8);
+    }
+
+    unsigned int seed = 1;
+    double balance = 10000.0;
+    for (int i = 0; i < max_chart; i++) {
+        balance += (double)rand_r(&seed) / RAND_MAX * 200.0 - 100.0;
+        history[i] = balance;
+    }
+    for (int i = 0; i < max_accounts; i++) {
+        account_pool[i].account_id = i + 1;
+        account_pool[i].balance = pow(10.0, (double)rand_r(&seed) / RAND_MAX * 9.0);
+        accounts[i] = &account_pool[i];
+    }
+
+    int count = 0;
+    set_quiet_mode(1);
+
+    // 预热一轮并丢弃结果，避免第一个测量点受冷缓存和CPU升频影响
+    bench_queue(workload, max_size >= 1000 ? 1000 : max_size, results, &count);
+    count = 0;
+    for (int size = 10; size <= max_queue; size *= 10) {
+        bench_queue(workload, size, results, &count);
+    }
+    for (int size = 10; size <= max_policy; size *= 10) {
+        for (int a = 0; a < ALGO_COUNT; a++) {
+            bench_policy((SchedAlgorithm)a, workload, processes, size, results, &count);
+        }
+    }
+    for (int size = 10; size <= max_policy && num_trace < 16; size *= 10) {
+        trace_sizes[num_trace] = size;
+        trace_overhead[num_trace++] = bench_trace(workload, processes, size, trace, results, &count);
+    }
+    for (int size = 1000; size <= max_chart; size *= 10) {
+        bench_downsample(history, size, results, &count);
+    }
+    for (int size = 1000; size <= max_accounts; size *= 10) {
+        bench_overview(accounts, size, results, &count);
+    }
+    set_quiet_mode(0);
+
+    int baseline_count = 0;
+    if (baseline_path != NULL) {
+        baseline_count = load_baseline(baseline_path, baseline, BENCH_MAX_RESULTS);
+        if (baseline_count < 0) {
+            print_colored("基准文件 %s 不存在，只输出本次结果\n", YELLOW, baseline_path);
+            baseline_count = 0;
+        }
+    }
+
+    int regressions = report(results, count, baseline, baseline_count, threshold);
+    if (baseline_count > 0) {
+        print_colored("与 %s 比较: %d 项退化 (阈值 %.0f%%)\n", regressions > 0 ? RED : GREEN,
+                     baseline_path, regressions, threshold);
+    }
+    for (int i = 0; i < num_trace; i++) {
+        if (trace_overhead[i] < -0.5) continue;
+        print_colored("执行记录开销 (RR, 规模 %d): %+.1f%%\n", WHITE, trace_sizes[i], trace_overhead[i] * 100);
+    }
+    if (output_path != NULL && save_results(output_path, results, count) == 0) {
+        print_colored("结果已写入 %s\n", GREEN, output_path);
+    }
+
+    free(workload);
+    free(processes);
+    free(results);
+    free(baseline);
+    free(history);
+    free(account_pool);
+    free(accounts);
+    destroy_exec_trace(trace);
+    return regressions > 0 ? 1 : 0;
+}
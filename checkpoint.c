@@ -0,0 +1,701 @@
+#include <fcntl.h>
+#include <limits.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+#include "checkpoint.h"
+#include "process_control.h"
+#include "simulator.h"
+#include "stats.h"
+#include "timeutil.h"
+#include "visualization.h"
+
+#define FNV_OFFSET 14695981039346656037ULL
+#define FNV_PRIME 1099511628211ULL
+
+static volatile sig_atomic_t stop_requested = 0;
+
+// FNV-1a 64位散列，hash 为前一段数据的结果，可分段计算
+static unsigned long long fnv1a(unsigned long long hash, const void *data, size_t size) {
+    const unsigned char *bytes = (const unsigned char*)data;
+    for (size_t i = 0; i < size; i++) {
+        hash ^= bytes[i];
+        hash *= FNV_PRIME;
+    }
+    return hash;
+}
+
+// 整个文件的校验和，头部的 checksum 字段按0计算
+static unsigned long long checkpoint_checksum(const void *map, size_t size) {
+    CheckpointHeader header;
+    memcpy(&header, map, sizeof(header));
+    header.checksum = 0;
+    unsigned long long hash = fnv1a(FNV_OFFSET, &header, sizeof(header));
+    return fnv1a(hash, (const char*)map + sizeof(header), size - sizeof(header));
+}
+
+// 向上取整到8字节
+static size_t align8(size_t size) {
+    return (size + 7) & ~(size_t)7;
+}
+
+static void save_process(CheckpointProcess *record, const PCB *p) {
+    memset(record, 0, sizeof(*record));
+    record->pid = p->pid;
+    memcpy(record->name, p->name, sizeof(record->name));
+    record->status = p->status;
+    record->priority = p->priority;
+    record->arrive_time = p->arrive_time;
+    record->service_time = p->service_time;
+    record->deadline = p->deadline;
+    record->cpu_burst = p->cpu_burst;
+    record->io_device = p->io_device;
+    record->burst_left = p->burst_left;
+    record->io_time = p->io_time;
+    record->remaining_time = p->remaining_time;
+    record->completion_time = p->completion_time;
+    record->turnaround_time = p->turnaround_time;
+    record->weighted_turnaround = p->weighted_turnaround;
+    record->waiting_time = p->waiting_time;
+    record->start_time = p->start_time;
+    record->dispatch_count = p->dispatch_count;
+    record->vruntime = p->vruntime;
+}
+
+static void load_process(PCB *p, const CheckpointProcess *record) {
+    memset(p, 0, sizeof(*p));
+    p->pid = record->pid;
+    memcpy(p->name, record->name, sizeof(p->name));
+    p->name[sizeof(p->name) - 1] = '\0';
+    p->status = record->status;
+    p->priority = record->priority;
+    p->arrive_time = record->arrive_time;
+    p->service_time = record->service_time;
+    p->deadline = record->deadline;
+    p->cpu_burst = record->cpu_burst;
+    p->io_device = record->io_device;
+    p->burst_left = record->burst_left;
+    p->io_time = record->io_time;
+    p->remaining_time = record->remaining_time;
+    p->completion_time = record->completion_time;
+    p->turnaround_time = record->turnaround_time;
+    p->weighted_turnaround = record->weighted_turnaround;
+    p->waiting_time = record->waiting_time;
+    p->start_time = record->start_time;
+    p->dispatch_count = record->dispatch_count;
+    p->vruntime = record->vruntime;
+}
+
+// 填写头部中的调度参数和调度循环状态
+static void fill_header(CheckpointHeader *header, int count, const SchedConfig *config, const SimSnapshot *snap) {
+    memcpy(header->magic, CHECKPOINT_MAGIC, sizeof(header->magic));
+    header->version = CHECKPOINT_VERSION;
+    header->header_size = sizeof(CheckpointHeader);
+    header->record_size = sizeof(CheckpointProcess);
+    header->count = count;
+
+    header->algorithm = config->algorithm;
+    header->time_quantum = config->time_quantum;
+    header->mlfq_levels = config->mlfq_levels;
+    header->boost_interval = config->boost_interval;
+    header->aging_interval = config->aging_interval;
+    header->min_granularity = config->min_granularity;
+    header->target_latency = config->target_latency;
+    header->time_limit = config->time_limit;
+    header->random_seed = config->random_seed;
+    header->admission_control = config->admission_control;
+    header->io_devices = config->io_devices;
+    memcpy(header->io_latency, config->io_latency, sizeof(header->io_latency));
+
+    header->clock = snap->clock;
+    header->completed = snap->completed;
+    header->next_arrival = snap->next_arrival;
+    memcpy(header->device_free, snap->device_free, sizeof(header->device_free));
+    header->current = snap->current;
+    header->next_boost = snap->next_boost;
+    header->rng_state = snap->rng_state;
+    header->current_key = snap->current_key;
+    header->min_vruntime = snap->min_vruntime;
+    header->global_pass = snap->global_pass;
+    header->density = snap->density;
+    header->deadline_rejected = snap->deadline_rejected;
+    header->has_io_stats = snap->io_stats != NULL;
+    if (snap->io_stats != NULL) {
+        header->io_stats = *snap->io_stats;
+    }
+    header->queue_length = snap->queue_length;
+}
+
+/**
+ * 写检查点：在同目录的临时文件中按检查点布局映射并填写，落盘后原子替换目标文件，
+ * 因此目标文件要么是旧检查点，要么是完整的新检查点
+ * @param path 检查点文件
+ * @param processes 进程数组
+ * @param count 进程数量
+ * @param config 调度参数
+ * @param snap 调度循环状态
+ * @return 成功返回0，失败返回-1
+ */
+int write_checkpoint(const char *path, const PCB *processes, int count, const SchedConfig *config,
+                     const SimSnapshot *snap) {
+    char tmp_path[PATH_MAX];
+    if (snprintf(tmp_path, sizeof(tmp_path), "%s.tmp", path) >= (int)sizeof(tmp_path)) {
+        print_colored("检查点路径过长: %s\n", RED, path);
+        return -1;
+    }
+
+    // 计算各段偏移
+    size_t offset = align8(sizeof(CheckpointHeader));
+    size_t processes_offset = offset;
+    offset += align8(sizeof(CheckpointProcess) * count);
+    size_t keys_offset = 0, wake_offset = 0, levels_offset = 0, queue_offset = 0;
+    if (snap->keys != NULL) {
+        keys_offset = offset;
+        offset += sizeof(long long) * count;
+    }
+    if (snap->wake_time != NULL) {
+        wake_offset = offset;
+        offset += sizeof(long long) * count;
+    }
+    if (snap->levels != NULL) {
+        levels_offset = offset;
+        offset += align8(sizeof(int) * count);
+    }
+    if (snap->queue_length > 0) {
+        queue_offset = offset;
+        offset += align8(sizeof(int) * snap->queue_length);
+    }
+    size_t size = offset;
+
+    int fd = open(tmp_path, O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+        perror("无法创建检查点文件");
+        return -1;
+    }
+    if (ftruncate(fd, (off_t)size) != 0) {
+        perror("检查点写入失败");
+        close(fd);
+        unlink(tmp_path);
+        return -1;
+    }
+    char *map = (char*)mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (map == MAP_FAILED) {
+        perror("检查点写入失败");
+        close(fd);
+        unlink(tmp_path);
+        return -1;
+    }
+
+    // ftruncate 得到的文件内容全为0，对齐填充无需另行清零
+    CheckpointHeader *header = (CheckpointHeader*)map;
+    fill_header(header, count, config, snap);
+    header->file_size = size;
+    header->processes_offset = processes_offset;
+    header->keys_offset = keys_offset;
+    header->wake_offset = wake_offset;
+    header->levels_offset = levels_offset;
+    header->queue_offset = queue_offset;
+
+    CheckpointProcess *records = (CheckpointProcess*)(map + processes_offset);
+    for (int i = 0; i < count; i++) {
+        save_process(&records[i], &processes[i]);
+    }
+    if (keys_offset > 0) {
+        memcpy(map + keys_offset, snap->keys, sizeof(long long) * count);
+    }
+    if (wake_offset > 0) {
+        // 只有阻塞进程的完成时刻有意义，其余写0使相同状态得到相同的文件
+        long long *wake = (long long*)(map + wake_offset);
+        for (int i = 0; i < count; i++) {
+            if (processes[i].status == PROCESS_BLOCKED) wake[i] = snap->wake_time[i];
+        }
+    }
+    if (levels_offset > 0) {
+        memcpy(map + levels_offset, snap->levels, sizeof(int) * count);
+    }
+    if (queue_offset > 0) {
+        memcpy(map + queue_offset, snap->queue, sizeof(int) * snap->queue_length);
+    }
+    header->checksum = checkpoint_checksum(map, size);
+
+    int failed = munmap(map, size) != 0 || fsync(fd) != 0;
+    if (close(fd) != 0) failed = 1;
+    if (failed || rename(tmp_path, path) != 0) {
+        perror("检查点写入失败");
+        unlink(tmp_path);
+        return -1;
+    }
+    return 0;
+}
+
+// 段 [offset, offset + size) 是否位于文件内且按8字节对齐；offset 为0表示段不存在
+static int section_valid(unsigned long long offset, size_t size, size_t file_size) {
+    if (offset == 0) return 1;
+    return offset % 8 == 0 && offset >= sizeof(CheckpointHeader) && offset <= file_size &&
+           size <= file_size - offset;
+}
+
+// 检查头部与文件大小、各段范围以及当前算法所需的段是否一致
+static int header_valid(const CheckpointHeader *header, size_t file_size) {
+    if (memcmp(header->magic, CHECKPOINT_MAGIC, sizeof(header->magic)) != 0 ||
+        header->version != CHECKPOINT_VERSION || header->header_size != (int)sizeof(CheckpointHeader) ||
+        header->record_size != (int)sizeof(CheckpointProcess) || header->file_size != file_size ||
+        header->count <= 0 || header->queue_length < 0 || header->queue_length > header->count ||
+        header->algorithm < 0 || header->algorithm >= ALGO_COUNT) {
+        return 0;
+    }
+
+    size_t count = header->count;
+    if (header->processes_offset == 0 ||
+        !section_valid(header->processes_offset, sizeof(CheckpointProcess) * count, file_size) ||
+        !section_valid(header->keys_offset, sizeof(long long) * count, file_size) ||
+        !section_valid(header->wake_offset, sizeof(long long) * count, file_size) ||
+        !section_valid(header->levels_offset, sizeof(int) * count, file_size) ||
+        !section_valid(header->queue_offset, sizeof(int) * header->queue_length, file_size)) {
+        return 0;
+    }
+
+    int needs_keys = header->algorithm == ALGO_SRTF || header->algorithm == ALGO_PRIORITY_AGING ||
+                     header->algorithm == ALGO_EDF || header->algorithm == ALGO_STRIDE;
+    if ((needs_keys && header->keys_offset == 0) ||
+        (header->algorithm == ALGO_MLFQ && header->levels_offset == 0) ||
+        (header->io_devices > 0 && header->wake_offset == 0) ||
+        (header->queue_length > 0 && header->queue_offset == 0)) {
+        return 0;
+    }
+    return 1;
+}
+
+/**
+ * 以只读方式映射检查点文件并校验
+ * @return 检查点，文件无法读取、格式不符或校验和错误时返回NULL
+ */
+Checkpoint* open_checkpoint(const char *path) {
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        perror("无法打开检查点文件");
+        return NULL;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || (size_t)st.st_size < sizeof(CheckpointHeader)) {
+        print_colored("不是有效的检查点文件: %s\n", RED, path);
+        close(fd);
+        return NULL;
+    }
+
+    size_t size = st.st_size;
+    void *map = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED) {
+        perror("无法映射检查点文件");
+        return NULL;
+    }
+
+    const CheckpointHeader *header = (const CheckpointHeader*)map;
+    if (!header_valid(header, size)) {
+        print_colored("不是有效的检查点文件，或由其他版本写出: %s\n", RED, path);
+        munmap(map, size);
+        return NULL;
+    }
+    if (checkpoint_checksum(map, size) != header->checksum) {
+        print_colored("检查点文件校验和错误: %s\n", RED, path);
+        munmap(map, size);
+        return NULL;
+    }
+
+    Checkpoint *checkpoint = (Checkpoint*)malloc(sizeof(Checkpoint));
+    if (checkpoint == NULL) {
+        munmap(map, size);
+        return NULL;
+    }
+    checkpoint->map = map;
+    checkpoint->size = size;
+    checkpoint->header = header;
+    checkpoint->processes = (const CheckpointProcess*)((const char*)map + header->processes_offset);
+    return checkpoint;
+}
+
+/**
+ * 解除映射并释放检查点；由其得到的快照随之失效
+ */
+void close_checkpoint(Checkpoint *checkpoint) {
+    if (checkpoint == NULL) return;
+    munmap(checkpoint->map, checkpoint->size);
+    free(checkpoint);
+}
+
+/**
+ * 由检查点得到调度循环状态，数组成员直接指向映射的文件
+ */
+void checkpoint_snapshot(const Checkpoint *checkpoint, SimSnapshot *snap) {
+    const CheckpointHeader *header = checkpoint->header;
+    const char *base = (const char*)checkpoint->map;
+
+    memset(snap, 0, sizeof(*snap));
+    snap->clock = header->clock;
+    snap->completed = header->completed;
+    snap->next_arrival = header->next_arrival;
+    memcpy(snap->device_free, header->device_free, sizeof(snap->device_free));
+    snap->wake_time = header->wake_offset ? (const long long*)(base + header->wake_offset) : NULL;
+    snap->keys = header->keys_offset ? (const long long*)(base + header->keys_offset) : NULL;
+    snap->levels = header->levels_offset ? (const int*)(base + header->levels_offset) : NULL;
+    snap->queue = header->queue_offset ? (const int*)(base + header->queue_offset) : NULL;
+    snap->queue_length = header->queue_length;
+    snap->current = header->current;
+    snap->current_key = header->current_key;
+    snap->density = header->density;
+    snap->next_boost = header->next_boost;
+    snap->min_vruntime = header->min_vruntime;
+    snap->global_pass = header->global_pass;
+    snap->rng_state = header->rng_state;
+    snap->deadline_rejected = header->deadline_rejected;
+    snap->io_stats = header->has_io_stats ? &header->io_stats : NULL;
+}
+
+/**
+ * 由检查点重建进程数组
+ * @return 新分配的进程数组，失败返回NULL
+ */
+PCB* checkpoint_processes(const Checkpoint *checkpoint) {
+    int count = checkpoint->header->count;
+    PCB *processes = (PCB*)malloc(sizeof(PCB) * count);
+    if (processes == NULL) {
+        perror("进程数组分配失败");
+        return NULL;
+    }
+
+    for (int i = 0; i < count; i++) {
+        load_process(&processes[i], &checkpoint->processes[i]);
+    }
+    return processes;
+}
+
+/**
+ * 由检查点恢复调度参数，指针成员（统计、执行记录、检查点）清空，由调用者重新设置
+ */
+void checkpoint_config(const Checkpoint *checkpoint, SchedConfig *config) {
+    const CheckpointHeader *header = checkpoint->header;
+
+    memset(config, 0, sizeof(*config));
+    config->algorithm = (SchedAlgorithm)header->algorithm;
+    config->time_quantum = header->time_quantum;
+    config->mlfq_levels = header->mlfq_levels;
+    config->boost_interval = header->boost_interval;
+    config->aging_interval = header->aging_interval;
+    config->min_granularity = header->min_granularity;
+    config->target_latency = header->target_latency;
+    config->time_limit = header->time_limit;
+    config->random_seed = header->random_seed;
+    config->admission_control = header->admission_control;
+    config->io_devices = header->io_devices;
+    memcpy(config->io_latency, header->io_latency, sizeof(config->io_latency));
+}
+
+static void handle_stop_signal(int sig) {
+    (void)sig;
+    stop_requested = 1;
+}
+
+/**
+ * 捕获 SIGINT 和 SIGTERM：模拟在下一个调度点写入检查点后停止，而不是直接退出
+ */
+void checkpoint_catch_signals() {
+    struct sigaction action;
+    memset(&action, 0, sizeof(action));
+    action.sa_handler = handle_stop_signal;
+    sigemptyset(&action.sa_mask);
+    sigaction(SIGINT, &action, NULL);
+    sigaction(SIGTERM, &action, NULL);
+}
+
+/**
+ * 是否收到了停止信号
+ */
+int checkpoint_stop_requested() {
+    return stop_requested;
+}
+
+// 平均周转和等待时间等结果摘要
+static void print_run_summary(const PCB *processes, int count, int makespan, const CompletionStats *stats) {
+    long long decisions = 0;
+    for (int i = 0; i < count; i++) {
+        decisions += processes[i].dispatch_count;
+    }
+    print_colored("完工时刻 %d, 调度决策 %lld 次, 平均周转 %.2f, 平均等待 %.2f, P99等待 %d\n", GREEN,
+                 makespan, decisions, hist_mean(&stats->turnaround), hist_mean(&stats->waiting),
+                 hist_percentile(&stats->waiting, 0.99));
+}
+
+// 打印检查点头部，只读取头部，不加载进程数组
+static int inspect_checkpoint(const char *path) {
+    Checkpoint *checkpoint = open_checkpoint(path);
+    if (checkpoint == NULL) return 1;
+
+    const CheckpointHeader *header = checkpoint->header;
+    int ready = 0, blocked = 0;
+    for (int i = 0; i < header->count; i++) {
+        if (checkpoint->processes[i].status == PROCESS_BLOCKED) blocked++;
+    }
+    ready = header->next_arrival - header->completed - blocked - (header->current >= 0 ? 1 : 0);
+
+    print_colored("检查点 %s (%zu 字节, 每进程 %d 字节)\n", CYAN, path, checkpoint->size, header->record_size);
+    print_colored("  算法 %s, 时间片 %d, 设备 %d\n", WHITE, sched_algorithm_name((SchedAlgorithm)header->algorithm),
+                 header->time_quantum, header->io_devices);
+    print_colored("  时刻 %d: %d 个进程中已到达 %d, 已完成 %d, 就绪 %d, 阻塞 %d\n", WHITE, header->clock,
+                 header->count, header->next_arrival, header->completed, ready, blocked);
+    close_checkpoint(checkpoint);
+    return 0;
+}
+
+// 比较两次模拟的结果：完工时刻、各进程的统计字段和完成统计都必须相同
+// @return 不一致的进程数，完工时刻或完成统计不同时至少为1
+static int compare_runs(const PCB *a, const PCB *b, int count, int makespan_a, int makespan_b,
+                        const CompletionStats *stats_a, const CompletionStats *stats_b) {
+    int mismatched = 0;
+    for (int i = 0; i < count; i++) {
+        if (a[i].completion_time != b[i].completion_time || a[i].start_time != b[i].start_time ||
+            a[i].waiting_time != b[i].waiting_time || a[i].dispatch_count != b[i].dispatch_count ||
+            a[i].io_time != b[i].io_time || a[i].vruntime != b[i].vruntime) {
+            mismatched++;
+        }
+    }
+    if (mismatched == 0 && (makespan_a != makespan_b || memcmp(stats_a, stats_b, sizeof(*stats_a)) != 0)) {
+        mismatched = 1;
+    }
+    return mismatched;
+}
+
+// 校验恢复的准确性：不中断运行一次，再在 stop_at 处写检查点停止、从文件恢复运行到结束，比较两次结果
+static int verify_resume(const PCB *workload, int count, const SchedConfig *base, const char *path, int stop_at) {
+    PCB *reference = copy_processes(workload, count);
+    CompletionStats *stats = (CompletionStats*)malloc(sizeof(CompletionStats) * 2);
+    if (reference == NULL || stats == NULL) {
+        free(reference);
+        free(stats);
+        return 1;
+    }
+
+    SchedConfig config = *base;
+    int was_quiet = is_quiet_mode();
+    completion_stats_init(&stats[0]);
+    config.stats = &stats[0];
+    set_quiet_mode(1);
+    int expected = run_simulation(reference, count, &config);
+    if (stop_at <= 0) stop_at = expected / 2;
+
+    // 第一段：运行到 stop_at 后写检查点停止
+    PCB *first = copy_processes(workload, count);
+    CheckpointConfig cp = { .path = path, .stop_at = stop_at };
+    config.stats = NULL;
+    config.checkpoint = &cp;
+    int result = first != NULL ? run_simulation(first, count, &config) : -1;
+    set_quiet_mode(was_quiet);
+    free(first);
+    if (expected < 0 || result < 0 || !cp.stopped || cp.written == 0) {
+        print_colored("运行到时刻 %d 并写入检查点失败\n", RED, stop_at);
+        free(reference);
+        free(stats);
+        return 1;
+    }
+
+    // 第二段：只凭检查点文件恢复，换用新的进程数组和统计
+    Checkpoint *checkpoint = open_checkpoint(path);
+    PCB *resumed = checkpoint != NULL ? checkpoint_processes(checkpoint) : NULL;
+    int makespan = -1;
+    if (resumed != NULL) {
+        SchedConfig restored;
+        CheckpointConfig resume = { .resume = checkpoint };
+        checkpoint_config(checkpoint, &restored);
+        completion_stats_init(&stats[1]);
+        restored.stats = &stats[1];
+        restored.checkpoint = &resume;
+        set_quiet_mode(1);
+        makespan = run_simulation(resumed, count, &restored);
+        set_quiet_mode(was_quiet);
+    }
+
+    int mismatched = makespan < 0 ? count
+                                  : compare_runs(reference, resumed, count, expected, makespan, &stats[0], &stats[1]);
+    if (mismatched == 0) {
+        print_colored("在时刻 %d 写检查点并恢复后，%d 个进程的结果与不中断运行完全一致 (完工时刻 %d)\n", GREEN,
+                     cp.last_clock, count, makespan);
+    } else {
+        print_colored("恢复结果与不中断运行不一致: %d 个进程不同 (完工时刻 %d / %d)\n", RED,
+                     mismatched, makespan, expected);
+    }
+
+    free(resumed);
+    close_checkpoint(checkpoint);
+    free(reference);
+    free(stats);
+    return mismatched == 0 ? 0 : 1;
+}
+
+static void print_checkpoint_usage(const char *prog) {
+    print_colored("用法: %s checkpoint [选项]\n", YELLOW, prog);
+    print_colored("  -n 数量    生成的进程数量 (默认 200000)\n", WHITE);
+    print_colored("  -s 种子    随机种子 (默认 1)\n", WHITE);
+    print_colored("  -f 文件    从文件加载工作负载\n", WHITE);
+    print_colored("  -a 算法    调度算法 (默认 RR)\n", WHITE);
+    print_colored("  -q 片长    时间片；恢复时指定则以新的时间片继续，用于假设分析 (默认 4)\n", WHITE);
+    print_colored("  -d 设备数  模拟的I/O设备数，一半进程为I/O密集型 (默认 0，不模拟I/O)\n", WHITE);
+    print_colored("  -o 文件    检查点文件 (默认 sched.ckpt，恢复时默认覆盖原文件)\n", WHITE);
+    print_colored("  -i 间隔    每隔多少个时间单位写一次检查点 (默认 0，只在停止时写)\n", WHITE);
+    print_colored("  -x 时刻    运行到该时刻写入检查点后停止\n", WHITE);
+    print_colored("  -r 文件    从检查点继续运行\n", WHITE);
+    print_colored("  -t 文件    查看检查点\n", WHITE);
+    print_colored("  -c 1       校验：在 -x 时刻（默认为完工时刻的一半）停止并恢复，与不中断运行比较\n", WHITE);
+    print_colored("运行中按 Ctrl-C 会在下一个调度点写入检查点后退出\n", WHITE);
+}
+
+/**
+ * 检查点命令行入口：带定期检查点运行模拟、从检查点继续或分叉、校验恢复的准确性
+ * @return 进程退出码
+ */
+int checkpoint_main(int argc, char *argv[]) {
+    int count = 200000;
+    unsigned int seed = 1;
+    const char *workload_path = NULL;
+    int algorithm = ALGO_RR;
+    int quantum = 0;
+    int devices = 0;
+    const char *output = NULL;
+    int interval = 0;
+    int stop_at = 0;
+    const char *resume_path = NULL;
+    int verify = 0;
+
+    for (int i = 1; i < argc; i += 2) {
+        const char *opt = argv[i];
+        const char *value = (i + 1 < argc) ? argv[i + 1] : NULL;
+
+        if (value == NULL || opt[0] != '-' || opt[1] == '\0' || opt[2] != '\0') {
+            print_checkpoint_usage(argv[0]);
+            return 1;
+        }
+
+        switch (opt[1]) {
+            case 'n': count = atoi(value); break;
+            case 's': seed = (unsigned int)strtoul(value, NULL, 10); break;
+            case 'f': workload_path = value; break;
+            case 'a':
+                algorithm = parse_sched_algorithm(value);
+                if (algorithm < 0) return 1;
+                break;
+            case 'q': quantum = atoi(value); break;
+            case 'd': devices = atoi(value); break;
+            case 'o': output = value; break;
+            case 'i': interval = atoi(value); break;
+            case 'x': stop_at = atoi(value); break;
+            case 'r': resume_path = value; break;
+            case 't': return inspect_checkpoint(value);
+            case 'c': verify = atoi(value); break;
+            default:
+                print_checkpoint_usage(argv[0]);
+                return 1;
+        }
+    }
+    if (devices > IO_MAX_DEVICES) devices = IO_MAX_DEVICES;
+    if (output == NULL) {
+        output = resume_path != NULL ? resume_path : "sched.ckpt";
+    }
+
+    PCB *processes = NULL;
+    Checkpoint *checkpoint = NULL;
+    SchedConfig config;
+    CheckpointConfig cp = { .path = output, .interval = interval, .stop_at = stop_at };
+
+    if (resume_path != NULL) {
+        checkpoint = open_checkpoint(resume_path);
+        processes = checkpoint != NULL ? checkpoint_processes(checkpoint) : NULL;
+        if (processes == NULL) {
+            close_checkpoint(checkpoint);
+            return 1;
+        }
+        count = checkpoint->header->count;
+        checkpoint_config(checkpoint, &config);
+        if (quantum > 0) config.time_quantum = quantum;
+        cp.resume = checkpoint;
+        print_colored("从检查点 %s 的时刻 %d 继续 %s 模拟 (%d/%d 个进程已完成)\n", CYAN, resume_path,
+                     checkpoint->header->clock, sched_algorithm_name(config.algorithm),
+                     checkpoint->header->completed, count);
+    } else {
+        processes = workload_path != NULL ? load_workload(workload_path, &count)
+                                          : (count > 0 ? generate_workload(count, seed) : NULL);
+        if (processes == NULL) {
+            print_colored("无法获得工作负载\n", RED);
+            return 1;
+        }
+        if (devices > 0 && workload_path == NULL) {
+            assign_io_bursts(processes, count, seed + 2, 50, devices);
+        }
+
+        SchedConfig fresh;
+        sched_config_defaults(&fresh, (SchedAlgorithm)algorithm);
+        if (quantum > 0) fresh.time_quantum = quantum;
+        fresh.random_seed = seed;
+        fresh.io_devices = devices;
+        for (int d = 0; d < IO_MAX_DEVICES; d++) {
+            fresh.io_latency[d] = 5;
+        }
+        config = fresh;
+
+        if (verify) {
+            int status = verify_resume(processes, count, &config, output, stop_at);
+            free(processes);
+            return status;
+        }
+        print_colored("%s 模拟: %d 个进程, 检查点文件 %s\n", CYAN, sched_algorithm_name(config.algorithm),
+                     count, output);
+    }
+
+    CompletionStats *stats = (CompletionStats*)malloc(sizeof(CompletionStats));
+    if (stats == NULL) {
+        free(processes);
+        close_checkpoint(checkpoint);
+        return 1;
+    }
+    completion_stats_init(stats);
+    config.stats = stats;
+    config.checkpoint = &cp;
+
+    checkpoint_catch_signals();
+    int was_quiet = is_quiet_mode();
+    set_quiet_mode(1);
+    double start = now_ms();
+    int makespan = run_simulation(processes, count, &config);
+    double elapsed = now_ms() - start;
+    set_quiet_mode(was_quiet);
+
+    int status = 0;
+    if (makespan < 0) {
+        print_colored("模拟失败\n", RED);
+        status = 1;
+    } else if (cp.stopped && cp.written > 0 && cp.last_clock == makespan) {
+        print_colored("在时刻 %d 停止，检查点已写入 %s，用 -r %s 继续\n", YELLOW, makespan, output, output);
+    } else if (cp.stopped) {
+        print_colored("在时刻 %d 停止，但检查点写入失败\n", RED, makespan);
+        status = 1;
+    } else {
+        print_run_summary(processes, count, makespan, stats);
+    }
+
+    if (cp.written + cp.failed > 0) {
+        struct stat st;
+        long long file_size = stat(output, &st) == 0 ? (long long)st.st_size : 0;
+        print_colored("写入检查点 %d 次 (失败 %d 次), 每次 %.1f ms, 文件 %lld 字节, 模拟总耗时 %.1f ms\n",
+                     cp.failed > 0 ? RED : WHITE, cp.written, cp.failed,
+                     cp.write_ms / (cp.written + cp.failed), file_size, elapsed);
+    }
+
+    free(stats);
+    free(processes);
+    close_checkpoint(checkpoint);
+    return status;
+}
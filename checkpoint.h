@@ -0,0 +1,135 @@
+#ifndef CHECKPOINT_H
+#define CHECKPOINT_H
+
+#include <stddef.h>
+#include "process_control.h"
+#include "simulator.h"
+#include "stats.h"
+
+#define CHECKPOINT_MAGIC "SCHEDCKP"
+#define CHECKPOINT_VERSION 1
+
+// 检查点文件布局（本机字节序，各段按8字节对齐，可直接 mmap 后按偏移访问）：
+//   CheckpointHeader | CheckpointProcess[count] | long long keys[count] | long long wake_time[count]
+//   | int levels[count] | int queue[queue_length]
+// keys、wake_time、levels 只在对应算法或I/O模拟需要时存在，偏移为0表示该段不存在
+
+// 单个进程的状态，定长记录；next/prev/unix_pid 不保存
+typedef struct {
+    int pid;
+    char name[32];
+    int status;
+    int priority;
+    int arrive_time;
+    int service_time;
+    int deadline;
+    int cpu_burst;
+    int io_device;
+    int burst_left;
+    int io_time;
+    int remaining_time;
+    int completion_time;
+    int turnaround_time;
+    float weighted_turnaround;
+    int waiting_time;
+    int start_time;
+    int dispatch_count;
+    long long vruntime;
+} CheckpointProcess;
+
+typedef struct {
+    char magic[8];
+    int version;
+    int header_size;            // sizeof(CheckpointHeader)，拒绝其他编译结果写出的文件
+    int record_size;            // sizeof(CheckpointProcess)
+    int count;
+    unsigned long long file_size;
+    unsigned long long checksum; // 头部之后全部数据的 FNV-1a 校验和
+
+    // 调度参数（不含指针成员）
+    int algorithm;
+    int time_quantum;
+    int mlfq_levels;
+    int boost_interval;
+    int aging_interval;
+    int min_granularity;
+    int target_latency;
+    int time_limit;
+    unsigned int random_seed;
+    int admission_control;
+    int io_devices;
+    int io_latency[IO_MAX_DEVICES];
+
+    // 调度循环状态
+    int clock;
+    int completed;
+    int next_arrival;
+    int device_free[IO_MAX_DEVICES];
+    int current;
+    int next_boost;
+    unsigned int rng_state;
+    long long current_key;
+    long long min_vruntime;
+    long long global_pass;
+    double density;
+    long long deadline_rejected;
+    int has_io_stats;
+    IoStats io_stats;
+
+    // 各段偏移
+    unsigned long long processes_offset;
+    unsigned long long keys_offset;
+    unsigned long long wake_offset;
+    unsigned long long levels_offset;
+    unsigned long long queue_offset;
+    int queue_length;
+} CheckpointHeader;
+
+// 调度循环开始处的模拟器状态。保存时指针指向模拟器内部数组，恢复时指向映射的检查点文件。
+// 每个进程的状态保存在PCB数组中，这里只有PCB之外的部分
+typedef struct {
+    int clock;
+    int completed;
+    int next_arrival;           // 按到达时间排序后下一个尚未到达的位置
+    int device_free[IO_MAX_DEVICES];
+    const long long *wake_time; // 阻塞进程的I/O完成时刻，不模拟I/O时为NULL
+    const long long *keys;      // 抢占式调度的堆键或步长调度的行程，其他算法为NULL
+    const int *levels;          // MLFQ各进程所在级别，其他算法为NULL
+    const int *queue;           // FCFS/RR/MLFQ就绪队列中的进程下标，按出队顺序，MLFQ按级别依次排列
+    int queue_length;
+    int current;                // 抢占式调度正在运行的进程下标，-1 表示没有
+    long long current_key;
+    double density;             // EDF已接纳作业的密度之和
+    int next_boost;             // MLFQ下一次优先级提升的时刻
+    long long min_vruntime;     // CFS
+    long long global_pass;      // 步长调度
+    unsigned int rng_state;     // 彩票调度的随机数状态
+    long long deadline_rejected; // 被接纳控制拒绝的作业数
+    const IoStats *io_stats;    // 累计的I/O统计，没有时为NULL
+} SimSnapshot;
+
+// 映射到内存的检查点文件
+typedef struct Checkpoint {
+    void *map;
+    size_t size;
+    const CheckpointHeader *header;
+    const CheckpointProcess *processes;
+} Checkpoint;
+
+// 检查点文件函数
+int write_checkpoint(const char *path, const PCB *processes, int count, const SchedConfig *config,
+                     const SimSnapshot *snap);
+Checkpoint* open_checkpoint(const char *path);
+void close_checkpoint(Checkpoint *checkpoint);
+void checkpoint_snapshot(const Checkpoint *checkpoint, SimSnapshot *snap);
+PCB* checkpoint_processes(const Checkpoint *checkpoint);
+void checkpoint_config(const Checkpoint *checkpoint, SchedConfig *config);
+
+// 中断处理函数
+void checkpoint_catch_signals();
+int checkpoint_stop_requested();
+
+// 检查点命令行入口
+int checkpoint_main(int argc, char *argv[]);
+
+#endif // CHECKPOINT_H
@@ -0,0 +1,286 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <time.h>
+#include "dashboard.h"
+#include "timeutil.h"
+
+#define DASHBOARD_WIDTH 80
+#define DASHBOARD_BAR_WIDTH 30
+#define DASHBOARD_THREAD_ROWS 8     // 最多逐个显示的线程数
+#define DASHBOARD_HEADER_ROWS 8     // 标题、分隔线、各计数器、队列深度、分隔线
+
+// 当前线程登记的槽位，未登记时为NULL
+static _Thread_local DashboardSlot *current_slot = NULL;
+
+static const char *counter_labels[DASH_COUNTERS] = {
+    "转账/秒",
+    "失败/秒",
+    "锁等待/秒",
+    "模拟时间/秒"
+};
+
+static const Color counter_colors[DASH_COUNTERS] = { GREEN, RED, YELLOW, CYAN };
+
+static unsigned long long slot_counter(const DashboardSlot *slot, DashCounter counter) {
+    return atomic_load_explicit(&slot->counters[counter], memory_order_relaxed);
+}
+
+// 登记过的槽位数（登记失败的线程也会使计数增加，这里截断到容量）
+static int registered_slots(Dashboard *dashboard) {
+    int registered = atomic_load_explicit(&dashboard->registered, memory_order_acquire);
+    return registered < dashboard->capacity ? registered : dashboard->capacity;
+}
+
+// 在一行中画出按 peak 缩放的条形图
+static void put_bar(Frame *frame, int row, int col, double value, double peak, Color color) {
+    int width = peak > 0 ? (int)(value / peak * DASHBOARD_BAR_WIDTH + 0.5) : 0;
+    if (width > DASHBOARD_BAR_WIDTH) width = DASHBOARD_BAR_WIDTH;
+    for (int j = 0; j < DASHBOARD_BAR_WIDTH; j++) {
+        frame_put(frame, row, col + j, j < width ? "█" : "·", j < width ? color : WHITE);
+    }
+}
+
+// 汇总所有槽位并重绘；final 为1时显示整个运行期间的平均速率
+static void dashboard_refresh(Dashboard *dashboard, int final) {
+    double now = now_ms();
+    double elapsed = now - dashboard->start_ms;
+    double interval = final ? elapsed : now - dashboard->last_ms;
+    int slots = registered_slots(dashboard);
+
+    unsigned long long totals[DASH_COUNTERS] = {0};
+    long long depth = 0;
+    for (int i = 0; i < slots; i++) {
+        for (int c = 0; c < DASH_COUNTERS; c++) {
+            totals[c] += slot_counter(&dashboard->slots[i], (DashCounter)c);
+        }
+        depth += atomic_load_explicit(&dashboard->slots[i].queue_depth, memory_order_relaxed);
+    }
+
+    for (int c = 0; c < DASH_COUNTERS; c++) {
+        unsigned long long delta = final ? totals[c] : totals[c] - dashboard->last[c];
+        dashboard->rate[c] = interval > 0 ? delta * 1000.0 / interval : 0.0;
+        if (dashboard->rate[c] > dashboard->peak[c]) {
+            dashboard->peak[c] = dashboard->rate[c];
+        }
+        dashboard->last[c] = totals[c];
+    }
+    if (depth > dashboard->peak_depth) {
+        dashboard->peak_depth = depth;
+    }
+    dashboard->last_ms = now;
+
+    Frame *frame = dashboard->frame;
+    frame_clear(frame);
+
+    frame_text(frame, 0, 0, CYAN, "%s  运行 %.1f s  线程 %d  %s", dashboard->title, elapsed / 1000.0,
+               slots, final ? "已结束，显示平均速率" : "实时");
+    for (int j = 0; j < DASHBOARD_WIDTH; j++) {
+        frame_put(frame, 1, j, "─", CYAN);
+    }
+
+    for (int c = 0; c < DASH_COUNTERS; c++) {
+        int row = 2 + c;
+        frame_text(frame, row, 0, WHITE, "%s", counter_labels[c]);
+        frame_text(frame, row, 12, WHITE, "%12.0f ", dashboard->rate[c]);
+        put_bar(frame, row, 26, dashboard->rate[c], dashboard->peak[c], counter_colors[c]);
+        frame_text(frame, row, 58, WHITE, "累计 %llu", totals[c]);
+    }
+
+    int row = 2 + DASH_COUNTERS;
+    frame_text(frame, row, 0, WHITE, "队列深度");
+    frame_text(frame, row, 12, WHITE, "%12lld ", depth);
+    put_bar(frame, row, 26, (double)depth, (double)dashboard->peak_depth, MAGENTA);
+    frame_text(frame, row, 58, WHITE, "峰值 %lld", dashboard->peak_depth);
+
+    for (int j = 0; j < DASHBOARD_WIDTH; j++) {
+        frame_put(frame, row + 1, j, "─", CYAN);
+    }
+
+    int rows = frame->height - DASHBOARD_HEADER_ROWS;
+    for (int i = 0; i < slots && i < rows; i++) {
+        const DashboardSlot *slot = &dashboard->slots[i];
+        if (i == rows - 1 && slots > rows) {
+            frame_text(frame, DASHBOARD_HEADER_ROWS + i, 0, WHITE, "... 其余 %d 个线程", slots - i);
+            break;
+        }
+        frame_text(frame, DASHBOARD_HEADER_ROWS + i, 0, WHITE,
+                   "线程%-3d 转账 %-9llu 失败 %-7llu 锁等待 %-7llu 时间 %-11llu 队列 %lld", i,
+                   slot_counter(slot, DASH_TRANSFERS), slot_counter(slot, DASH_FAILURES),
+                   slot_counter(slot, DASH_LOCK_WAITS), slot_counter(slot, DASH_TICKS),
+                   (long long)atomic_load_explicit(&slot->queue_depth, memory_order_relaxed));
+    }
+
+    frame_render(frame);
+}
+
+// 显示线程：按固定间隔重绘，stop_dashboard 通过条件变量立即唤醒它
+static void* dashboard_thread(void *arg) {
+    Dashboard *dashboard = (Dashboard*)arg;
+
+    pthread_mutex_lock(&dashboard->mutex);
+    while (dashboard->running) {
+        struct timespec deadline;
+        clock_gettime(CLOCK_REALTIME, &deadline);
+        deadline.tv_nsec += (long)dashboard->interval_ms * 1000000L;
+        deadline.tv_sec += deadline.tv_nsec / 1000000000L;
+        deadline.tv_nsec %= 1000000000L;
+
+        int rc = 0;
+        while (dashboard->running && rc != ETIMEDOUT) {
+            rc = pthread_cond_timedwait(&dashboard->cond, &dashboard->mutex, &deadline);
+        }
+        if (!dashboard->running) break;
+
+        pthread_mutex_unlock(&dashboard->mutex);
+        dashboard_refresh(dashboard, 0);
+        pthread_mutex_lock(&dashboard->mutex);
+    }
+    pthread_mutex_unlock(&dashboard->mutex);
+    return NULL;
+}
+
+/**
+ * 创建实时仪表盘
+ * @param title 标题
+ * @param max_threads 最多登记的工作线程数
+ * @param refresh_hz 每秒刷新次数，<=0 时使用默认值
+ * @return 仪表盘指针，失败返回NULL
+ */
+Dashboard* create_dashboard(const char *title, int max_threads, int refresh_hz) {
+    if (max_threads <= 0) return NULL;
+    if (max_threads > DASHBOARD_MAX_THREADS) max_threads = DASHBOARD_MAX_THREADS;
+    if (refresh_hz <= 0) refresh_hz = DASHBOARD_DEFAULT_HZ;
+
+    Dashboard *dashboard = (Dashboard*)calloc(1, sizeof(Dashboard));
+    if (dashboard == NULL) return NULL;
+
+    dashboard->title = title;
+    dashboard->capacity = max_threads;
+    dashboard->interval_ms = 1000 / refresh_hz > 0 ? 1000 / refresh_hz : 1;
+    dashboard->slots = (DashboardSlot*)aligned_alloc(CACHE_LINE_SIZE, sizeof(DashboardSlot) * max_threads);
+
+    int rows = max_threads < DASHBOARD_THREAD_ROWS ? max_threads : DASHBOARD_THREAD_ROWS;
+    dashboard->frame = create_frame(DASHBOARD_WIDTH, DASHBOARD_HEADER_ROWS + rows);
+    if (dashboard->slots == NULL || dashboard->frame == NULL) {
+        destroy_dashboard(dashboard);
+        return NULL;
+    }
+    // 工作线程都被静默，仪表盘本身仍需输出
+    dashboard->frame->overlay = 1;
+
+    for (int i = 0; i < max_threads; i++) {
+        for (int c = 0; c < DASH_COUNTERS; c++) {
+            atomic_init(&dashboard->slots[i].counters[c], 0);
+        }
+        atomic_init(&dashboard->slots[i].queue_depth, 0);
+    }
+    atomic_init(&dashboard->registered, 0);
+    pthread_mutex_init(&dashboard->mutex, NULL);
+    pthread_cond_init(&dashboard->cond, NULL);
+    return dashboard;
+}
+
+/**
+ * 开始计时并启动显示线程。输出不是交互式终端时不启动显示线程，只在结束时输出一次汇总
+ * @return 成功返回0，失败返回-1
+ */
+int start_dashboard(Dashboard *dashboard) {
+    if (dashboard == NULL) return -1;
+
+    dashboard->start_ms = now_ms();
+    dashboard->last_ms = dashboard->start_ms;
+    if (!is_interactive_output()) return 0;
+
+    set_cursor_visible(0);
+    dashboard_refresh(dashboard, 0);
+
+    dashboard->running = 1;
+    if (pthread_create(&dashboard->thread, NULL, dashboard_thread, dashboard) != 0) {
+        dashboard->running = 0;
+        set_cursor_visible(1);
+        return -1;
+    }
+    dashboard->started = 1;
+    return 0;
+}
+
+/**
+ * 停止显示线程，并按整个运行期间的平均速率绘制最后一帧
+ */
+void stop_dashboard(Dashboard *dashboard) {
+    if (dashboard == NULL) return;
+
+    if (dashboard->started) {
+        pthread_mutex_lock(&dashboard->mutex);
+        dashboard->running = 0;
+        pthread_cond_signal(&dashboard->cond);
+        pthread_mutex_unlock(&dashboard->mutex);
+        pthread_join(dashboard->thread, NULL);
+        dashboard->started = 0;
+    }
+
+    dashboard_refresh(dashboard, 1);
+    set_cursor_visible(1);
+}
+
+/**
+ * 释放仪表盘，调用前必须已经停止且所有工作线程已经结束
+ */
+void destroy_dashboard(Dashboard *dashboard) {
+    if (dashboard == NULL) return;
+
+    if (dashboard->slots != NULL && dashboard->frame != NULL) {
+        pthread_mutex_destroy(&dashboard->mutex);
+        pthread_cond_destroy(&dashboard->cond);
+    }
+    destroy_frame(dashboard->frame);
+    free(dashboard->slots);
+    free(dashboard);
+}
+
+/**
+ * 为当前线程登记一个计数器槽位，之后该线程的 dashboard_count 计入此槽位
+ * @return 槽位下标，槽位用完时返回-1（该线程的计数被忽略）
+ */
+int dashboard_attach(Dashboard *dashboard) {
+    current_slot = NULL;
+    if (dashboard == NULL) return -1;
+
+    int index = atomic_fetch_add_explicit(&dashboard->registered, 1, memory_order_acq_rel);
+    if (index >= dashboard->capacity) return -1;
+
+    current_slot = &dashboard->slots[index];
+    return index;
+}
+
+/**
+ * 取消当前线程的登记，槽位中的计数保留到仪表盘销毁
+ */
+void dashboard_detach() {
+    current_slot = NULL;
+}
+
+/**
+ * 累加当前线程的计数器。每个槽位只有一个写入者，用普通的读-加-写而不是原子加，
+ * 不产生加锁的总线操作
+ */
+void dashboard_count(DashCounter counter, unsigned long long n) {
+    DashboardSlot *slot = current_slot;
+    if (slot == NULL) return;
+
+    atomic_ullong *value = &slot->counters[counter];
+    atomic_store_explicit(value, atomic_load_explicit(value, memory_order_relaxed) + n,
+                          memory_order_relaxed);
+}
+
+/**
+ * 报告当前线程看到的队列长度
+ */
+void dashboard_set_depth(long long depth) {
+    DashboardSlot *slot = current_slot;
+    if (slot == NULL) return;
+
+    atomic_store_explicit(&slot->queue_depth, depth, memory_order_relaxed);
+}
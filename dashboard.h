@@ -0,0 +1,66 @@
+#ifndef DASHBOARD_H
+#define DASHBOARD_H
+
+#include <pthread.h>
+#include <stdatomic.h>
+#include "visualization.h"
+
+#ifndef CACHE_LINE_SIZE
+#define CACHE_LINE_SIZE 64
+#endif
+
+#define DASHBOARD_MAX_THREADS 64
+#define DASHBOARD_DEFAULT_HZ 4
+
+// 仪表盘统计的计数器
+typedef enum {
+    DASH_TRANSFERS,         // 成功的转账
+    DASH_FAILURES,          // 失败的转账
+    DASH_LOCK_WAITS,        // 加锁时锁已被占用的次数
+    DASH_TICKS,             // 模拟推进的时间单位
+    DASH_COUNTERS
+} DashCounter;
+
+// 每个工作线程独占一个槽位，按缓存行对齐，线程之间不共享缓存行。
+// 只有所属线程写入（读-加-写，不需要原子加），显示线程只读
+typedef struct {
+    _Alignas(CACHE_LINE_SIZE) atomic_ullong counters[DASH_COUNTERS];
+    atomic_llong queue_depth;   // 该线程最近报告的队列长度
+} DashboardSlot;
+
+// 实时仪表盘：显示线程按固定频率汇总所有槽位并重绘，工作线程从不等待显示线程
+typedef struct {
+    const char *title;
+    DashboardSlot *slots;
+    int capacity;
+    atomic_int registered;      // 已分配的槽位数
+    int interval_ms;
+
+    pthread_t thread;
+    int started;
+    int running;                // 受 mutex 保护，只有显示线程和 stop_dashboard 使用
+    pthread_mutex_t mutex;
+    pthread_cond_t cond;
+
+    Frame *frame;
+    double start_ms;
+    double last_ms;
+    unsigned long long last[DASH_COUNTERS];
+    double rate[DASH_COUNTERS];
+    double peak[DASH_COUNTERS]; // 每秒速率的历史最大值，用于缩放条形图
+    long long peak_depth;
+} Dashboard;
+
+// 仪表盘函数
+Dashboard* create_dashboard(const char *title, int max_threads, int refresh_hz);
+int start_dashboard(Dashboard *dashboard);
+void stop_dashboard(Dashboard *dashboard);
+void destroy_dashboard(Dashboard *dashboard);
+
+// 工作线程函数（未登记的线程调用时不做任何事）
+int dashboard_attach(Dashboard *dashboard);
+void dashboard_detach();
+void dashboard_count(DashCounter counter, unsigned long long n);
+void dashboard_set_depth(long long depth);
+
+#endif // DASHBOARD_H
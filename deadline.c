@@ -0,0 +1,150 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "deadline.h"
+#include "process_control.h"
+#include "simulator.h"
+#include "stats.h"
+#include "sweep.h"
+#include "visualization.h"
+
+#define DEADLINE_TABLE_RULE "-------------------------------------------------------------------------------------------------------------------------"
+
+// 按目标负载缩放到达时间：负载 = 总服务时间 / 最后一个进程的到达时刻
+static void scale_arrivals(PCB *processes, const PCB *workload, int count, double scale) {
+    for (int i = 0; i < count; i++) {
+        processes[i] = workload[i];
+        processes[i].arrive_time = (int)(workload[i].arrive_time * scale);
+    }
+}
+
+/**
+ * 截止期限实验命令行入口：在不同负载下比较 EDF、带接纳控制的 EDF 与非抢占式优先级调度
+ * 的错过率与超期时长，负载超过100%时观察过载行为
+ * @return 进程退出码
+ */
+int deadline_main(int argc, char *argv[]) {
+    int count = 100000;
+    unsigned int seed = 1;
+    const char *path = NULL;
+    int percent = 50;
+    int loads[32] = {50, 80, 95, 100, 120, 150};
+    int num_loads = 6;
+    SchedConfig configs[3] = {
+        { .algorithm = ALGO_EDF },
+        { .algorithm = ALGO_EDF, .admission_control = 1 },
+        { .algorithm = ALGO_PRIORITY }
+    };
+
+    for (int i = 1; i < argc; i += 2) {
+        const char *opt = argv[i];
+        const char *value = (i + 1 < argc) ? argv[i + 1] : NULL;
+
+        if (value == NULL || opt[0] != '-' || opt[1] == '\0' || opt[2] != '\0') {
+            print_colored("用法: %s deadline [-n 数量] [-s 种子] [-f 文件] [-p 截止期限作业占比%%] [-l 负载%%列表]\n",
+                         YELLOW, argv[0]);
+            return 1;
+        }
+
+        switch (opt[1]) {
+            case 'n': count = atoi(value); break;
+            case 's': seed = (unsigned int)strtoul(value, NULL, 10); break;
+            case 'f': path = value; break;
+            case 'p': percent = atoi(value); break;
+            case 'l':
+                num_loads = parse_int_list(value, loads, sizeof(loads) / sizeof(loads[0]));
+                if (num_loads <= 0) {
+                    print_colored("无效的负载列表: %s\n", RED, value);
+                    return 1;
+                }
+                break;
+            default:
+                print_colored("未知选项: %s\n", RED, opt);
+                return 1;
+        }
+    }
+
+    // 从文件加载时使用文件中的截止期限，否则为生成的工作负载分配截止期限
+    PCB *workload = NULL;
+    if (path != NULL) {
+        workload = load_workload(path, &count);
+    } else if (count > 0) {
+        workload = generate_workload(count, seed);
+        if (workload != NULL) {
+            assign_deadlines(workload, count, seed + 1, percent);
+        }
+    }
+    if (workload == NULL) {
+        print_colored("无法获得工作负载\n", RED);
+        return 1;
+    }
+
+    PCB *processes = (PCB*)malloc(sizeof(PCB) * count);
+    DeadlineStats *stats = (DeadlineStats*)malloc(sizeof(DeadlineStats));
+    if (processes == NULL || stats == NULL) {
+        free(workload);
+        free(processes);
+        free(stats);
+        return 1;
+    }
+
+    long long total_service = 0;
+    int span = 1;
+    int deadline_jobs = 0;
+    for (int i = 0; i < count; i++) {
+        total_service += workload[i].service_time;
+        if (workload[i].arrive_time > span) span = workload[i].arrive_time;
+        if (workload[i].deadline > 0) deadline_jobs++;
+    }
+    double base_load = (double)total_service / span;
+
+    print_colored("截止期限实验: %d 个进程, 其中 %d 个有截止期限, 原始负载 %.0f%%\n", CYAN,
+                 count, deadline_jobs, base_load * 100);
+    print_colored("%s\n", WHITE, DEADLINE_TABLE_RULE);
+    print_colored("| %-6s | %-10s | %-8s | %-8s | %-8s | %-8s | %-8s | %-8s | %-8s | %-8s | %-10s |\n", WHITE,
+                 "负载", "算法", "拒绝", "错过率", "未达成", "平均延迟", "超期P50", "超期P99", "P99.9", "最大",
+                 "平均周转");
+    print_colored("%s\n", WHITE, DEADLINE_TABLE_RULE);
+
+    int was_quiet = is_quiet_mode();
+    for (int l = 0; l < num_loads; l++) {
+        for (int k = 0; k < 3; k++) {
+            scale_arrivals(processes, workload, count, base_load * 100 / loads[l]);
+            deadline_stats_init(stats);
+            configs[k].deadline_stats = stats;
+
+            set_quiet_mode(1);
+            int result = run_simulation(processes, count, &configs[k]);
+            set_quiet_mode(was_quiet);
+
+            const char *name = configs[k].admission_control ? "EDF+接纳" : sched_algorithm_name(configs[k].algorithm);
+            if (result < 0) {
+                print_colored("| %-5d%% | %-10s | 模拟失败\n", RED, loads[l], name);
+                continue;
+            }
+
+            double turnaround = 0.0;
+            for (int i = 0; i < count; i++) {
+                turnaround += processes[i].turnaround_time;
+            }
+
+            // 未达成 = (错过 + 被拒绝) / 原本有截止期限的作业数
+            long long offered = stats->jobs + stats->rejected;
+            double unmet = offered > 0 ? (double)(stats->missed + stats->rejected) / offered : 0.0;
+            double miss_rate = deadline_miss_rate(stats);
+            print_colored("| %-5d%% | %-10s | %-8lld | %-7.2f%% | %-7.2f%% | %-8.1f | %-8d | %-8d | %-8d | %-8d | %-10.1f |\n",
+                         miss_rate > 0.05 ? RED : (miss_rate > 0 ? YELLOW : GREEN),
+                         loads[l], name, stats->rejected, miss_rate * 100, unmet * 100,
+                         stats->jobs > 0 ? stats->lateness_sum / stats->jobs : 0.0,
+                         hist_percentile(&stats->tardiness, 0.50), hist_percentile(&stats->tardiness, 0.99),
+                         hist_percentile(&stats->tardiness, 0.999), stats->tardiness.max,
+                         turnaround / count);
+        }
+    }
+    print_colored("%s\n", WHITE, DEADLINE_TABLE_RULE);
+
+    free(stats);
+    free(processes);
+    free(workload);
+    return 0;
+}
@@ -0,0 +1,7 @@
+#ifndef DEADLINE_H
+#define DEADLINE_H
+
+// 截止期限实验命令行入口：不同负载下 EDF、带接纳控制的 EDF 与优先级调度的错过率
+int deadline_main(int argc, char *argv[]);
+
+#endif // DEADLINE_H
@@ -0,0 +1,538 @@
+#include <errno.h>
+#include <fcntl.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#include "export.h"
+#include "visualization.h"
+
+#define CSV_FIELD_RESERVE 64        // 一个数值字段（含分隔符）最多占用的字节数
+
+static const double decimal_scale[] = { 1, 10, 100, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9 };
+
+// "00" 到 "99"，整数每次转换两位，除法链缩短一半
+static const char digit_pairs[] =
+    "00010203040506070809101112131415161718192021222324252627282930313233343536373839"
+    "40414243444546474849505152535455565758596061626364656667686970717273747576777879"
+    "8081828384858687888990919293949596979899";
+
+// 把整个 iovec 数组写完，处理部分写入
+static int writev_all(int fd, struct iovec *iov, int count) {
+    while (count > 0) {
+        ssize_t n = writev(fd, iov, count);
+        if (n < 0 && errno == EINTR) continue;
+        if (n < 0) return -1;
+
+        while (count > 0 && (size_t)n >= iov->iov_len) {
+            n -= (ssize_t)iov->iov_len;
+            iov++;
+            count--;
+        }
+        if (count > 0) {
+            iov->iov_base = (char*)iov->iov_base + n;
+            iov->iov_len -= (size_t)n;
+        }
+    }
+    return 0;
+}
+
+// 提交前 blocks 块（已换出的块按各自记录的长度，最后一块提交 last_used 字节），之后从第一块重新开始填充
+static void csv_flush(CsvWriter *writer, int blocks, size_t last_used) {
+    struct iovec iov[EXPORT_BUFFERS];
+    unsigned long long total = 0;
+    for (int i = 0; i < blocks; i++) {
+        iov[i].iov_base = writer->iov[i].iov_base;
+        iov[i].iov_len = (i == blocks - 1) ? last_used : writer->iov[i].iov_len;
+        total += iov[i].iov_len;
+    }
+    if (!writer->failed && writev_all(writer->fd, iov, blocks) != 0) {
+        perror("导出写入失败");
+        writer->failed = 1;
+    }
+    writer->bytes += total;
+    writer->current = 0;
+    writer->used = 0;
+}
+
+// 保证当前块至少还有 need 字节，不够时换到下一块，所有块都写满时提交
+static char* csv_reserve(CsvWriter *writer, size_t need) {
+    if (writer->used + need > EXPORT_BUFFER_SIZE) {
+        writer->iov[writer->current].iov_len = writer->used;
+        if (writer->current + 1 == EXPORT_BUFFERS) {
+            csv_flush(writer, EXPORT_BUFFERS, writer->used);
+        } else {
+            writer->current++;
+            writer->used = 0;
+        }
+    }
+    return (char*)writer->iov[writer->current].iov_base + writer->used;
+}
+
+// 字段之间的逗号
+static char* csv_separator(CsvWriter *writer, char *out) {
+    if (writer->fields++ > 0) {
+        *out++ = ',';
+    }
+    return out;
+}
+
+// 把无符号整数的十进制表示直接写到 out，先数出位数再从末尾往前填，返回写完后的位置
+static char* format_digits(char *out, unsigned long long value) {
+    int length = 1;
+    for (unsigned long long limit = 10; length < 20 && value >= limit; limit *= 10) {
+        length++;
+    }
+
+    char *end = out + length;
+    char *next = end;
+    while (value >= 100) {
+        const char *pair = digit_pairs + (value % 100) * 2;
+        value /= 100;
+        *--next = pair[1];
+        *--next = pair[0];
+    }
+    if (value >= 10) {
+        *--next = digit_pairs[value * 2 + 1];
+        *--next = digit_pairs[value * 2];
+    } else {
+        *--next = (char)('0' + value);
+    }
+    return end;
+}
+
+/**
+ * 创建CSV文件
+ * @return 写入器指针，失败返回NULL
+ */
+CsvWriter* csv_open(const char *path) {
+    CsvWriter *writer = (CsvWriter*)calloc(1, sizeof(CsvWriter));
+    if (writer == NULL) return NULL;
+
+    writer->memory = (char*)malloc((size_t)EXPORT_BUFFER_SIZE * EXPORT_BUFFERS);
+    writer->fd = open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (writer->memory == NULL || writer->fd < 0) {
+        perror("无法创建导出文件");
+        if (writer->fd >= 0) close(writer->fd);
+        free(writer->memory);
+        free(writer);
+        return NULL;
+    }
+    for (int i = 0; i < EXPORT_BUFFERS; i++) {
+        writer->iov[i].iov_base = writer->memory + (size_t)i * EXPORT_BUFFER_SIZE;
+        writer->iov[i].iov_len = 0;
+    }
+    return writer;
+}
+
+/**
+ * 写一个文本字段，含逗号、引号或换行时按RFC 4180加引号
+ */
+void csv_text(CsvWriter *writer, const char *text) {
+    size_t length = strlen(text);
+    // 最坏情况每个字符都是引号；过长的文本截断到一块缓冲区以内
+    if (length > EXPORT_BUFFER_SIZE / 2 - 4) length = EXPORT_BUFFER_SIZE / 2 - 4;
+
+    char *start = csv_reserve(writer, 2 * length + 4);
+    char *out = csv_separator(writer, start);
+
+    // 先按原样复制，同时检查是否有需要加引号的字符（常见情况只扫描一遍）
+    int special = 0;
+    for (size_t i = 0; i < length; i++) {
+        char c = text[i];
+        special |= (c == ',') | (c == '"') | (c == '\r') | (c == '\n');
+        out[i] = c;
+    }
+    if (!special) {
+        out += length;
+    } else {
+        *out++ = '"';
+        for (size_t i = 0; i < length; i++) {
+            if (text[i] == '"') *out++ = '"';
+            *out++ = text[i];
+        }
+        *out++ = '"';
+    }
+    writer->used += (size_t)(out - start);
+}
+
+/**
+ * 写一个整数字段
+ */
+void csv_int(CsvWriter *writer, long long value) {
+    char *start = csv_reserve(writer, CSV_FIELD_RESERVE);
+    char *out = csv_separator(writer, start);
+
+    unsigned long long magnitude = value < 0 ? 0ULL - (unsigned long long)value : (unsigned long long)value;
+    if (value < 0) *out++ = '-';
+    out = format_digits(out, magnitude);
+
+    writer->used += (size_t)(out - start);
+}
+
+/**
+ * 写一个保留 decimals 位小数（0~9）的浮点数字段。
+ * 放大后能放进64位整数的值用整数运算格式化（四舍五入），其余按 %.17g 交给 snprintf
+ */
+void csv_double(CsvWriter *writer, double value, int decimals) {
+    if (decimals < 0) decimals = 0;
+    if (decimals > 9) decimals = 9;
+
+    char *start = csv_reserve(writer, CSV_FIELD_RESERVE);
+    char *out = csv_separator(writer, start);
+    double scaled = fabs(value) * decimal_scale[decimals];
+
+    if (!isfinite(value) || scaled >= 9e15) {
+        out += snprintf(out, CSV_FIELD_RESERVE - 1, "%.17g", value);
+        writer->used += (size_t)(out - start);
+        return;
+    }
+
+    unsigned long long units = (unsigned long long)(scaled + 0.5);
+    unsigned long long scale = (unsigned long long)decimal_scale[decimals];
+    if (value < 0 && units != 0) *out++ = '-';
+
+    out = format_digits(out, units / scale);
+
+    if (decimals > 0) {
+        unsigned long long fraction = units % scale;
+        *out++ = '.';
+        for (int i = decimals - 1; i >= 0; i--) {
+            out[i] = (char)('0' + fraction % 10);
+            fraction /= 10;
+        }
+        out += decimals;
+    }
+    writer->used += (size_t)(out - start);
+}
+
+/**
+ * 结束当前行
+ */
+void csv_end_row(CsvWriter *writer) {
+    char *out = csv_reserve(writer, 1);
+    *out = '\n';
+    writer->used++;
+    writer->fields = 0;
+}
+
+/**
+ * 提交剩余数据并关闭文件
+ * @return 文件的字节数，写入失败返回-1
+ */
+long long csv_close(CsvWriter *writer) {
+    if (writer == NULL) return -1;
+
+    if (writer->current > 0 || writer->used > 0) {
+        csv_flush(writer, writer->current + 1, writer->used);
+    }
+    if (close(writer->fd) != 0) {
+        writer->failed = 1;
+    }
+
+    long long bytes = writer->failed ? -1 : (long long)writer->bytes;
+    free(writer->memory);
+    free(writer);
+    return bytes;
+}
+
+static int column_width(ColumnType type) {
+    switch (type) {
+        case COLUMN_INT32: return 4;
+        case COLUMN_INT64: return 8;
+        case COLUMN_FLOAT64: return 8;
+        case COLUMN_TEXT: return COLUMN_TEXT_WIDTH;
+    }
+    return 8;
+}
+
+static unsigned long long align8(unsigned long long value) {
+    return (value + 7) & ~7ULL;
+}
+
+/**
+ * 创建列式文件：预先算好布局、设置文件大小并映射到内存，调用者通过 column_data 直接填写各列。
+ * 写入临时文件，column_file_close 时改名，读取方不会看到写了一半的文件
+ * @param rows 行数
+ * @param names 各列名称
+ * @param types 各列类型
+ * @return 列式文件指针，失败返回NULL
+ */
+ColumnFile* column_file_create(const char *path, unsigned long long rows, const char *const *names,
+                               const ColumnType *types, int num_columns) {
+    ColumnFile *file = (ColumnFile*)calloc(1, sizeof(ColumnFile));
+    if (file == NULL) return NULL;
+
+    if (snprintf(file->path, sizeof(file->path), "%s", path) >= (int)sizeof(file->path) ||
+        snprintf(file->tmp_path, sizeof(file->tmp_path), "%s.tmp", path) >= (int)sizeof(file->tmp_path)) {
+        print_colored("导出路径过长: %s\n", RED, path);
+        free(file);
+        return NULL;
+    }
+
+    unsigned long long size = align8(sizeof(ColumnFileHeader) + sizeof(ColumnDesc) * (size_t)num_columns);
+    unsigned long long offsets[64];
+    if (num_columns <= 0 || num_columns > 64) {
+        free(file);
+        return NULL;
+    }
+    for (int c = 0; c < num_columns; c++) {
+        offsets[c] = size;
+        size = align8(size + rows * (unsigned long long)column_width(types[c]));
+    }
+
+    file->fd = open(file->tmp_path, O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (file->fd < 0) {
+        perror("无法创建导出文件");
+        free(file);
+        return NULL;
+    }
+    if (ftruncate(file->fd, (off_t)size) != 0) {
+        perror("导出写入失败");
+        close(file->fd);
+        unlink(file->tmp_path);
+        free(file);
+        return NULL;
+    }
+    file->map = (char*)mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, file->fd, 0);
+    if (file->map == MAP_FAILED) {
+        perror("导出写入失败");
+        close(file->fd);
+        unlink(file->tmp_path);
+        free(file);
+        return NULL;
+    }
+    // 按顺序写入，提示内核尽早回写已写完的页面
+    madvise(file->map, size, MADV_SEQUENTIAL);
+    file->size = size;
+    file->num_columns = num_columns;
+
+    // ftruncate 得到的文件内容全为0，对齐填充和文本列的结尾无需另行清零
+    ColumnFileHeader *header = (ColumnFileHeader*)file->map;
+    memcpy(header->magic, COLUMN_MAGIC, sizeof(header->magic));
+    header->version = COLUMN_VERSION;
+    header->num_columns = num_columns;
+    header->rows = rows;
+    header->file_size = size;
+
+    file->columns = (ColumnDesc*)(file->map + sizeof(ColumnFileHeader));
+    for (int c = 0; c < num_columns; c++) {
+        snprintf(file->columns[c].name, sizeof(file->columns[c].name), "%s", names[c]);
+        file->columns[c].type = types[c];
+        file->columns[c].width = column_width(types[c]);
+        file->columns[c].offset = offsets[c];
+    }
+    return file;
+}
+
+/**
+ * 获取第 column 列数据的起始地址（映射的文件内容）
+ */
+void* column_data(ColumnFile *file, int column) {
+    return file->map + file->columns[column].offset;
+}
+
+/**
+ * 解除映射、关闭并改名为最终文件名
+ * @return 文件的字节数，失败返回-1
+ */
+long long column_file_close(ColumnFile *file) {
+    if (file == NULL) return -1;
+
+    long long size = (long long)file->size;
+    int failed = munmap(file->map, file->size) != 0;
+    if (close(file->fd) != 0) failed = 1;
+    if (!failed && rename(file->tmp_path, file->path) != 0) failed = 1;
+    if (failed) {
+        perror("导出写入失败");
+        unlink(file->tmp_path);
+        size = -1;
+    }
+    free(file);
+    return size;
+}
+
+/**
+ * 导出账户表为CSV：account_id,balance,history_size
+ */
+long long export_accounts_csv(const char *path, Account **accounts, int count) {
+    CsvWriter *writer = csv_open(path);
+    if (writer == NULL) return -1;
+
+    csv_text(writer, "account_id");
+    csv_text(writer, "balance");
+    csv_text(writer, "history_size");
+    csv_end_row(writer);
+    for (int i = 0; i < count; i++) {
+        csv_int(writer, accounts[i]->account_id);
+        csv_double(writer, accounts[i]->balance, 2);
+        csv_int(writer, accounts[i]->history_size);
+        csv_end_row(writer);
+    }
+    return csv_close(writer);
+}
+
+/**
+ * 导出账户表为列式文件，列与CSV相同
+ */
+long long export_accounts_columns(const char *path, Account **accounts, int count) {
+    static const char *const names[] = { "account_id", "balance", "history_size" };
+    static const ColumnType types[] = { COLUMN_INT32, COLUMN_FLOAT64, COLUMN_INT32 };
+
+    ColumnFile *file = column_file_create(path, (unsigned long long)count, names, types, 3);
+    if (file == NULL) return -1;
+
+    int *ids = (int*)column_data(file, 0);
+    double *balances = (double*)column_data(file, 1);
+    int *sizes = (int*)column_data(file, 2);
+    for (int i = 0; i < count; i++) {
+        ids[i] = accounts[i]->account_id;
+        balances[i] = accounts[i]->balance;
+        sizes[i] = accounts[i]->history_size;
+    }
+    return column_file_close(file);
+}
+
+/**
+ * 导出所有账户的余额历史为CSV：account_id,seq,balance，每条历史记录一行
+ */
+long long export_histories_csv(const char *path, Account **accounts, int count) {
+    CsvWriter *writer = csv_open(path);
+    if (writer == NULL) return -1;
+
+    csv_text(writer, "account_id");
+    csv_text(writer, "seq");
+    csv_text(writer, "balance");
+    csv_end_row(writer);
+    for (int i = 0; i < count; i++) {
+        const Account *account = accounts[i];
+        for (int k = 0; k < account->history_size; k++) {
+            csv_int(writer, account->account_id);
+            csv_int(writer, k);
+            csv_double(writer, account->history[k], 2);
+            csv_end_row(writer);
+        }
+    }
+    return csv_close(writer);
+}
+
+/**
+ * 导出所有账户的余额历史为列式文件；余额列由每个账户的历史数组整段复制
+ */
+long long export_histories_columns(const char *path, Account **accounts, int count) {
+    static const char *const names[] = { "account_id", "seq", "balance" };
+    static const ColumnType types[] = { COLUMN_INT32, COLUMN_INT32, COLUMN_FLOAT64 };
+
+    unsigned long long rows = 0;
+    for (int i = 0; i < count; i++) {
+        rows += (unsigned long long)accounts[i]->history_size;
+    }
+
+    ColumnFile *file = column_file_create(path, rows, names, types, 3);
+    if (file == NULL) return -1;
+
+    int *ids = (int*)column_data(file, 0);
+    int *seqs = (int*)column_data(file, 1);
+    double *balances = (double*)column_data(file, 2);
+    unsigned long long row = 0;
+    for (int i = 0; i < count; i++) {
+        const Account *account = accounts[i];
+        memcpy(balances + row, account->history, sizeof(double) * (size_t)account->history_size);
+        for (int k = 0; k < account->history_size; k++) {
+            ids[row + k] = account->account_id;
+            seqs[row + k] = k;
+        }
+        row += (unsigned long long)account->history_size;
+    }
+    return column_file_close(file);
+}
+
+/**
+ * 导出每个进程的调度统计为CSV，字段与 calculate_statistics 的表格相同，另加优先级、开始时间和调度次数
+ */
+long long export_processes_csv(const char *path, const PCB *processes, int count) {
+    static const char *const header[] = {
+        "pid", "name", "priority", "arrive", "service", "start", "completion",
+        "turnaround", "weighted_turnaround", "waiting", "response", "dispatches"
+    };
+
+    CsvWriter *writer = csv_open(path);
+    if (writer == NULL) return -1;
+
+    for (size_t c = 0; c < sizeof(header) / sizeof(header[0]); c++) {
+        csv_text(writer, header[c]);
+    }
+    csv_end_row(writer);
+
+    for (int i = 0; i < count; i++) {
+        const PCB *p = &processes[i];
+        csv_int(writer, p->pid);
+        csv_text(writer, p->name);
+        csv_int(writer, p->priority);
+        csv_int(writer, p->arrive_time);
+        csv_int(writer, p->service_time);
+        csv_int(writer, p->start_time);
+        csv_int(writer, p->completion_time);
+        csv_int(writer, p->turnaround_time);
+        csv_double(writer, p->weighted_turnaround, 3);
+        csv_int(writer, p->waiting_time);
+        csv_int(writer, (p->start_time >= 0) ? p->start_time - p->arrive_time : 0);
+        csv_int(writer, p->dispatch_count);
+        csv_end_row(writer);
+    }
+    return csv_close(writer);
+}
+
+/**
+ * 导出每个进程的调度统计为列式文件，列与CSV相同
+ */
+long long export_processes_columns(const char *path, const PCB *processes, int count) {
+    static const char *const names[] = {
+        "pid", "name", "priority", "arrive", "service", "start", "completion",
+        "turnaround", "weighted_turnaround", "waiting", "response", "dispatches"
+    };
+    static const ColumnType types[] = {
+        COLUMN_INT32, COLUMN_TEXT, COLUMN_INT32, COLUMN_INT32, COLUMN_INT32, COLUMN_INT32, COLUMN_INT32,
+        COLUMN_INT32, COLUMN_FLOAT64, COLUMN_INT32, COLUMN_INT32, COLUMN_INT32
+    };
+    const int num_columns = sizeof(names) / sizeof(names[0]);
+
+    ColumnFile *file = column_file_create(path, (unsigned long long)count, names, types, num_columns);
+    if (file == NULL) return -1;
+
+    int *pid = (int*)column_data(file, 0);
+    char *name = (char*)column_data(file, 1);
+    int *priority = (int*)column_data(file, 2);
+    int *arrive = (int*)column_data(file, 3);
+    int *service = (int*)column_data(file, 4);
+    int *start = (int*)column_data(file, 5);
+    int *completion = (int*)column_data(file, 6);
+    int *turnaround = (int*)column_data(file, 7);
+    double *weighted = (double*)column_data(file, 8);
+    int *waiting = (int*)column_data(file, 9);
+    int *response = (int*)column_data(file, 10);
+    int *dispatches = (int*)column_data(file, 11);
+
+    // 一列一列地写，每次只顺序写一个区域
+    for (int i = 0; i < count; i++) pid[i] = processes[i].pid;
+    for (int i = 0; i < count; i++) {
+        strncpy(name + (size_t)i * COLUMN_TEXT_WIDTH, processes[i].name, COLUMN_TEXT_WIDTH);
+    }
+    for (int i = 0; i < count; i++) priority[i] = processes[i].priority;
+    for (int i = 0; i < count; i++) arrive[i] = processes[i].arrive_time;
+    for (int i = 0; i < count; i++) service[i] = processes[i].service_time;
+    for (int i = 0; i < count; i++) start[i] = processes[i].start_time;
+    for (int i = 0; i < count; i++) completion[i] = processes[i].completion_time;
+    for (int i = 0; i < count; i++) turnaround[i] = processes[i].turnaround_time;
+    for (int i = 0; i < count; i++) weighted[i] = processes[i].weighted_turnaround;
+    for (int i = 0; i < count; i++) waiting[i] = processes[i].waiting_time;
+    for (int i = 0; i < count; i++) {
+        response[i] = (processes[i].start_time >= 0) ? processes[i].start_time - processes[i].arrive_time : 0;
+    }
+    for (int i = 0; i < count; i++) dispatches[i] = processes[i].dispatch_count;
+
+    return column_file_close(file);
+}
@@ -0,0 +1,85 @@
+#ifndef EXPORT_H
+#define EXPORT_H
+
+#include <stddef.h>
+#include <sys/uio.h>
+#include "account.h"
+#include "process_control.h"
+
+#define COLUMN_MAGIC "SCHEDCOL"
+#define COLUMN_VERSION 1
+#define COLUMN_TEXT_WIDTH 32        // 文本列的定长字节数，不足时以0填充
+#define EXPORT_BUFFER_SIZE (1 << 20) // CSV 每块缓冲区 1 MiB
+#define EXPORT_BUFFERS 8            // 写满这么多块后一次 writev 提交
+
+// 列式文件布局（本机字节序，可直接 mmap 后按偏移读取）：
+//   ColumnFileHeader | ColumnDesc[num_columns] | 第0列的 rows 个值 | 第1列 ... 每列起点按8字节对齐
+
+typedef enum {
+    COLUMN_INT32,
+    COLUMN_INT64,
+    COLUMN_FLOAT64,
+    COLUMN_TEXT                 // COLUMN_TEXT_WIDTH 字节的定长文本
+} ColumnType;
+
+typedef struct {
+    char magic[8];
+    int version;
+    int num_columns;
+    unsigned long long rows;
+    unsigned long long file_size;
+} ColumnFileHeader;
+
+typedef struct {
+    char name[24];
+    int type;                   // ColumnType
+    int width;                  // 每个值占用的字节数
+    unsigned long long offset;  // 该列数据在文件中的偏移
+} ColumnDesc;
+
+// 正在写入的列式文件：数据直接写进映射的页面，不经过用户态缓冲
+typedef struct {
+    int fd;
+    char *map;
+    size_t size;
+    int num_columns;
+    ColumnDesc *columns;
+    char path[4096];
+    char tmp_path[4096];
+} ColumnFile;
+
+// CSV 写入器：格式化到一组大缓冲区，写满后用一次 writev 提交，缓冲区反复使用
+typedef struct {
+    int fd;
+    char *memory;               // EXPORT_BUFFERS 块缓冲区的一次分配
+    struct iovec iov[EXPORT_BUFFERS];
+    int current;                // 正在填充的块
+    size_t used;                // 当前块已用字节数
+    int fields;                 // 当前行已写的字段数
+    unsigned long long bytes;   // 已提交的字节数
+    int failed;
+} CsvWriter;
+
+// CSV 写入函数
+CsvWriter* csv_open(const char *path);
+void csv_text(CsvWriter *writer, const char *text);
+void csv_int(CsvWriter *writer, long long value);
+void csv_double(CsvWriter *writer, double value, int decimals);
+void csv_end_row(CsvWriter *writer);
+long long csv_close(CsvWriter *writer);
+
+// 列式文件函数
+ColumnFile* column_file_create(const char *path, unsigned long long rows, const char *const *names,
+                               const ColumnType *types, int num_columns);
+void* column_data(ColumnFile *file, int column);
+long long column_file_close(ColumnFile *file);
+
+// 数据导出函数，返回写入的字节数，失败返回-1
+long long export_accounts_csv(const char *path, Account **accounts, int count);
+long long export_accounts_columns(const char *path, Account **accounts, int count);
+long long export_histories_csv(const char *path, Account **accounts, int count);
+long long export_histories_columns(const char *path, Account **accounts, int count);
+long long export_processes_csv(const char *path, const PCB *processes, int count);
+long long export_processes_columns(const char *path, const PCB *processes, int count);
+
+#endif // EXPORT_H
@@ -0,0 +1,117 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "fairness.h"
+#include "process_control.h"
+#include "simulator.h"
+#include "timeutil.h"
+#include "visualization.h"
+
+/**
+ * 公平性实验命令行入口：所有进程在时刻0到达且在截止时刻前都不会完成，
+ * 比较 RR 与 CFS 在截止时刻的 vruntime 分布与每次调度决策的开销
+ * @return 进程退出码
+ */
+int fairness_main(int argc, char *argv[]) {
+    int count = 100000;
+    unsigned int seed = 1;
+    int horizon = 0;
+    SchedConfig configs[2] = {
+        { .algorithm = ALGO_RR, .time_quantum = 1 },
+        { .algorithm = ALGO_CFS, .min_granularity = 1, .target_latency = 24 }
+    };
+
+    for (int i = 1; i < argc; i += 2) {
+        const char *opt = argv[i];
+        const char *value = (i + 1 < argc) ? argv[i + 1] : NULL;
+
+        if (value == NULL || opt[0] != '-' || opt[1] == '\0' || opt[2] != '\0') {
+            print_colored("用法: %s fairness [-n 数量] [-s 种子] [-t 截止时刻] [-q RR时间片] "
+                         "[-M CFS最小时间片] [-L CFS调度周期]\n", YELLOW, argv[0]);
+            return 1;
+        }
+
+        switch (opt[1]) {
+            case 'n': count = atoi(value); break;
+            case 's': seed = (unsigned int)strtoul(value, NULL, 10); break;
+            case 't': horizon = atoi(value); break;
+            case 'q': configs[0].time_quantum = atoi(value); break;
+            case 'M': configs[1].min_granularity = atoi(value); break;
+            case 'L': configs[1].target_latency = atoi(value); break;
+            default:
+                print_colored("未知选项: %s\n", RED, opt);
+                return 1;
+        }
+    }
+    if (count <= 0) {
+        print_colored("进程数量必须大于0\n", RED);
+        return 1;
+    }
+    if (horizon <= 0) {
+        horizon = count * 10;  // 平均每个进程约运行10个时间单位
+    }
+
+    // 全部进程同时就绪，服务时间足够长，截止时刻前都处于可运行状态
+    PCB *workload = generate_workload(count, seed);
+    PCB *processes = (PCB*)malloc(sizeof(PCB) * count);
+    if (workload == NULL || processes == NULL) {
+        free(workload);
+        free(processes);
+        return 1;
+    }
+    for (int i = 0; i < count; i++) {
+        workload[i].arrive_time = 0;
+        workload[i].service_time = horizon + 1;
+        workload[i].remaining_time = horizon + 1;
+    }
+
+    print_colored("公平性实验: %d 个可运行进程, 截止时刻 %d\n", CYAN, count, horizon);
+    print_colored("----------------------------------------------------------------------------------\n", WHITE);
+    print_colored("| %-6s | %-10s | %-8s | %-14s | %-14s | %-8s |\n", WHITE,
+                 "算法", "决策次数", "ns/决策", "vruntime极差", "vruntime标准差", "耗时ms");
+    print_colored("----------------------------------------------------------------------------------\n", WHITE);
+
+    int was_quiet = is_quiet_mode();
+    for (int k = 0; k < 2; k++) {
+        memcpy(processes, workload, sizeof(PCB) * count);
+        configs[k].time_limit = horizon;
+
+        set_quiet_mode(1);
+        double start = now_ms();
+        int result = run_simulation(processes, count, &configs[k]);
+        double elapsed = now_ms() - start;
+        set_quiet_mode(was_quiet);
+
+        if (result < 0) {
+            print_colored("| %-6s | 模拟失败\n", RED, sched_algorithm_name(configs[k].algorithm));
+            continue;
+        }
+
+        // vruntime 以 1/NICE_0_LOAD 时间单位计，换算为时间单位输出
+        long long decisions = 0;
+        long long min_v = processes[0].vruntime, max_v = processes[0].vruntime;
+        double sum = 0.0, sum_sq = 0.0;
+        for (int i = 0; i < count; i++) {
+            long long v = processes[i].vruntime;
+            decisions += processes[i].dispatch_count;
+            if (v < min_v) min_v = v;
+            if (v > max_v) max_v = v;
+            sum += (double)v / NICE_0_LOAD;
+            sum_sq += ((double)v / NICE_0_LOAD) * ((double)v / NICE_0_LOAD);
+        }
+        double mean = sum / count;
+        double variance = sum_sq / count - mean * mean;
+
+        print_colored("| %-6s | %-10lld | %-8.1f | %-14.2f | %-14.2f | %-8.1f |\n", WHITE,
+                     sched_algorithm_name(configs[k].algorithm), decisions,
+                     decisions > 0 ? elapsed * 1e6 / decisions : 0.0,
+                     (double)(max_v - min_v) / NICE_0_LOAD,
+                     variance > 0 ? sqrt(variance) : 0.0, elapsed);
+    }
+    print_colored("----------------------------------------------------------------------------------\n", WHITE);
+
+    free(processes);
+    free(workload);
+    return 0;
+}
@@ -0,0 +1,7 @@
+#ifndef FAIRNESS_H
+#define FAIRNESS_H
+
+// 公平性实验命令行入口：RR 与 CFS 在所有进程同时可运行时的 vruntime 分布
+int fairness_main(int argc, char *argv[]);
+
+#endif // FAIRNESS_H
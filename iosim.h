@@ -0,0 +1,7 @@
+#ifndef IOSIM_H
+#define IOSIM_H
+
+// I/O实验命令行入口：CPU/I/O交替的工作负载上各调度算法的CPU利用率与I/O重叠
+int io_main(int argc, char *argv[]);
+
+#endif // IOSIM_H
@@ -0,0 +1,486 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <time.h>
+#include <unistd.h>
+#include "account.h"
+#include "timeutil.h"
+#include "visualization.h"
+
+// 账户操作基准测试：create_account、deposit、withdraw、record_balance_history，
+// 以及无竞争、双账户竞争、热点账户三种转账，在不同线程数下测量 ns/op 和扩展效率。
+// 每个线程按批计时，只累计批内的时间；批与批之间做不计时的清理
+
+#ifndef CACHE_LINE_SIZE
+#define CACHE_LINE_SIZE 64
+#endif
+
+#define LEDGER_MAX_THREADS 64
+#define LEDGER_MAX_RESULTS 256
+#define LEDGER_BATCH 256            // 每批计时的操作数
+#define LEDGER_HISTORY_LIMIT 4096   // 历史记录超过此长度时清空，避免长时间运行耗尽内存
+#define LEDGER_HOT_ACCOUNTS 64      // 热点转账的账户数，其中账户0参与90%的转账
+#define LEDGER_BALANCE 1e12         // 初始余额足够大，取款和转账不会因余额不足失败
+#define LEDGER_TABLE_RULE "----------------------------------------------------------------------------------------------------"
+
+typedef enum {
+    LEDGER_CREATE,
+    LEDGER_DEPOSIT,
+    LEDGER_WITHDRAW,
+    LEDGER_HISTORY,
+    LEDGER_TRANSFER,            // 每个线程在自己的两个账户之间转账
+    LEDGER_CONTENDED,           // 所有线程在同两个账户之间转账
+    LEDGER_HOTSPOT,             // 所有线程在64个账户之间转账，账户0参与90%
+    LEDGER_CASES
+} LedgerCase;
+
+static const char *case_names[LEDGER_CASES] = {
+    "account.create",
+    "account.deposit",
+    "account.withdraw",
+    "account.history",
+    "transfer.uncontended",
+    "transfer.contended",
+    "transfer.hotspot"
+};
+
+// 一个测量点的结果
+typedef struct {
+    char name[32];              // 基准名称，如 transfer.hotspot
+    int threads;
+    double ns_per_op;           // 单个线程看到的平均每次操作耗时
+    double mops;                // 所有线程合计每秒百万次操作
+    double efficiency;          // 相对最少线程数的扩展效率，1.0 为线性扩展
+} LedgerResult;
+
+// 所有工作线程共享的运行状态
+typedef struct {
+    LedgerCase bench;
+    Account **shared;           // 竞争和热点转账共用的账户
+    int num_shared;
+    pthread_mutex_t start_lock;  // 启动门：go 置位前工作线程都等在 start_cond 上
+    pthread_cond_t start_cond;
+    int go;
+    atomic_int stop;
+} LedgerRun;
+
+// 每个工作线程独占一个缓存行起始的槽位，计时结果互不干扰
+typedef struct {
+    _Alignas(CACHE_LINE_SIZE) LedgerRun *run;
+    int index;
+    unsigned int seed;
+    Account *own[2];            // 线程私有的账户
+    long long ns;
+    long long ops;
+} LedgerWorker;
+
+// 历史记录过长时清空（持有账户锁，转账可能正在写同一个账户的历史）
+static void trim_history(Account *account) {
+    pthread_mutex_lock(&account->mutex);
+    if (account->history_size > LEDGER_HISTORY_LIMIT) {
+        account->history_size = 0;
+    }
+    pthread_mutex_unlock(&account->mutex);
+}
+
+// 热点转账：90%的转账一方为账户0，方向随机
+static void pick_hotspot(LedgerWorker *worker, int *from, int *to) {
+    int n = worker->run->num_shared;
+    int other = 1 + (int)(rand_r(&worker->seed) % (unsigned int)(n - 1));
+    int first = (rand_r(&worker->seed) % 10 < 9) ? 0 : 1 + (int)(rand_r(&worker->seed) % (unsigned int)(n - 1));
+    if (first == other) other = (other % (n - 1)) + 1;
+    if (rand_r(&worker->seed) & 1) {
+        *from = first;
+        *to = other;
+    } else {
+        *from = other;
+        *to = first;
+    }
+}
+
+// 执行一批计时的操作
+static void run_batch(LedgerWorker *worker) {
+    LedgerRun *run = worker->run;
+    Account *a = worker->own[0];
+    Account *b = worker->own[1];
+
+    switch (run->bench) {
+        case LEDGER_CREATE: {
+            Account *batch[LEDGER_BATCH];
+            long long t0 = now_ns();
+            for (int i = 0; i < LEDGER_BATCH; i++) {
+                batch[i] = create_account(worker->index * LEDGER_BATCH + i, 100.0);
+            }
+            worker->ns += now_ns() - t0;
+            for (int i = 0; i < LEDGER_BATCH; i++) {
+                destroy_account(batch[i]);
+            }
+            break;
+        }
+        case LEDGER_DEPOSIT: {
+            long long t0 = now_ns();
+            for (int i = 0; i < LEDGER_BATCH; i++) {
+                deposit(a, 1.0);
+            }
+            worker->ns += now_ns() - t0;
+            trim_history(a);
+            break;
+        }
+        case LEDGER_WITHDRAW: {
+            long long t0 = now_ns();
+            for (int i = 0; i < LEDGER_BATCH; i++) {
+                withdraw(a, 1.0);
+            }
+            worker->ns += now_ns() - t0;
+            trim_history(a);
+            break;
+        }
+        case LEDGER_HISTORY: {
+            long long t0 = now_ns();
+            for (int i = 0; i < LEDGER_BATCH; i++) {
+                record_balance_history(a);
+            }
+            worker->ns += now_ns() - t0;
+            trim_history(a);
+            break;
+        }
+        case LEDGER_TRANSFER: {
+            long long t0 = now_ns();
+            for (int i = 0; i < LEDGER_BATCH; i++) {
+                if (i & 1) {
+                    transfer(a, b, 1.0);
+                } else {
+                    transfer(b, a, 1.0);
+                }
+            }
+            worker->ns += now_ns() - t0;
+            trim_history(a);
+            trim_history(b);
+            break;
+        }
+        case LEDGER_CONTENDED: {
+            long long t0 = now_ns();
+            for (int i = 0; i < LEDGER_BATCH; i++) {
+                int from = rand_r(&worker->seed) & 1;
+                transfer(run->shared[from], run->shared[1 - from], 1.0);
+            }
+            worker->ns += now_ns() - t0;
+            break;
+        }
+        case LEDGER_HOTSPOT: {
+            long long t0 = now_ns();
+            for (int i = 0; i < LEDGER_BATCH; i++) {
+                int from, to;
+                pick_hotspot(worker, &from, &to);
+                transfer(run->shared[from], run->shared[to], 1.0);
+            }
+            worker->ns += now_ns() - t0;
+            break;
+        }
+        case LEDGER_CASES:
+            break;
+    }
+    worker->ops += LEDGER_BATCH;
+}
+
+static void* ledger_worker(void *arg) {
+    LedgerWorker *worker = (LedgerWorker*)arg;
+    LedgerRun *run = worker->run;
+
+    pthread_mutex_lock(&run->start_lock);
+    while (!run->go) {
+        pthread_cond_wait(&run->start_cond, &run->start_lock);
+    }
+    pthread_mutex_unlock(&run->start_lock);
+    while (!atomic_load_explicit(&run->stop, memory_order_relaxed)) {
+        run_batch(worker);
+
+        // 共享账户由第一个线程负责清理历史
+        if (worker->index == 0 && (run->bench == LEDGER_CONTENDED || run->bench == LEDGER_HOTSPOT)) {
+            for (int i = 0; i < run->num_shared; i++) {
+                trim_history(run->shared[i]);
+            }
+        }
+    }
+    return NULL;
+}
+
+/**
+ * 用 threads 个线程运行一个基准 duration_ms 毫秒
+ * @return 成功返回0，失败返回-1
+ */
+static int run_case(LedgerCase bench, int threads, int duration_ms, LedgerResult *result) {
+    LedgerRun run;
+    LedgerWorker *workers = (LedgerWorker*)aligned_alloc(CACHE_LINE_SIZE, sizeof(LedgerWorker) * threads);
+    pthread_t ids[LEDGER_MAX_THREADS];
+    Account *shared[LEDGER_HOT_ACCOUNTS];
+    if (workers == NULL) return -1;
+
+    memset(&run, 0, sizeof(run));
+    memset(workers, 0, sizeof(LedgerWorker) * threads);
+    run.bench = bench;
+    run.shared = shared;
+    run.num_shared = bench == LEDGER_HOTSPOT ? LEDGER_HOT_ACCOUNTS : 2;
+    atomic_init(&run.stop, 0);
+    for (int i = 0; i < run.num_shared; i++) {
+        shared[i] = create_account(i + 1, LEDGER_BALANCE);
+    }
+    for (int t = 0; t < threads; t++) {
+        workers[t].run = &run;
+        workers[t].index = t;
+        workers[t].seed = 12345u + (unsigned int)t * 7919u;
+        workers[t].own[0] = create_account(1000 + 2 * t, LEDGER_BALANCE);
+        workers[t].own[1] = create_account(1001 + 2 * t, LEDGER_BALANCE);
+    }
+
+    pthread_mutex_init(&run.start_lock, NULL);
+    pthread_cond_init(&run.start_cond, NULL);
+    int started = 0;
+    for (int t = 0; t < threads; t++) {
+        if (pthread_create(&ids[t], NULL, ledger_worker, &workers[t]) != 0) break;
+        started++;
+    }
+
+    // 未能全部启动时先置停止标志，已启动的线程被放行后立即退出
+    int ok = started == threads;
+    if (!ok) {
+        print_colored("无法创建 %d 个线程\n", RED, threads);
+        atomic_store_explicit(&run.stop, 1, memory_order_relaxed);
+    }
+    pthread_mutex_lock(&run.start_lock);
+    run.go = 1;
+    pthread_cond_broadcast(&run.start_cond);
+    pthread_mutex_unlock(&run.start_lock);
+    if (ok) {
+        struct timespec pause = { duration_ms / 1000, (long)(duration_ms % 1000) * 1000000L };
+        nanosleep(&pause, NULL);
+    }
+    atomic_store_explicit(&run.stop, 1, memory_order_relaxed);
+    for (int t = 0; t < started; t++) {
+        pthread_join(ids[t], NULL);
+    }
+
+    // 每线程平均耗时取所有线程的 ns/ops，吞吐量把各线程的速率相加
+    double ns_sum = 0.0, rate = 0.0;
+    for (int t = 0; t < started; t++) {
+        if (workers[t].ops > 0 && workers[t].ns > 0) {
+            ns_sum += (double)workers[t].ns / workers[t].ops;
+            rate += workers[t].ops * 1e9 / workers[t].ns;
+        }
+    }
+    snprintf(result->name, sizeof(result->name), "%s", case_names[bench]);
+    result->threads = threads;
+    result->ns_per_op = started > 0 ? ns_sum / started : 0.0;
+    result->mops = rate / 1e6;
+    result->efficiency = 0.0;
+
+    pthread_cond_destroy(&run.start_cond);
+    pthread_mutex_destroy(&run.start_lock);
+    for (int t = 0; t < threads; t++) {
+        destroy_account(workers[t].own[0]);
+        destroy_account(workers[t].own[1]);
+    }
+    for (int i = 0; i < run.num_shared; i++) {
+        destroy_account(shared[i]);
+    }
+    free(workers);
+    return ok ? 0 : -1;
+}
+
+// 解析逗号分隔的线程数列表，返回个数，格式错误返回-1
+static int parse_threads(const char *text, int *values, int max_values) {
+    int n = 0;
+    char buffer[256];
+    snprintf(buffer, sizeof(buffer), "%s", text);
+
+    for (char *tok = strtok(buffer, ","); tok != NULL && n < max_values; tok = strtok(NULL, ",")) {
+        int v = atoi(tok);
+        if (v <= 0 || v > LEDGER_MAX_THREADS) return -1;
+        values[n++] = v;
+    }
+    return n > 0 ? n : -1;
+}
+
+// 读取基准文件，返回读到的条目数，文件不存在返回-1
+static int load_baseline(const char *path, LedgerResult *baseline, int max) {
+    FILE *file = fopen(path, "r");
+    if (file == NULL) return -1;
+
+    char line[256];
+    int n = 0;
+    while (n < max && fgets(line, sizeof(line), file) != NULL) {
+        if (line[0] == '#' || line[0] == '\n') continue;
+        LedgerResult *r = &baseline[n];
+        if (sscanf(line, "%31s %d %lf %lf %lf", r->name, &r->threads, &r->ns_per_op, &r->mops,
+                   &r->efficiency) == 5) {
+            n++;
+        }
+    }
+    fclose(file);
+    return n;
+}
+
+static int save_results(const char *path, const LedgerResult *results, int count) {
+    FILE *file = fopen(path, "w");
+    if (file == NULL) {
+        perror("无法写入基准文件");
+        return -1;
+    }
+
+    fprintf(file, "# 名称 线程数 ns/op Mops/s 扩展效率\n");
+    for (int i = 0; i < count; i++) {
+        fprintf(file, "%s %d %.3f %.4f %.4f\n", results[i].name, results[i].threads,
+                results[i].ns_per_op, results[i].mops, results[i].efficiency);
+    }
+    fclose(file);
+    return 0;
+}
+
+static const LedgerResult* find_baseline(const LedgerResult *baseline, int count, const LedgerResult *r) {
+    for (int i = 0; i < count; i++) {
+        if (baseline[i].threads == r->threads && strcmp(baseline[i].name, r->name) == 0) {
+            return &baseline[i];
+        }
+    }
+    return NULL;
+}
+
+/**
+ * 打印结果表并与基准比较
+ * @return 退化的测量点个数
+ */
+static int report(const LedgerResult *results, int count, const LedgerResult *baseline, int baseline_count,
+                  double threshold) {
+    int regressions = 0;
+
+    print_colored("%s\n", WHITE, LEDGER_TABLE_RULE);
+    print_colored("| %-20s | %-6s | %-10s | %-10s | %-8s | %-10s | %-12s |\n", WHITE,
+                 "基准", "线程", "ns/op", "Mops/s", "效率", "基准ns/op", "变化");
+    print_colored("%s\n", WHITE, LEDGER_TABLE_RULE);
+
+    for (int i = 0; i < count; i++) {
+        const LedgerResult *r = &results[i];
+        const LedgerResult *base = find_baseline(baseline, baseline_count, r);
+        char efficiency[16];
+        snprintf(efficiency, sizeof(efficiency), "%.0f%%", r->efficiency * 100);
+
+        if (base == NULL) {
+            print_colored("| %-20s | %-6d | %-10.1f | %-10.3f | %-8s | %-10s | %-12s |\n", WHITE,
+                         r->name, r->threads, r->ns_per_op, r->mops, efficiency, "-", "-");
+            continue;
+        }
+
+        double change = base->ns_per_op > 0 ? (r->ns_per_op / base->ns_per_op - 1.0) * 100 : 0.0;
+        int slower = change > threshold;
+        char verdict[32];
+        snprintf(verdict, sizeof(verdict), "%+.1f%%%s", change, slower ? " 退化" : "");
+
+        if (slower) regressions++;
+        print_colored("| %-20s | %-6d | %-10.1f | %-10.3f | %-8s | %-10.1f | %-12s |\n",
+                     slower ? RED : (change < -threshold ? GREEN : WHITE),
+                     r->name, r->threads, r->ns_per_op, r->mops, efficiency, base->ns_per_op, verdict);
+    }
+    print_colored("%s\n", WHITE, LEDGER_TABLE_RULE);
+    return regressions;
+}
+
+static void print_ledger_usage(const char *prog) {
+    print_colored("用法: %s [选项]\n", YELLOW, prog);
+    print_colored("  -j 列表    逗号分隔的线程数列表 (默认 1,2,4,8)\n", WHITE);
+    print_colored("  -d 毫秒    每个测量点的运行时间 (默认 200)\n", WHITE);
+    print_colored("  -b 文件    与该基准文件比较，出现退化时以状态码1退出\n", WHITE);
+    print_colored("  -o 文件    把本次结果写为新的基准文件\n", WHITE);
+    print_colored("  -t 百分比  ns/op 超过基准多少视为退化 (默认 10)\n", WHITE);
+}
+
+int main(int argc, char *argv[]) {
+    int threads[16] = {1, 2, 4, 8};
+    int num_threads = 4;
+    int duration_ms = 200;
+    const char *baseline_path = NULL;
+    const char *output_path = NULL;
+    double threshold = 10.0;
+
+    for (int i = 1; i < argc; i += 2) {
+        const char *opt = argv[i];
+        const char *value = (i + 1 < argc) ? argv[i + 1] : NULL;
+
+        if (value == NULL || opt[0] != '-' || opt[1] == '\0' || opt[2] != '\0') {
+            print_ledger_usage(argv[0]);
+            return 2;
+        }
+
+        switch (opt[1]) {
+            case 'j':
+                num_threads = parse_threads(value, threads, sizeof(threads) / sizeof(threads[0]));
+                if (num_threads < 0) {
+                    print_colored("无效的线程数列表: %s (每项 1~%d)\n", RED, value, LEDGER_MAX_THREADS);
+                    return 2;
+                }
+                break;
+            case 'd': duration_ms = atoi(value); break;
+            case 'b': baseline_path = value; break;
+            case 'o': output_path = value; break;
+            case 't': threshold = atof(value); break;
+            default:
+                print_ledger_usage(argv[0]);
+                return 2;
+        }
+    }
+    if (duration_ms <= 0) duration_ms = 200;
+
+    LedgerResult *results = (LedgerResult*)malloc(sizeof(LedgerResult) * LEDGER_MAX_RESULTS);
+    LedgerResult *baseline = (LedgerResult*)malloc(sizeof(LedgerResult) * LEDGER_MAX_RESULTS);
+    if (results == NULL || baseline == NULL) {
+        print_colored("内存不足\n", RED);
+        return 2;
+    }
+
+    print_colored("账户操作基准: %ld 个CPU, 每个测量点 %d ms (线程数超过CPU数时效率必然下降)\n", CYAN,
+                 sysconf(_SC_NPROCESSORS_ONLN), duration_ms);
+
+    int count = 0;
+    int failed = 0;
+    // 账户操作会逐条打印日志，测量期间静默
+    set_quiet_mode(1);
+    for (int c = 0; c < LEDGER_CASES; c++) {
+        int first = count;
+        for (int t = 0; t < num_threads && count < LEDGER_MAX_RESULTS; t++) {
+            if (run_case((LedgerCase)c, threads[t], duration_ms, &results[count]) != 0) {
+                failed = 1;
+                continue;
+            }
+            // 扩展效率 = 实际吞吐量 / (第一个线程数的吞吐量按线程数线性放大)
+            const LedgerResult *base = &results[first];
+            double expected = base->mops * results[count].threads / base->threads;
+            results[count].efficiency = expected > 0 ? results[count].mops / expected : 0.0;
+            count++;
+        }
+    }
+    set_quiet_mode(0);
+
+    int baseline_count = 0;
+    if (baseline_path != NULL) {
+        baseline_count = load_baseline(baseline_path, baseline, LEDGER_MAX_RESULTS);
+        if (baseline_count < 0) {
+            print_colored("基准文件 %s 不存在，只输出本次结果\n", YELLOW, baseline_path);
+            baseline_count = 0;
+        }
+    }
+
+    int regressions = report(results, count, baseline, baseline_count, threshold);
+    if (baseline_count > 0) {
+        print_colored("与 %s 比较: %d 项退化 (阈值 %.0f%%)\n", regressions > 0 ? RED : GREEN,
+                     baseline_path, regressions, threshold);
+    }
+    if (output_path != NULL && save_results(output_path, results, count) == 0) {
+        print_colored("结果已写入 %s\n", GREEN, output_path);
+    }
+
+    free(results);
+    free(baseline);
+    if (failed) return 2;
+    return regressions > 0 ? 1 : 0;
+}
@@ -0,0 +1,602 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <time.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include "metrics.h"
+#include "visualization.h"
+
+#define METRICS_REQUEST_SIZE 4096
+#define METRICS_IO_TIMEOUT 2        // 单个抓取连接的读写超时（秒）
+
+// 注册表：只有注册时加锁；指标一旦发布就不再移动或释放，抓取和更新都不加锁
+static Metric *registry[METRICS_MAX];
+static atomic_int num_metrics = 0;
+static pthread_mutex_t register_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+// 每个线程第一次更新指标时分到一个条带
+static atomic_int next_stripe = 0;
+static _Thread_local int thread_stripe = -1;
+
+// HTTP 服务与定期写文件的状态
+static int listen_fd = -1;
+static char unix_path[sizeof(((struct sockaddr_un*)0)->sun_path)];
+static pthread_t server_thread;
+static int server_started = 0;
+
+static const char *dump_path = NULL;
+static int dump_interval = METRICS_DEFAULT_INTERVAL;
+static pthread_t dump_thread;
+static int dump_started = 0;
+static int dump_running = 0;
+static pthread_mutex_t dump_mutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t dump_cond = PTHREAD_COND_INITIALIZER;
+
+static int linger_seconds = 0;
+
+static double bits_to_double(unsigned long long bits) {
+    double value;
+    memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+static unsigned long long double_to_bits(double value) {
+    unsigned long long bits;
+    memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+// 以CAS循环把 delta 加到保存 double 位模式的原子变量上
+static void atomic_add_double(atomic_ullong *target, double delta) {
+    unsigned long long old = atomic_load_explicit(target, memory_order_relaxed);
+    while (!atomic_compare_exchange_weak_explicit(target, &old, double_to_bits(bits_to_double(old) + delta),
+                                                  memory_order_relaxed, memory_order_relaxed));
+}
+
+static MetricStripe* current_stripe(Metric *metric) {
+    if (thread_stripe < 0) {
+        thread_stripe = atomic_fetch_add_explicit(&next_stripe, 1, memory_order_relaxed) % METRIC_STRIPES;
+    }
+    return &metric->stripes[thread_stripe];
+}
+
+// 查找或注册一个指标；同名指标必须类型相同
+static Metric* register_metric(const char *name, const char *help, const char *labels, MetricType type,
+                               const double *bounds, int num_bounds) {
+    if (labels == NULL) labels = "";
+    if (num_bounds > METRIC_MAX_BUCKETS) num_bounds = METRIC_MAX_BUCKETS;
+
+    pthread_mutex_lock(&register_mutex);
+    int count = atomic_load_explicit(&num_metrics, memory_order_relaxed);
+    for (int i = 0; i < count; i++) {
+        if (strcmp(registry[i]->name, name) == 0 && strcmp(registry[i]->labels, labels) == 0) {
+            Metric *found = registry[i]->type == type ? registry[i] : NULL;
+            pthread_mutex_unlock(&register_mutex);
+            return found;
+        }
+    }
+    if (count >= METRICS_MAX) {
+        pthread_mutex_unlock(&register_mutex);
+        return NULL;
+    }
+
+    Metric *metric = (Metric*)calloc(1, sizeof(Metric));
+    if (metric == NULL) {
+        pthread_mutex_unlock(&register_mutex);
+        return NULL;
+    }
+    snprintf(metric->name, sizeof(metric->name), "%s", name);
+    snprintf(metric->help, sizeof(metric->help), "%s", help);
+    snprintf(metric->labels, sizeof(metric->labels), "%s", labels);
+    metric->type = type;
+    atomic_init(&metric->gauge, double_to_bits(0.0));
+
+    if (type != METRIC_GAUGE) {
+        metric->stripes = (MetricStripe*)aligned_alloc(CACHE_LINE_SIZE, sizeof(MetricStripe) * METRIC_STRIPES);
+        if (metric->stripes == NULL) {
+            free(metric);
+            pthread_mutex_unlock(&register_mutex);
+            return NULL;
+        }
+        for (int s = 0; s < METRIC_STRIPES; s++) {
+            for (int b = 0; b <= METRIC_MAX_BUCKETS; b++) {
+                atomic_init(&metric->stripes[s].buckets[b], 0);
+            }
+            atomic_init(&metric->stripes[s].count, 0);
+            atomic_init(&metric->stripes[s].sum, double_to_bits(0.0));
+        }
+    }
+    if (type == METRIC_HISTOGRAM) {
+        memcpy(metric->bounds, bounds, sizeof(double) * num_bounds);
+        metric->num_bounds = num_bounds;
+    }
+
+    // 先写好指标再发布，抓取线程读到新的数量时一定看到完整的指标
+    registry[count] = metric;
+    atomic_store_explicit(&num_metrics, count + 1, memory_order_release);
+    pthread_mutex_unlock(&register_mutex);
+    return metric;
+}
+
+/**
+ * 注册计数器（只增不减）
+ * @param labels 标签，如 result="ok"，可以为NULL
+ * @return 指标指针，注册表已满或同名指标类型不同时返回NULL
+ */
+Metric* metrics_counter(const char *name, const char *help, const char *labels) {
+    return register_metric(name, help, labels, METRIC_COUNTER, NULL, 0);
+}
+
+/**
+ * 注册量表（可任意设置的当前值）
+ * @return 指标指针，失败返回NULL
+ */
+Metric* metrics_gauge(const char *name, const char *help, const char *labels) {
+    return register_metric(name, help, labels, METRIC_GAUGE, NULL, 0);
+}
+
+/**
+ * 注册直方图
+ * @param bounds 各桶的上界，递增，最多 METRIC_MAX_BUCKETS 个
+ * @return 指标指针，失败返回NULL
+ */
+Metric* metrics_histogram(const char *name, const char *help, const char *labels,
+                          const double *bounds, int num_bounds) {
+    if (bounds == NULL || num_bounds <= 0) return NULL;
+    return register_metric(name, help, labels, METRIC_HISTOGRAM, bounds, num_bounds);
+}
+
+/**
+ * 计数器加 n
+ */
+void metric_inc(Metric *metric, unsigned long long n) {
+    if (metric == NULL) return;
+    atomic_fetch_add_explicit(&current_stripe(metric)->count, n, memory_order_relaxed);
+}
+
+/**
+ * 设置量表的值
+ */
+void metric_set(Metric *metric, double value) {
+    if (metric == NULL) return;
+    atomic_store_explicit(&metric->gauge, double_to_bits(value), memory_order_relaxed);
+}
+
+/**
+ * 量表加 delta（可以为负）
+ */
+void metric_add(Metric *metric, double delta) {
+    if (metric == NULL) return;
+    atomic_add_double(&metric->gauge, delta);
+}
+
+/**
+ * 直方图记录一个观测值
+ */
+void metric_observe(Metric *metric, double value) {
+    if (metric == NULL) return;
+
+    int bucket = 0;
+    while (bucket < metric->num_bounds && value > metric->bounds[bucket]) {
+        bucket++;
+    }
+    MetricStripe *stripe = current_stripe(metric);
+    atomic_fetch_add_explicit(&stripe->buckets[bucket], 1, memory_order_relaxed);
+    atomic_fetch_add_explicit(&stripe->count, 1, memory_order_relaxed);
+    atomic_add_double(&stripe->sum, value);
+}
+
+// 标签串前后加上花括号；extra 为附加的标签（直方图的 le），可以为NULL
+static void write_labels(FILE *out, const char *labels, const char *extra) {
+    if (labels[0] == '\0' && extra == NULL) return;
+    fputc('{', out);
+    fputs(labels, out);
+    if (extra != NULL) {
+        if (labels[0] != '\0') fputc(',', out);
+        fputs(extra, out);
+    }
+    fputc('}', out);
+}
+
+static void write_metric(FILE *out, const Metric *metric) {
+    if (metric->type == METRIC_GAUGE) {
+        fputs(metric->name, out);
+        write_labels(out, metric->labels, NULL);
+        fprintf(out, " %.17g\n", bits_to_double(atomic_load_explicit(&metric->gauge, memory_order_relaxed)));
+        return;
+    }
+
+    unsigned long long buckets[METRIC_MAX_BUCKETS + 1] = {0};
+    unsigned long long count = 0;
+    double sum = 0.0;
+    for (int s = 0; s < METRIC_STRIPES; s++) {
+        const MetricStripe *stripe = &metric->stripes[s];
+        for (int b = 0; b <= metric->num_bounds; b++) {
+            buckets[b] += atomic_load_explicit(&stripe->buckets[b], memory_order_relaxed);
+        }
+        count += atomic_load_explicit(&stripe->count, memory_order_relaxed);
+        sum += bits_to_double(atomic_load_explicit(&stripe->sum, memory_order_relaxed));
+    }
+
+    if (metric->type == METRIC_COUNTER) {
+        fputs(metric->name, out);
+        write_labels(out, metric->labels, NULL);
+        fprintf(out, " %llu\n", count);
+        return;
+    }
+
+    // 直方图的桶是累积的；各个计数分别读取，count 取桶的总和以保证 +Inf 桶与 _count 一致
+    unsigned long long cumulative = 0;
+    char le[48];
+    for (int b = 0; b <= metric->num_bounds; b++) {
+        cumulative += buckets[b];
+        if (b < metric->num_bounds) {
+            snprintf(le, sizeof(le), "le=\"%g\"", metric->bounds[b]);
+        } else {
+            snprintf(le, sizeof(le), "le=\"+Inf\"");
+        }
+        fprintf(out, "%s_bucket", metric->name);
+        write_labels(out, metric->labels, le);
+        fprintf(out, " %llu\n", cumulative);
+    }
+    fprintf(out, "%s_sum", metric->name);
+    write_labels(out, metric->labels, NULL);
+    fprintf(out, " %.17g\n", sum);
+    fprintf(out, "%s_count", metric->name);
+    write_labels(out, metric->labels, NULL);
+    fprintf(out, " %llu\n", cumulative);
+}
+
+/**
+ * 以 Prometheus 文本格式 (0.0.4) 输出所有指标，同名指标归为一组，只输出一次 HELP 和 TYPE
+ * @return 成功返回0，写入失败返回-1
+ */
+int metrics_write(FILE *out) {
+    static const char *type_names[] = { "counter", "gauge", "histogram" };
+    int count = atomic_load_explicit(&num_metrics, memory_order_acquire);
+
+    for (int i = 0; i < count; i++) {
+        int first = 1;
+        for (int k = 0; k < i; k++) {
+            if (strcmp(registry[k]->name, registry[i]->name) == 0) {
+                first = 0;
+                break;
+            }
+        }
+        if (!first) continue;
+
+        fprintf(out, "# HELP %s %s\n", registry[i]->name, registry[i]->help);
+        fprintf(out, "# TYPE %s %s\n", registry[i]->name, type_names[registry[i]->type]);
+        for (int j = i; j < count; j++) {
+            if (strcmp(registry[j]->name, registry[i]->name) == 0) {
+                write_metric(out, registry[j]);
+            }
+        }
+    }
+    return ferror(out) ? -1 : 0;
+}
+
+// 写完整个缓冲区，对端关闭时不产生 SIGPIPE
+static int send_all(int fd, const char *data, size_t size) {
+    while (size > 0) {
+        ssize_t n = send(fd, data, size, MSG_NOSIGNAL);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) return -1;
+        data += n;
+        size -= (size_t)n;
+    }
+    return 0;
+}
+
+// 处理一个抓取连接：读取请求头，GET /metrics 或 GET / 返回全部指标
+static void serve_connection(int fd) {
+    struct timeval timeout = { METRICS_IO_TIMEOUT, 0 };
+    setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+    setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+
+    char request[METRICS_REQUEST_SIZE];
+    size_t length = 0;
+    while (length < sizeof(request) - 1) {
+        ssize_t n = recv(fd, request + length, sizeof(request) - 1 - length, 0);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) break;
+        length += (size_t)n;
+        request[length] = '\0';
+        if (strstr(request, "\r\n\r\n") != NULL || strstr(request, "\n\n") != NULL) break;
+    }
+    request[length] = '\0';
+
+    char *body = NULL;
+    size_t body_length = 0;
+    const char *status = "200 OK";
+    if (strncmp(request, "GET /metrics", 12) == 0 || strncmp(request, "GET / ", 6) == 0) {
+        FILE *out = open_memstream(&body, &body_length);
+        if (out == NULL) return;
+        metrics_write(out);
+        fclose(out);
+    } else {
+        status = strncmp(request, "GET ", 4) == 0 ? "404 Not Found" : "405 Method Not Allowed";
+    }
+
+    char header[256];
+    int header_length = snprintf(header, sizeof(header),
+                                 "HTTP/1.1 %s\r\n"
+                                 "Content-Type: text/plain; version=0.0.4; charset=utf-8\r\n"
+                                 "Content-Length: %zu\r\n"
+                                 "Connection: close\r\n\r\n",
+                                 status, body_length);
+    if (send_all(fd, header, (size_t)header_length) == 0 && body != NULL) {
+        send_all(fd, body, body_length);
+    }
+    free(body);
+}
+
+// 服务线程：逐个接受连接并应答，metrics_shutdown 关闭监听套接字后退出
+static void* server_main(void *arg) {
+    (void)arg;
+    while (1) {
+        int fd = accept(listen_fd, NULL, NULL);
+        if (fd < 0) {
+            if (errno == EINTR || errno == ECONNABORTED) continue;
+            break;
+        }
+        serve_connection(fd);
+        close(fd);
+    }
+    return NULL;
+}
+
+/**
+ * 解析监听/连接地址，指标服务和交易服务共用同一种格式
+ * @param address 端口号（127.0.0.1）、主机:端口，或 unix:路径
+ * @param storage 输出套接字地址
+ * @param length 输出地址长度
+ * @return 成功返回0，地址无效返回-1
+ */
+int parse_socket_address(const char *address, struct sockaddr_storage *storage, socklen_t *length) {
+    memset(storage, 0, sizeof(*storage));
+
+    if (strncmp(address, "unix:", 5) == 0) {
+        struct sockaddr_un *addr = (struct sockaddr_un*)storage;
+        addr->sun_family = AF_UNIX;
+        if (strlen(address + 5) >= sizeof(addr->sun_path)) {
+            print_colored("Unix 套接字路径过长: %s\n", RED, address + 5);
+            return -1;
+        }
+        strcpy(addr->sun_path, address + 5);
+        *length = sizeof(*addr);
+        return 0;
+    }
+
+    struct sockaddr_in *addr = (struct sockaddr_in*)storage;
+    addr->sin_family = AF_INET;
+    addr->sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+    const char *colon = strrchr(address, ':');
+    char host[64];
+    if (colon != NULL) {
+        snprintf(host, sizeof(host), "%.*s", (int)(colon - address), address);
+        if (inet_pton(AF_INET, host, &addr->sin_addr) != 1) {
+            print_colored("无效的地址: %s\n", RED, address);
+            return -1;
+        }
+    }
+    int port = atoi(colon != NULL ? colon + 1 : address);
+    if (port <= 0 || port > 65535) {
+        print_colored("无效的端口: %s\n", RED, address);
+        return -1;
+    }
+    addr->sin_port = htons((unsigned short)port);
+    *length = sizeof(*addr);
+    return 0;
+}
+
+/**
+ * 把套接字绑定到 parse_socket_address 解析出的地址。unix 路径上已有的套接字文件
+ * （上次运行留下的）先删除；路径是普通文件或目录时不删除，返回失败并把 errno 设为 EADDRINUSE
+ * @return 成功返回0，失败返回-1
+ */
+int bind_socket_address(int fd, const struct sockaddr_storage *storage, socklen_t length) {
+    if (storage->ss_family == AF_UNIX) {
+        const char *path = ((const struct sockaddr_un*)storage)->sun_path;
+        struct stat st;
+        if (lstat(path, &st) == 0) {
+            if (!S_ISSOCK(st.st_mode)) {
+                errno = EADDRINUSE;
+                return -1;
+            }
+            unlink(path);
+        }
+    } else {
+        int reuse = 1;
+        setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+    }
+    return bind(fd, (const struct sockaddr*)storage, length);
+}
+
+/**
+ * 在后台线程中提供 HTTP 抓取接口
+ * @param address 端口号（监听 127.0.0.1）、主机:端口，或 unix:路径
+ * @return 成功返回0，失败返回-1
+ */
+int metrics_serve(const char *address) {
+    if (address == NULL || server_started) return -1;
+
+    struct sockaddr_storage storage;
+    socklen_t length;
+    if (parse_socket_address(address, &storage, &length) != 0) return -1;
+
+    listen_fd = socket(storage.ss_family, SOCK_STREAM, 0);
+    if (listen_fd >= 0) {
+        if (bind_socket_address(listen_fd, &storage, length) != 0) {
+            close(listen_fd);
+            listen_fd = -1;
+        } else if (storage.ss_family == AF_UNIX) {
+            strcpy(unix_path, ((struct sockaddr_un*)&storage)->sun_path);
+        }
+    }
+
+    if (listen_fd < 0 || listen(listen_fd, 16) != 0) {
+        perror("启动指标服务失败");
+        if (listen_fd >= 0) close(listen_fd);
+        listen_fd = -1;
+        return -1;
+    }
+    if (pthread_create(&server_thread, NULL, server_main, NULL) != 0) {
+        close(listen_fd);
+        listen_fd = -1;
+        return -1;
+    }
+    server_started = 1;
+    print_colored("指标服务: %s/metrics\n", CYAN, address);
+    return 0;
+}
+
+// 先写临时文件再改名，读取方不会看到写了一半的文件
+static int dump_metrics(const char *path) {
+    char tmp[4096];
+    snprintf(tmp, sizeof(tmp), "%s.tmp", path);
+    FILE *out = fopen(tmp, "w");
+    if (out == NULL) return -1;
+
+    int result = metrics_write(out);
+    if (fclose(out) != 0) result = -1;
+    if (result == 0 && rename(tmp, path) != 0) result = -1;
+    if (result != 0) unlink(tmp);
+    return result;
+}
+
+static void* dump_main(void *arg) {
+    (void)arg;
+    pthread_mutex_lock(&dump_mutex);
+    while (dump_running) {
+        struct timespec deadline;
+        clock_gettime(CLOCK_REALTIME, &deadline);
+        deadline.tv_sec += dump_interval / 1000;
+        deadline.tv_nsec += (long)(dump_interval % 1000) * 1000000L;
+        deadline.tv_sec += deadline.tv_nsec / 1000000000L;
+        deadline.tv_nsec %= 1000000000L;
+
+        int rc = 0;
+        while (dump_running && rc != ETIMEDOUT) {
+            rc = pthread_cond_timedwait(&dump_cond, &dump_mutex, &deadline);
+        }
+        if (!dump_running) break;
+
+        pthread_mutex_unlock(&dump_mutex);
+        dump_metrics(dump_path);
+        pthread_mutex_lock(&dump_mutex);
+    }
+    pthread_mutex_unlock(&dump_mutex);
+    return NULL;
+}
+
+/**
+ * 在后台线程中每隔 interval_ms 毫秒把全部指标写到文件（可供 node_exporter 的 textfile 收集器读取），
+ * metrics_shutdown 时再写最后一次
+ * @return 成功返回0，失败返回-1
+ */
+int metrics_dump_periodically(const char *path, int interval_ms) {
+    if (path == NULL || dump_started) return -1;
+
+    dump_path = path;
+    dump_interval = interval_ms > 0 ? interval_ms : METRICS_DEFAULT_INTERVAL;
+    if (dump_metrics(dump_path) != 0) {
+        perror("写指标文件失败");
+        return -1;
+    }
+
+    dump_running = 1;
+    if (pthread_create(&dump_thread, NULL, dump_main, NULL) != 0) {
+        dump_running = 0;
+        return -1;
+    }
+    dump_started = 1;
+    return 0;
+}
+
+/**
+ * 打印指标导出选项
+ */
+void print_metrics_usage() {
+    print_colored("指标导出选项:\n", YELLOW);
+    print_colored("  -m 地址    提供 Prometheus 抓取接口: 端口、主机:端口 或 unix:路径\n", WHITE);
+    print_colored("  -o 文件    定期把指标写到文件\n", WHITE);
+    print_colored("  -i 毫秒    写文件的间隔 (默认 %d)\n", WHITE, METRICS_DEFAULT_INTERVAL);
+    print_colored("  -w 秒      程序结束前继续提供抓取接口的时间 (默认 0)\n", WHITE);
+}
+
+/**
+ * 解析命令行开头的指标导出选项并启动导出
+ * @return 解析掉的参数个数（不含程序名），出错返回-1
+ */
+int metrics_options(int argc, char *argv[]) {
+    const char *address = NULL;
+    const char *path = NULL;
+    int interval = METRICS_DEFAULT_INTERVAL;
+    int i = 1;
+
+    while (i + 1 < argc && argv[i][0] == '-' && argv[i][1] != '\0' && argv[i][2] == '\0' &&
+           strchr("moiw", argv[i][1]) != NULL) {
+        const char *value = argv[i + 1];
+        switch (argv[i][1]) {
+            case 'm': address = value; break;
+            case 'o': path = value; break;
+            case 'i': interval = atoi(value); break;
+            case 'w': linger_seconds = atoi(value); break;
+        }
+        i += 2;
+    }
+
+    if (address != NULL && metrics_serve(address) != 0) return -1;
+    if (path != NULL && metrics_dump_periodically(path, interval) != 0) return -1;
+    return i - 1;
+}
+
+/**
+ * 是否启用了指标导出
+ * @return 启用返回1，否则返回0
+ */
+int metrics_enabled() {
+    return server_started || dump_started;
+}
+
+/**
+ * 停止导出：按 -w 继续提供抓取接口一段时间，写最后一次指标文件，然后关闭服务
+ */
+void metrics_shutdown() {
+    if (server_started && linger_seconds > 0) {
+        print_colored("指标服务将在 %d 秒后关闭\n", YELLOW, linger_seconds);
+        sleep((unsigned int)linger_seconds);
+    }
+
+    if (dump_started) {
+        pthread_mutex_lock(&dump_mutex);
+        dump_running = 0;
+        pthread_cond_signal(&dump_cond);
+        pthread_mutex_unlock(&dump_mutex);
+        pthread_join(dump_thread, NULL);
+        dump_metrics(dump_path);
+        dump_started = 0;
+    }
+
+    if (server_started) {
+        // 关闭监听套接字使阻塞的 accept 返回
+        shutdown(listen_fd, SHUT_RDWR);
+        pthread_join(server_thread, NULL);
+        close(listen_fd);
+        listen_fd = -1;
+        if (unix_path[0] != '\0') {
+            unlink(unix_path);
+            unix_path[0] = '\0';
+        }
+        server_started = 0;
+    }
+}
@@ -0,0 +1,67 @@
+#ifndef METRICS_H
+#define METRICS_H
+
+#include <stdatomic.h>
+#include <stdio.h>
+#include <sys/socket.h>
+
+#ifndef CACHE_LINE_SIZE
+#define CACHE_LINE_SIZE 64
+#endif
+
+#define METRICS_MAX 256             // 注册表最多容纳的指标数（同名不同标签各算一个）
+#define METRIC_MAX_BUCKETS 16       // 直方图最多的桶数（不含 +Inf）
+#define METRIC_STRIPES 8            // 计数器和直方图的条带数
+#define METRICS_DEFAULT_INTERVAL 1000 // 定期写文件的默认间隔（毫秒）
+
+typedef enum {
+    METRIC_COUNTER,
+    METRIC_GAUGE,
+    METRIC_HISTOGRAM
+} MetricType;
+
+// 一个条带独占缓存行。每个线程固定使用一个条带，计数器只累加 count，
+// 直方图累加 buckets/count/sum；抓取时把所有条带相加，不需要任何锁
+typedef struct {
+    _Alignas(CACHE_LINE_SIZE) atomic_ullong buckets[METRIC_MAX_BUCKETS + 1];
+    atomic_ullong count;
+    atomic_ullong sum;          // double 的位模式，用CAS累加
+} MetricStripe;
+
+typedef struct {
+    char name[64];
+    char help[128];
+    char labels[64];            // 形如 algorithm="RR"，没有标签时为空串
+    MetricType type;
+    double bounds[METRIC_MAX_BUCKETS]; // 直方图各桶的上界，递增
+    int num_bounds;
+    atomic_ullong gauge;        // 量表的值（double 的位模式）
+    MetricStripe *stripes;      // 计数器和直方图使用，量表为NULL
+} Metric;
+
+// 指标注册函数（同名同标签的指标只注册一次，重复调用返回同一个指标）
+Metric* metrics_counter(const char *name, const char *help, const char *labels);
+Metric* metrics_gauge(const char *name, const char *help, const char *labels);
+Metric* metrics_histogram(const char *name, const char *help, const char *labels,
+                          const double *bounds, int num_bounds);
+
+// 指标更新函数（metric 为NULL时不做任何事，未启用导出时调用方持有的指针都是NULL）
+void metric_inc(Metric *metric, unsigned long long n);
+void metric_set(Metric *metric, double value);
+void metric_add(Metric *metric, double delta);
+void metric_observe(Metric *metric, double value);
+
+// 导出函数
+int metrics_write(FILE *out);
+int metrics_serve(const char *address);
+int metrics_dump_periodically(const char *path, int interval_ms);
+int metrics_options(int argc, char *argv[]);
+void print_metrics_usage();
+int metrics_enabled();
+void metrics_shutdown();
+
+// 地址解析与绑定函数：端口 / 主机:端口 / unix:路径（指标服务与交易服务共用）
+int parse_socket_address(const char *address, struct sockaddr_storage *storage, socklen_t *length);
+int bind_socket_address(int fd, const struct sockaddr_storage *storage, socklen_t length);
+
+#endif // METRICS_H
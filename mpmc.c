@@ -0,0 +1,471 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "mpmc.h"
+#include "process_control.h"
+#include "timeutil.h"
+#include "visualization.h"
+
+#define MPMC_MAX_THREADS 64
+#define MPMC_PCBS_PER_THREAD 64     // 每个线程持有的PCB数，总数即队列中最多的元素个数
+#define MPMC_TABLE_RULE "------------------------------------------------------------------------------------"
+
+/**
+ * 创建无锁就绪队列
+ * @param capacity 容量，向上取整为2的幂
+ * @return 新队列，失败返回NULL
+ */
+MpmcQueue* create_mpmc_queue(size_t capacity) {
+    size_t size = 2;
+    while (size < capacity) size <<= 1;
+
+    MpmcQueue *queue = (MpmcQueue*)aligned_alloc(CACHE_LINE_SIZE, sizeof(MpmcQueue));
+    if (queue == NULL) {
+        perror("无锁队列创建失败");
+        return NULL;
+    }
+    queue->cells = (MpmcCell*)malloc(sizeof(MpmcCell) * size);
+    if (queue->cells == NULL) {
+        perror("无锁队列创建失败");
+        free(queue);
+        return NULL;
+    }
+
+    // 槽位 i 最初供位置 i 的入队使用
+    for (size_t i = 0; i < size; i++) {
+        atomic_init(&queue->cells[i].sequence, i);
+        atomic_init(&queue->cells[i].process, NULL);
+    }
+    queue->mask = size - 1;
+    atomic_init(&queue->enqueue_pos, 0);
+    atomic_init(&queue->dequeue_pos, 0);
+    return queue;
+}
+
+/**
+ * 将进程放入队尾，可由多个线程同时调用
+ * @return 成功返回0，队列已满返回-1
+ */
+int mpmc_enqueue(MpmcQueue *queue, PCB *process) {
+    if (queue == NULL || process == NULL) return -1;
+
+    size_t pos = atomic_load_explicit(&queue->enqueue_pos, memory_order_relaxed);
+    MpmcCell *cell;
+
+    while (1) {
+        cell = &queue->cells[pos & queue->mask];
+        size_t seq = atomic_load_explicit(&cell->sequence, memory_order_acquire);
+        intptr_t diff = (intptr_t)seq - (intptr_t)pos;
+
+        if (diff == 0) {
+            // 槽位空闲，抢占该位置；失败时 pos 被更新为最新值
+            if (atomic_compare_exchange_weak_explicit(&queue->enqueue_pos, &pos, pos + 1,
+                                                      memory_order_relaxed, memory_order_relaxed)) {
+                break;
+            }
+        } else if (diff < 0) {
+            return -1;  // 槽位仍被上一轮的元素占用：队列已满
+        } else {
+            pos = atomic_load_explicit(&queue->enqueue_pos, memory_order_relaxed);
+        }
+    }
+
+    atomic_store_explicit(&cell->process, process, memory_order_relaxed);
+    atomic_store_explicit(&cell->sequence, pos + 1, memory_order_release);
+    return 0;
+}
+
+/**
+ * 从队头取出进程，可由多个线程同时调用
+ * @return 取出的进程，队列为空返回NULL
+ */
+PCB* mpmc_dequeue(MpmcQueue *queue) {
+    if (queue == NULL) return NULL;
+
+    size_t pos = atomic_load_explicit(&queue->dequeue_pos, memory_order_relaxed);
+    MpmcCell *cell;
+
+    while (1) {
+        cell = &queue->cells[pos & queue->mask];
+        size_t seq = atomic_load_explicit(&cell->sequence, memory_order_acquire);
+        intptr_t diff = (intptr_t)seq - (intptr_t)(pos + 1);
+
+        if (diff == 0) {
+            if (atomic_compare_exchange_weak_explicit(&queue->dequeue_pos, &pos, pos + 1,
+                                                      memory_order_relaxed, memory_order_relaxed)) {
+                break;
+            }
+        } else if (diff < 0) {
+            return NULL;  // 该位置尚未写入：队列为空
+        } else {
+            pos = atomic_load_explicit(&queue->dequeue_pos, memory_order_relaxed);
+        }
+    }
+
+    PCB *process = atomic_load_explicit(&cell->process, memory_order_relaxed);
+    // 槽位交还给下一轮 (pos + 容量) 的入队
+    atomic_store_explicit(&cell->sequence, pos + queue->mask + 1, memory_order_release);
+    return process;
+}
+
+/**
+ * 查看队头进程但不移除
+ * 并发使用时只是某一时刻的快照：返回后该进程可能已被其他线程取走
+ */
+PCB* mpmc_peek(MpmcQueue *queue) {
+    if (queue == NULL) return NULL;
+
+    while (1) {
+        size_t pos = atomic_load_explicit(&queue->dequeue_pos, memory_order_acquire);
+        MpmcCell *cell = &queue->cells[pos & queue->mask];
+        if (atomic_load_explicit(&cell->sequence, memory_order_acquire) != pos + 1) {
+            return NULL;
+        }
+        PCB *process = atomic_load_explicit(&cell->process, memory_order_relaxed);
+
+        // 读取期间槽位若被出队并交给下一轮入队，sequence 会变化，读到的可能是新一轮的进程，重读
+        atomic_thread_fence(memory_order_acquire);
+        if (atomic_load_explicit(&cell->sequence, memory_order_relaxed) == pos + 1) {
+            return process;
+        }
+    }
+}
+
+/**
+ * 队列中的元素个数（并发使用时为近似值）
+ */
+size_t mpmc_size(MpmcQueue *queue) {
+    size_t tail = atomic_load_explicit(&queue->enqueue_pos, memory_order_relaxed);
+    size_t head = atomic_load_explicit(&queue->dequeue_pos, memory_order_relaxed);
+    return tail > head ? tail - head : 0;
+}
+
+/**
+ * 销毁无锁队列，不释放其中的PCB
+ */
+void destroy_mpmc_queue(MpmcQueue *queue) {
+    if (queue == NULL) return;
+    free(queue->cells);
+    free(queue);
+}
+
+/**
+ * 创建加锁就绪队列
+ */
+LockedQueue* create_locked_queue() {
+    LockedQueue *queue = (LockedQueue*)malloc(sizeof(LockedQueue));
+    if (queue == NULL) {
+        perror("加锁队列创建失败");
+        return NULL;
+    }
+    queue->queue = create_queue();
+    if (queue->queue == NULL) {
+        free(queue);
+        return NULL;
+    }
+    pthread_mutex_init(&queue->lock, NULL);
+    return queue;
+}
+
+int locked_enqueue(LockedQueue *queue, PCB *process) {
+    if (queue == NULL || process == NULL) return -1;
+
+    pthread_mutex_lock(&queue->lock);
+    int result = enqueue(queue->queue, process);
+    pthread_mutex_unlock(&queue->lock);
+    return result;
+}
+
+PCB* locked_dequeue(LockedQueue *queue) {
+    if (queue == NULL) return NULL;
+
+    pthread_mutex_lock(&queue->lock);
+    PCB *process = dequeue(queue->queue);
+    pthread_mutex_unlock(&queue->lock);
+    return process;
+}
+
+PCB* locked_peek(LockedQueue *queue) {
+    if (queue == NULL) return NULL;
+
+    pthread_mutex_lock(&queue->lock);
+    PCB *process = peek_queue(queue->queue);
+    pthread_mutex_unlock(&queue->lock);
+    return process;
+}
+
+/**
+ * 销毁加锁队列，队列中剩余的PCB不属于队列，先取出再销毁
+ */
+void destroy_locked_queue(LockedQueue *queue) {
+    if (queue == NULL) return;
+
+    while (dequeue(queue->queue) != NULL);
+    destroy_queue(queue->queue);
+    pthread_mutex_destroy(&queue->lock);
+    free(queue);
+}
+
+// 启动门：go 置位前调度线程都等在 cond 上；stop 在放行前置位时线程不做任何操作直接退出
+typedef struct {
+    pthread_mutex_t lock;
+    pthread_cond_t cond;
+    int go;
+    int stop;
+} MpmcStartGate;
+
+// 基准中每个调度线程的参数
+typedef struct {
+    MpmcQueue *mpmc;            // 二者之一非NULL
+    LockedQueue *locked;
+    PCB **held;                 // 线程手中的PCB，容量为全部PCB数
+    int held_count;
+    long long iterations;
+    long long transfers;        // 成功出队的次数
+    long long empty_dequeues;   // 出队时队列为空的次数
+    MpmcStartGate *start;
+} MpmcWorker;
+
+// 调度线程：把手中的一个PCB放回队列，再取一个PCB，模拟同时从就绪队列取进程的调度器
+static void* mpmc_worker(void *arg) {
+    MpmcWorker *w = (MpmcWorker*)arg;
+    pthread_mutex_lock(&w->start->lock);
+    while (!w->start->go) {
+        pthread_cond_wait(&w->start->cond, &w->start->lock);
+    }
+    int stop = w->start->stop;
+    pthread_mutex_unlock(&w->start->lock);
+    if (stop) return NULL;
+
+    for (long long i = 0; i < w->iterations; i++) {
+        if (w->held_count > 0) {
+            PCB *p = w->held[--w->held_count];
+            int ok = w->mpmc != NULL ? mpmc_enqueue(w->mpmc, p) : locked_enqueue(w->locked, p);
+            if (ok != 0) w->held[w->held_count++] = p;
+        }
+
+        PCB *p = w->mpmc != NULL ? mpmc_dequeue(w->mpmc) : locked_dequeue(w->locked);
+        if (p != NULL) {
+            w->held[w->held_count++] = p;
+            w->transfers++;
+        } else {
+            w->empty_dequeues++;
+        }
+    }
+    return NULL;
+}
+
+/**
+ * 以 num_threads 个线程运行一轮基准
+ * @return 耗时（毫秒），失败返回负数；*transfers 为成功出队次数，*lost 为结束后找不到或重复出现的PCB数
+ */
+static double run_queue_bench(int use_mpmc, int num_threads, long long total_ops, PCB *pcbs,
+                              long long *transfers, long long *empty, int *lost) {
+    int total_pcbs = num_threads * MPMC_PCBS_PER_THREAD;
+    MpmcQueue *mpmc = use_mpmc ? create_mpmc_queue(total_pcbs) : NULL;
+    LockedQueue *locked = use_mpmc ? NULL : create_locked_queue();
+    MpmcWorker *workers = (MpmcWorker*)calloc(num_threads, sizeof(MpmcWorker));
+    pthread_t *threads = (pthread_t*)malloc(sizeof(pthread_t) * num_threads);
+    PCB **held = (PCB**)malloc(sizeof(PCB*) * total_pcbs * num_threads);
+    char *seen = (char*)calloc(total_pcbs, 1);
+
+    if ((mpmc == NULL && locked == NULL) || workers == NULL || threads == NULL || held == NULL ||
+        seen == NULL) {
+        destroy_mpmc_queue(mpmc);
+        destroy_locked_queue(locked);
+        free(workers);
+        free(threads);
+        free(held);
+        free(seen);
+        return -1.0;
+    }
+
+    MpmcStartGate start = { .go = 0, .stop = 0 };
+    pthread_mutex_init(&start.lock, NULL);
+    pthread_cond_init(&start.cond, NULL);
+
+    for (int t = 0; t < num_threads; t++) {
+        MpmcWorker *w = &workers[t];
+        w->mpmc = mpmc;
+        w->locked = locked;
+        w->held = held + (size_t)t * total_pcbs;
+        w->iterations = total_ops / num_threads;
+        w->start = &start;
+        for (int k = 0; k < MPMC_PCBS_PER_THREAD; k++) {
+            w->held[w->held_count++] = &pcbs[t * MPMC_PCBS_PER_THREAD + k];
+        }
+    }
+
+    int started = 0;
+    for (; started < num_threads; started++) {
+        if (pthread_create(&threads[started], NULL, mpmc_worker, &workers[started]) != 0) break;
+    }
+    // 未能创建全部线程时先置停止标志，已启动的线程被放行后立即退出
+    int ok = started == num_threads;
+    if (!ok) {
+        print_colored("无法创建 %d 个线程\n", RED, num_threads);
+    }
+
+    double begin = now_ms();
+    pthread_mutex_lock(&start.lock);
+    start.go = 1;
+    start.stop = !ok;
+    pthread_cond_broadcast(&start.cond);
+    pthread_mutex_unlock(&start.lock);
+    for (int t = 0; t < started; t++) {
+        pthread_join(threads[t], NULL);
+    }
+    double elapsed = now_ms() - begin;
+    pthread_cond_destroy(&start.cond);
+    pthread_mutex_destroy(&start.lock);
+
+    if (!ok) {
+        destroy_mpmc_queue(mpmc);
+        destroy_locked_queue(locked);
+        free(workers);
+        free(threads);
+        free(held);
+        free(seen);
+        return -1.0;
+    }
+
+    // 校验：线程手中与队列中的PCB合起来恰好是全部PCB，每个出现一次
+    *transfers = 0;
+    *empty = 0;
+    *lost = 0;
+    for (int t = 0; t < num_threads; t++) {
+        *transfers += workers[t].transfers;
+        *empty += workers[t].empty_dequeues;
+        for (int k = 0; k < workers[t].held_count; k++) {
+            seen[workers[t].held[k] - pcbs]++;
+        }
+    }
+    PCB *p;
+    while ((p = use_mpmc ? mpmc_dequeue(mpmc) : locked_dequeue(locked)) != NULL) {
+        seen[p - pcbs]++;
+    }
+    for (int i = 0; i < total_pcbs; i++) {
+        if (seen[i] != 1) (*lost)++;
+    }
+
+    destroy_mpmc_queue(mpmc);
+    destroy_locked_queue(locked);
+    free(workers);
+    free(threads);
+    free(held);
+    free(seen);
+    return elapsed;
+}
+
+static void print_mpmc_usage(const char *prog) {
+    print_colored("用法: %s mpmc [选项]\n", YELLOW, prog);
+    print_colored("  -n 次数    每轮的入队+出队总次数 (默认 4000000)\n", WHITE);
+    print_colored("  -t 线程    逗号分隔的线程数列表 (默认 1,2,4,8,16,32,64，最多 %d)\n", WHITE, MPMC_MAX_THREADS);
+}
+
+/**
+ * 并发就绪队列基准命令行入口：多个调度线程同时入队和出队，比较无锁队列与加锁 ProcessQueue
+ * @return 进程退出码
+ */
+int mpmc_main(int argc, char *argv[]) {
+    long long total_ops = 4000000;
+    int threads[16] = {1, 2, 4, 8, 16, 32, 64};
+    int num_counts = 7;
+
+    for (int i = 1; i < argc; i += 2) {
+        const char *opt = argv[i];
+        const char *value = (i + 1 < argc) ? argv[i + 1] : NULL;
+
+        if (value == NULL || opt[0] != '-' || opt[1] == '\0' || opt[2] != '\0') {
+            print_mpmc_usage(argv[0]);
+            return 1;
+        }
+
+        switch (opt[1]) {
+            case 'n': total_ops = atoll(value); break;
+            case 't': {
+                char buffer[256];
+                strncpy(buffer, value, sizeof(buffer) - 1);
+                buffer[sizeof(buffer) - 1] = '\0';
+                num_counts = 0;
+                for (char *tok = strtok(buffer, ","); tok != NULL && num_counts < 16; tok = strtok(NULL, ",")) {
+                    int t = atoi(tok);
+                    if (t >= 1 && t <= MPMC_MAX_THREADS) threads[num_counts++] = t;
+                }
+                break;
+            }
+            default:
+                print_mpmc_usage(argv[0]);
+                return 1;
+        }
+    }
+    if (num_counts == 0 || total_ops <= 0) {
+        print_mpmc_usage(argv[0]);
+        return 1;
+    }
+
+    PCB *pcbs = (PCB*)malloc(sizeof(PCB) * MPMC_MAX_THREADS * MPMC_PCBS_PER_THREAD);
+    if (pcbs == NULL) {
+        perror("内存分配失败");
+        return 1;
+    }
+    for (int i = 0; i < MPMC_MAX_THREADS * MPMC_PCBS_PER_THREAD; i++) {
+        char name[32];
+        snprintf(name, sizeof(name), "P%d", i + 1);
+        init_pcb(&pcbs[i], i + 1, name, 1, 0, 1);
+    }
+
+    print_colored("并发就绪队列基准: 每轮 %lld 次迭代（每次一个入队和一个出队），每线程持有 %d 个PCB\n", CYAN,
+                 total_ops, MPMC_PCBS_PER_THREAD);
+    print_colored("%s\n", WHITE, MPMC_TABLE_RULE);
+    print_colored("| %-6s | %-10s | %-12s | %-10s | %-10s | %-12s | %-6s |\n", WHITE,
+                 "线程", "队列", "百万出队/秒", "ns/出队", "空出队%", "相对加锁", "校验");
+    print_colored("%s\n", WHITE, MPMC_TABLE_RULE);
+
+    int was_quiet = is_quiet_mode();
+    int failed = 0;
+    for (int c = 0; c < num_counts; c++) {
+        // 先测加锁队列 (0) 再测无锁队列 (1)，两行一起打印
+        double elapsed[2];
+        long long transfers[2] = {0, 0};
+        long long empty[2] = {0, 0};
+        int lost[2] = {0, 0};
+        long long attempts = total_ops / threads[c] * threads[c];
+
+        set_quiet_mode(1);
+        for (int k = 0; k < 2; k++) {
+            elapsed[k] = run_queue_bench(k, threads[c], total_ops, pcbs, &transfers[k], &empty[k], &lost[k]);
+        }
+        set_quiet_mode(was_quiet);
+
+        // 吞吐量按成功出队计：出队落空很便宜，计入会夸大吞吐量
+        double rate[2];
+        for (int k = 0; k < 2; k++) {
+            rate[k] = elapsed[k] > 0 && transfers[k] > 0 ? transfers[k] / elapsed[k] / 1000.0 : 0.0;
+        }
+
+        for (int k = 0; k < 2; k++) {
+            if (elapsed[k] <= 0) {
+                print_colored("| %-6d | %-10s | 运行失败\n", RED, threads[c], k ? "MPMC无锁" : "互斥锁");
+                failed = 1;
+                continue;
+            }
+
+            char speedup[16] = "-";
+            if (k == 1 && rate[0] > 0) {
+                snprintf(speedup, sizeof(speedup), "%.2fx", rate[1] / rate[0]);
+            }
+            print_colored("| %-6d | %-10s | %-12.2f | %-10.1f | %-9.2f%% | %-12s | %-6s |\n",
+                         lost[k] > 0 ? RED : (k == 1 && rate[1] > rate[0] ? GREEN : WHITE),
+                         threads[c], k ? "MPMC无锁" : "互斥锁", rate[k],
+                         rate[k] > 0 ? 1000.0 / rate[k] : 0.0, empty[k] * 100.0 / attempts, speedup,
+                         lost[k] > 0 ? "失败" : "通过");
+            if (lost[k] > 0) failed = 1;
+        }
+    }
+    print_colored("%s\n", WHITE, MPMC_TABLE_RULE);
+
+    free(pcbs);
+    return failed;
+}
@@ -0,0 +1,53 @@
+#ifndef MPMC_H
+#define MPMC_H
+
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stddef.h>
+#include "process_control.h"
+
+#define CACHE_LINE_SIZE 64
+
+// 环形缓冲区的一个槽位：sequence 表示该槽位当前可供哪个位置的入队或出队使用。
+// process 也是原子的，因为 mpmc_peek 可能与下一轮入队同时读写同一个槽位
+typedef struct {
+    atomic_size_t sequence;
+    _Atomic(PCB *) process;
+} MpmcCell;
+
+// 有界多生产者多消费者就绪队列 (Vyukov)：入队和出队各自用一次CAS抢占位置，不加锁。
+// 入队位置和出队位置放在不同的缓存行上，避免生产者与消费者互相使缓存行失效。
+// 生产者抢到位置后、写入槽位前若被抢占，其后的元素暂时无法出队，消费者会看到队列为空。
+// 队列只保存PCB指针，不使用 PCB 的链表指针，因此同一个PCB在出队前不能再次入队
+typedef struct {
+    MpmcCell *cells;
+    size_t mask;                // 容量 - 1，容量为2的幂
+    _Alignas(CACHE_LINE_SIZE) atomic_size_t enqueue_pos;
+    _Alignas(CACHE_LINE_SIZE) atomic_size_t dequeue_pos;
+} MpmcQueue;
+
+// 用互斥锁保护的 ProcessQueue，作为基准对照
+typedef struct {
+    pthread_mutex_t lock;
+    ProcessQueue *queue;
+} LockedQueue;
+
+// 无锁就绪队列函数
+MpmcQueue* create_mpmc_queue(size_t capacity);
+int mpmc_enqueue(MpmcQueue *queue, PCB *process);
+PCB* mpmc_dequeue(MpmcQueue *queue);
+PCB* mpmc_peek(MpmcQueue *queue);
+size_t mpmc_size(MpmcQueue *queue);
+void destroy_mpmc_queue(MpmcQueue *queue);
+
+// 加锁就绪队列函数
+LockedQueue* create_locked_queue();
+int locked_enqueue(LockedQueue *queue, PCB *process);
+PCB* locked_dequeue(LockedQueue *queue);
+PCB* locked_peek(LockedQueue *queue);
+void destroy_locked_queue(LockedQueue *queue);
+
+// 并发就绪队列基准
+int mpmc_main(int argc, char *argv[]);
+
+#endif // MPMC_H
@@ -0,0 +1,429 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <limits.h>
+#include <time.h>
+#include "process_control.h"
+#include "simulator.h"
+#include "multicore.h"
+#include "timeutil.h"
+#include "visualization.h"
+
+// 汇总表与每核明细表各列的显示宽度，与数据行的格式一致
+static const int multicore_widths[] = {5, 9, 8, 8, 7, 9, 8, 8, 8, 6, 8, 8};
+static const int core_widths[] = {4, 7, 8, 8, 6, 6, 7};
+#define MULTICORE_COLUMNS (int)(sizeof(multicore_widths) / sizeof(multicore_widths[0]))
+#define CORE_COLUMNS (int)(sizeof(core_widths) / sizeof(core_widths[0]))
+
+// 单个核的运行状态
+typedef struct {
+    ProcessQueue *queue;        // 本核就绪队列
+    PCB *current;               // 正在运行的进程
+    int slice_end;              // 当前时间片结束时刻（含迁移开销）
+    int slice_run;              // 当前时间片中进程实际执行的时间
+} Core;
+
+static const char *balance_names[] = { "none", "steal", "migrate" };
+
+const char* balance_policy_name(BalancePolicy policy) {
+    if (policy < BALANCE_NONE || policy > BALANCE_MIGRATE) return "?";
+    return balance_names[policy];
+}
+
+// 将进程从 from 核迁移到 to 核，下次运行时付出迁移开销；入队失败返回-1
+static int migrate_process(Core *cores, CoreStats *stats, int *penalty, PCB *processes,
+                           int from, int to, const MulticoreConfig *config) {
+    PCB *p = dequeue_tail(cores[from].queue);
+    if (p == NULL) return 0;
+
+    penalty[p - processes] += config->migration_cost;
+    if (enqueue(cores[to].queue, p) != 0) return -1;
+    stats[from].migrations_out++;
+    stats[to].migrations_in++;
+    return 0;
+}
+
+// 工作窃取：每个空闲核从等待进程最多的核的队尾取一个进程
+static int steal_work(Core *cores, CoreStats *stats, int *penalty, PCB *processes,
+                      const MulticoreConfig *config) {
+    for (int c = 0; c < config->num_cpus; c++) {
+        if (cores[c].current != NULL || cores[c].queue->count > 0) continue;
+
+        int victim = -1;
+        int most = 0;
+        for (int v = 0; v < config->num_cpus; v++) {
+            // 空闲的核自己会运行队首进程，只有多余的进程才能被窃取
+            int spare = cores[v].queue->count - (cores[v].current == NULL ? 1 : 0);
+            if (spare > most) {
+                most = spare;
+                victim = v;
+            }
+        }
+        if (victim < 0) return 0;  // 没有可窃取的进程
+
+        if (migrate_process(cores, stats, penalty, processes, victim, c, config) != 0) return -1;
+    }
+    return 0;
+}
+
+// 周期性迁移：把进程从负载最重的核移到负载最轻的核，直到负载差不超过1
+static int rebalance(Core *cores, CoreStats *stats, int *penalty, PCB *processes,
+                     const MulticoreConfig *config) {
+    while (1) {
+        int busiest = 0, idlest = 0;
+        int max_load = -1, min_load = INT_MAX;
+
+        for (int c = 0; c < config->num_cpus; c++) {
+            int load = cores[c].queue->count + (cores[c].current != NULL ? 1 : 0);
+            if (load > max_load) { max_load = load; busiest = c; }
+            if (load < min_load) { min_load = load; idlest = c; }
+        }
+        if (max_load - min_load <= 1 || cores[busiest].queue->count == 0) return 0;
+
+        if (migrate_process(cores, stats, penalty, processes, busiest, idlest, config) != 0) return -1;
+    }
+}
+
+// 统计带I/O突发的进程数，多核模拟不处理设备阻塞
+static int count_io_processes(const PCB *processes, int count) {
+    int io = 0;
+    for (int i = 0; i < count; i++) {
+        if (processes[i].cpu_burst > 0) io++;
+    }
+    return io;
+}
+
+/**
+ * 运行多核调度模拟
+ * 每个核维护自己的RR就绪队列，新到达的进程轮流分配到各核，由负载均衡策略纠正不均衡。
+ * 只模拟纯CPU作业，带I/O突发 (cpu_burst > 0) 的工作负载返回失败
+ * @param processes 进程数组（会被修改）
+ * @param count 进程数量
+ * @param config 多核参数
+ * @param result 输出结果，result->cores 需由调用者释放
+ * @return 成功返回0，失败返回-1
+ */
+int run_multicore(PCB *processes, int count, const MulticoreConfig *config, MulticoreResult *result) {
+    if (processes == NULL || count <= 0 || config == NULL || result == NULL) return -1;
+    if (config->num_cpus < 1 || config->num_cpus > MAX_CPUS) return -1;
+    if (count_io_processes(processes, count) > 0) return -1;
+
+    int num_cpus = config->num_cpus;
+    int quantum = config->time_quantum > 0 ? config->time_quantum : 1;
+    int interval = config->balance_interval > 0 ? config->balance_interval : 1;
+
+    Core *cores = (Core*)calloc(num_cpus, sizeof(Core));
+    CoreStats *stats = (CoreStats*)calloc(num_cpus, sizeof(CoreStats));
+    int *penalty = (int*)calloc(count, sizeof(int));
+    int *order = sort_by_arrival(processes, count);
+    // 全零即为空的完成统计；calloc 只在实际写入的桶上占用内存
+    CompletionStats *completion = (CompletionStats*)calloc(num_cpus, sizeof(CompletionStats));
+    CompletionStats *merged = (CompletionStats*)calloc(1, sizeof(CompletionStats));
+    int ok = (cores != NULL && stats != NULL && penalty != NULL && order != NULL &&
+              completion != NULL && merged != NULL);
+
+    for (int c = 0; ok && c < num_cpus; c++) {
+        cores[c].queue = create_queue();
+        if (cores[c].queue == NULL) ok = 0;
+    }
+
+    int clock = 0;
+    int completed = 0;
+    int next_arrival = 0;
+    int next_core = 0;
+    int next_balance = interval;
+
+    while (ok && completed < count) {
+        // 时间片结束或进程完成
+        for (int c = 0; c < num_cpus; c++) {
+            Core *core = &cores[c];
+            if (core->current == NULL || core->slice_end > clock) continue;
+
+            PCB *p = core->current;
+            p->remaining_time -= core->slice_run;
+            if (p->remaining_time <= 0) {
+                record_completion(p, core->slice_end);
+                completion_stats_record(&completion[c], p);
+                completed++;
+            } else {
+                p->status = PROCESS_READY;
+                if (enqueue(core->queue, p) != 0) ok = 0;
+            }
+            core->current = NULL;
+        }
+
+        // 新到达的进程轮流分配到各核
+        while (next_arrival < count && processes[order[next_arrival]].arrive_time <= clock) {
+            if (enqueue(cores[next_core].queue, &processes[order[next_arrival++]]) != 0) ok = 0;
+            next_core = (next_core + 1) % num_cpus;
+        }
+
+        // 负载均衡
+        if (config->balance == BALANCE_STEAL) {
+            if (steal_work(cores, stats, penalty, processes, config) != 0) ok = 0;
+        } else if (config->balance == BALANCE_MIGRATE && clock >= next_balance) {
+            if (rebalance(cores, stats, penalty, processes, config) != 0) ok = 0;
+            next_balance = (clock / interval + 1) * interval;
+        }
+
+        // 空闲核从自己的队列调度下一个进程
+        int next_event = INT_MAX;
+        for (int c = 0; c < num_cpus; c++) {
+            Core *core = &cores[c];
+
+            if (core->current == NULL && core->queue->count > 0) {
+                PCB *p = dequeue(core->queue);
+                int idx = p - processes;
+
+                p->status = PROCESS_RUNNING;
+                if (p->start_time < 0) {
+                    p->start_time = clock;
+                }
+
+                core->current = p;
+                core->slice_run = (p->remaining_time < quantum) ? p->remaining_time : quantum;
+                core->slice_end = clock + penalty[idx] + core->slice_run;
+
+                stats[c].busy_time += core->slice_run;
+                stats[c].overhead_time += penalty[idx];
+                stats[c].dispatches++;
+                penalty[idx] = 0;
+            }
+
+            if (core->current != NULL && core->slice_end < next_event) {
+                next_event = core->slice_end;
+            }
+        }
+
+        // 时钟前进到下一个事件
+        if (next_arrival < count && processes[order[next_arrival]].arrive_time < next_event) {
+            next_event = processes[order[next_arrival]].arrive_time;
+        }
+        if (config->balance == BALANCE_MIGRATE && next_event != INT_MAX && next_balance < next_event) {
+            next_event = next_balance;
+        }
+        if (next_event == INT_MAX) break;
+        clock = next_event;
+    }
+
+    if (ok) {
+        long long max_busy = 0, min_busy = LLONG_MAX, total_busy = 0;
+
+        result->makespan = clock;
+        result->migrations = 0;
+        for (int c = 0; c < num_cpus; c++) {
+            total_busy += stats[c].busy_time;
+            if (stats[c].busy_time > max_busy) max_busy = stats[c].busy_time;
+            if (stats[c].busy_time < min_busy) min_busy = stats[c].busy_time;
+            result->migrations += stats[c].migrations_in;
+            stats[c].p99_waiting = hist_percentile(&completion[c].waiting, 0.99);
+            completion_stats_merge(merged, &completion[c]);
+        }
+
+        double span = clock > 0 ? (double)clock : 1.0;
+        double avg_busy = (double)total_busy / num_cpus;
+        result->avg_utilization = avg_busy / span;
+        result->min_utilization = min_busy / span;
+        result->max_utilization = max_busy / span;
+        result->imbalance = avg_busy > 0 ? (max_busy - min_busy) / avg_busy : 0.0;
+        result->cores = stats;
+        result->completion = merged;
+        stats = NULL;
+        merged = NULL;
+    }
+
+    // 队列中的进程属于调用者的数组，先取出再销毁队列
+    for (int c = 0; cores != NULL && c < num_cpus; c++) {
+        if (cores[c].queue == NULL) continue;
+        while (dequeue(cores[c].queue) != NULL);
+        destroy_queue(cores[c].queue);
+    }
+    free(cores);
+    free(stats);
+    free(completion);
+    free(merged);
+    free(penalty);
+    free(order);
+    return ok ? 0 : -1;
+}
+
+// 打印一次多核模拟的汇总行
+static void print_multicore_row(const MulticoreConfig *config, const MulticoreResult *result,
+                                double elapsed_ms) {
+    const CompletionStats *completion = result->completion;
+
+    print_colored("| %-5d | %-9d | %-8.1f | %-8.1f | %-7d | %-9d | %-7.1f%% | %-7.1f%% | %-7.1f%% | %-6.3f | %-8d | %-8.1f |\n",
+                 WHITE, config->num_cpus, result->makespan, hist_mean(&completion->turnaround),
+                 hist_mean(&completion->waiting), hist_percentile(&completion->waiting, 0.99),
+                 hist_percentile(&completion->waiting, 0.999), result->avg_utilization * 100,
+                 result->min_utilization * 100, result->max_utilization * 100, result->imbalance,
+                 result->migrations, elapsed_ms);
+}
+
+// 打印每个核的详细统计
+static void print_core_table(const MulticoreResult *result, int num_cpus) {
+    double span = result->makespan > 0 ? (double)result->makespan : 1.0;
+
+    print_colored("  ", WHITE);
+    print_table_row(WHITE, core_widths, CORE_COLUMNS, "核", "利用率", "迁移开销", "调度次数", "迁入", "迁出", "P99等待");
+    for (int c = 0; c < num_cpus; c++) {
+        const CoreStats *s = &result->cores[c];
+        print_colored("  | %-4d | %-6.1f%% | %-8lld | %-8d | %-6d | %-6d | %-7d |\n", WHITE,
+                     c, s->busy_time * 100 / span, s->overhead_time, s->dispatches,
+                     s->migrations_in, s->migrations_out, s->p99_waiting);
+    }
+}
+
+static void print_multicore_usage(const char *prog) {
+    print_colored("用法: %s multicore [选项]\n", YELLOW, prog);
+    print_colored("  -n 数量    生成的进程数量 (默认 100000)\n", WHITE);
+    print_colored("  -s 种子    随机种子 (默认 1)\n", WHITE);
+    print_colored("  -f 文件    从文件加载工作负载\n", WHITE);
+    print_colored("  -c 核数    逗号分隔的核数列表 (默认 8,16,32,64,128)\n", WHITE);
+    print_colored("  -q 片长    时间片大小 (默认 4)\n", WHITE);
+    print_colored("  -p 策略    负载均衡策略 none|steal|migrate (默认 steal)\n", WHITE);
+    print_colored("  -m 开销    每次迁移的开销 (默认 1)\n", WHITE);
+    print_colored("  -i 间隔    migrate 策略的均衡间隔 (默认 50)\n", WHITE);
+    print_colored("  -k 0|1     1 表示保持原到达时间；默认按核数压缩到达间隔，使每核负载不变\n", WHITE);
+}
+
+/**
+ * 多核调度命令行入口：对多个核数分别运行，输出扩展性表格
+ * @return 进程退出码
+ */
+int multicore_main(int argc, char *argv[]) {
+    int count = 100000;
+    unsigned int seed = 1;
+    const char *path = NULL;
+    int cpu_list[32] = {8, 16, 32, 64, 128};
+    int num_cpu_list = 5;
+    int keep_arrivals = 0;
+    MulticoreConfig config = { .time_quantum = 4, .balance = BALANCE_STEAL,
+                               .migration_cost = 1, .balance_interval = 50 };
+
+    for (int i = 1; i < argc; i += 2) {
+        const char *opt = argv[i];
+        const char *value = (i + 1 < argc) ? argv[i + 1] : NULL;
+
+        if (value == NULL || opt[0] != '-' || opt[1] == '\0' || opt[2] != '\0') {
+            print_multicore_usage(argv[0]);
+            return 1;
+        }
+
+        switch (opt[1]) {
+            case 'n': count = atoi(value); break;
+            case 's': seed = (unsigned int)strtoul(value, NULL, 10); break;
+            case 'f': path = value; break;
+            case 'q': config.time_quantum = atoi(value); break;
+            case 'm': config.migration_cost = atoi(value); break;
+            case 'i': config.balance_interval = atoi(value); break;
+            case 'k': keep_arrivals = atoi(value); break;
+            case 'c': {
+                char buffer[256];
+                strncpy(buffer, value, sizeof(buffer) - 1);
+                buffer[sizeof(buffer) - 1] = '\0';
+                num_cpu_list = 0;
+                for (char *tok = strtok(buffer, ","); tok != NULL && num_cpu_list < 32; tok = strtok(NULL, ",")) {
+                    int n = atoi(tok);
+                    if (n >= 1 && n <= MAX_CPUS) cpu_list[num_cpu_list++] = n;
+                }
+                if (num_cpu_list == 0) {
+                    print_colored("无效的核数列表: %s\n", RED, value);
+                    return 1;
+                }
+                break;
+            }
+            case 'p': {
+                int found = 0;
+                for (int b = BALANCE_NONE; b <= BALANCE_MIGRATE; b++) {
+                    if (strcasecmp(value, balance_names[b]) == 0) {
+                        config.balance = (BalancePolicy)b;
+                        found = 1;
+                    }
+                }
+                if (!found) {
+                    print_colored("未知负载均衡策略: %s\n", RED, value);
+                    return 1;
+                }
+                break;
+            }
+            default:
+                print_multicore_usage(argv[0]);
+                return 1;
+        }
+    }
+
+    PCB *workload;
+    if (path != NULL) {
+        workload = load_workload(path, &count);
+    } else if (count > 0) {
+        workload = generate_workload(count, seed);
+    } else {
+        print_colored("进程数量必须大于0\n", RED);
+        return 1;
+    }
+    if (workload == NULL) return 1;
+
+    int io_count = count_io_processes(workload, count);
+    if (io_count > 0) {
+        print_colored("工作负载中有 %d 个进程带I/O突发，多核模拟只支持纯CPU作业，请使用 io 子命令\n",
+                     RED, io_count);
+        free(workload);
+        return 1;
+    }
+
+    PCB *processes = (PCB*)malloc(sizeof(PCB) * count);
+    if (processes == NULL) {
+        free(workload);
+        return 1;
+    }
+
+    print_colored("工作负载: %d 个进程, 时间片: %d, 均衡策略: %s, 迁移开销: %d\n", CYAN,
+                 count, config.time_quantum, balance_policy_name(config.balance), config.migration_cost);
+    print_table_rule(WHITE, multicore_widths, MULTICORE_COLUMNS);
+    print_table_row(WHITE, multicore_widths, MULTICORE_COLUMNS, "核数", "完成时刻", "平均周转", "平均等待",
+                    "P99等待", "P99.9等待", "平均利用", "最低利用", "最高利用", "不均衡", "迁移次数", "耗时ms");
+    print_table_rule(WHITE, multicore_widths, MULTICORE_COLUMNS);
+
+    int status = 0;
+    for (int k = 0; k < num_cpu_list; k++) {
+        config.num_cpus = cpu_list[k];
+        memcpy(processes, workload, sizeof(PCB) * count);
+
+        // 默认按核数压缩到达时间，使每个核上的负载与单核实验相同
+        if (!keep_arrivals) {
+            for (int i = 0; i < count; i++) {
+                processes[i].arrive_time /= config.num_cpus;
+            }
+        }
+
+        MulticoreResult result;
+        double start = now_ms();
+
+        int was_quiet = is_quiet_mode();
+        set_quiet_mode(1);
+        int rc = run_multicore(processes, count, &config, &result);
+        set_quiet_mode(was_quiet);
+
+        double elapsed = now_ms() - start;
+
+        if (rc != 0) {
+            print_colored("| %-5d | 模拟失败\n", RED, config.num_cpus);
+            status = 1;
+            continue;
+        }
+
+        print_multicore_row(&config, &result, elapsed);
+        if (config.num_cpus <= 16 && num_cpu_list == 1) {
+            print_core_table(&result, config.num_cpus);
+        }
+        free(result.cores);
+        free(result.completion);
+    }
+    print_table_rule(WHITE, multicore_widths, MULTICORE_COLUMNS);
+
+    free(processes);
+    free(workload);
+    return status;
+}
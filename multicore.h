@@ -0,0 +1,52 @@
+#ifndef MULTICORE_H
+#define MULTICORE_H
+
+#include "process_control.h"
+#include "stats.h"
+
+#define MAX_CPUS 1024
+
+// 负载均衡策略
+typedef enum {
+    BALANCE_NONE,       // 不均衡，进程留在初始分配的核上
+    BALANCE_STEAL,      // 空闲核从最忙核的队尾窃取进程
+    BALANCE_MIGRATE     // 周期性地从最长队列向最短队列迁移
+} BalancePolicy;
+
+// 多核调度参数（每个核上运行RR）
+typedef struct {
+    int num_cpus;               // CPU核数
+    int time_quantum;           // 时间片大小
+    BalancePolicy balance;      // 负载均衡策略
+    int migration_cost;         // 进程迁移后首次运行前的额外开销（缓存预热）
+    int balance_interval;       // 周期性迁移的间隔 (BALANCE_MIGRATE)
+} MulticoreConfig;
+
+// 单个核的统计
+typedef struct {
+    long long busy_time;        // 执行进程的时间
+    long long overhead_time;    // 迁移开销时间
+    int dispatches;             // 调度次数
+    int migrations_in;          // 迁入进程数
+    int migrations_out;         // 迁出进程数
+    int p99_waiting;            // 在本核完成的进程的等待时间p99
+} CoreStats;
+
+// 多核模拟结果
+typedef struct {
+    int makespan;               // 所有进程完成的时刻
+    int migrations;             // 总迁移次数
+    double avg_utilization;     // 各核利用率
+    double min_utilization;
+    double max_utilization;
+    double imbalance;           // 不均衡度：(最大忙碌时间 - 最小忙碌时间) / 平均忙碌时间
+    CoreStats *cores;           // 每核统计，num_cpus 个，由调用者用 free() 释放
+    CompletionStats *completion; // 各核完成统计合并后的结果，由调用者用 free() 释放
+} MulticoreResult;
+
+// 多核调度函数
+int run_multicore(PCB *processes, int count, const MulticoreConfig *config, MulticoreResult *result);
+const char* balance_policy_name(BalancePolicy policy);
+int multicore_main(int argc, char *argv[]);
+
+#endif // MULTICORE_H
@@ -6,8 +6,12 @@
 #include <sys/wait.h>
 #include <time.h>
 #include "process_control.h"
+#include "spawn.h"
+#include "stats.h"
 #include "visualization.h"
 
+#define STATS_DETAIL_ROWS 50   // 统计表最多逐行列出的进程数
+
 // 全局变量
 static int next_pid = 1;
 static int current_time = 0;
@@ -34,11 +38,25 @@ PCB* create_process(char *name, int priority, int service_time) {
     new_process->turnaround_time = 0;
     new_process->weighted_turnaround = 0.0f;
     new_process->waiting_time = 0;
+    new_process->start_time = -1;
+    new_process->dispatch_count = 0;
+    new_process->vruntime = 0;
     new_process->next = NULL;
+    new_process->prev = NULL;
     
     print_colored("\n创建进程: PID=%d, 名称=%s, 优先级=%d, 服务时间=%d\n", 
                   GREEN, new_process->pid, name, priority, service_time);
     
+    // 进程池已启动时交给池中子进程，子进程都忙时排队等待而不是另外 fork
+    new_process->pool_ticket = 0;
+    pid_t pooled_pid = process_pool_submit(name, service_time, &new_process->pool_ticket);
+    if (pooled_pid > 0) {
+        new_process->unix_pid = pooled_pid;
+        print_colored("父进程: 作业交给预派生子进程[%d] 对应PCB PID=%d\n", 
+                      YELLOW, pooled_pid, new_process->pid);
+        return new_process;
+    }
+    
     // 创建实际进程
     pid_t child_pid = fork();
     
@@ -49,16 +67,7 @@ PCB* create_process(char *name, int priority, int service_time) {
         return NULL;
     } else if (child_pid == 0) {
         // 子进程代码
-        print_colored("子进程[%d] 启动, 模拟执行任务: %s\n", CYAN, getpid(), name);
-        
-        // 模拟进程执行
-        int sleep_time = service_time;
-        while (sleep_time > 0) {
-            print_colored("进程[%d] %s: 剩余执行时间 %d\n", CYAN, getpid(), name, sleep_time);
-            sleep(1);  // 模拟执行1秒
-            sleep_time--;
-        }
-        
+        run_process_task(name, service_time);
         print_colored("子进程[%d] %s 执行完成，退出\n", GREEN, getpid(), name);
         exit(0);  // 子进程完成并退出
     } else {
@@ -77,8 +86,11 @@ void terminate_process(PCB *process) {
     
     print_colored("\n终止进程: PID=%d, 名称=%s\n", YELLOW, process->pid, process->name);
     
-    // 等待子进程结束
-    if (process->unix_pid > 0) {
+    // 预派生子进程不会退出，只等待它完成当前作业
+    if (process->unix_pid > 0 && process_pool_wait(process->unix_pid, process->pool_ticket) == 0) {
+        print_colored("预派生子进程[%d]完成作业，返回进程池\n", GREEN, process->unix_pid);
+    } else if (process->unix_pid > 0) {
+        // 等待子进程结束
         int status;
         print_colored("等待子进程[%d]结束...\n", CYAN, process->unix_pid);
         pid_t result = waitpid(process->unix_pid, &status, 0);
@@ -99,6 +111,19 @@ void terminate_process(PCB *process) {
     print_colored("进程[%d] %s 已终止并回收资源\n", MAGENTA, process->pid, process->name);
 }
 
+// 子进程执行的任务：每秒输出一次剩余时间，共 service_time 秒（fork 的子进程和预派生子进程共用）
+void run_process_task(const char *name, int service_time) {
+    print_colored("子进程[%d] 启动, 模拟执行任务: %s\n", CYAN, getpid(), name);
+    
+    // 模拟进程执行
+    int sleep_time = service_time;
+    while (sleep_time > 0) {
+        print_colored("进程[%d] %s: 剩余执行时间 %d\n", CYAN, getpid(), name, sleep_time);
+        sleep(1);  // 模拟执行1秒
+        sleep_time--;
+    }
+}
+
 // 创建模拟进程（仅用于调度算法演示，不创建实际进程）
 PCB* create_simulated_process(char *name, int priority, int arrive_time, int service_time) {
     PCB *new_process = (PCB*)malloc(sizeof(PCB));
@@ -108,24 +133,127 @@ PCB* create_simulated_process(char *name, int priority, int arrive_time, int ser
     }
     
     // 初始化PCB
-    new_process->pid = next_pid++;
-    strncpy(new_process->name, name, sizeof(new_process->name) - 1);
-    new_process->name[sizeof(new_process->name) - 1] = '\0';
-    new_process->status = PROCESS_READY;
-    new_process->priority = priority;
-    new_process->arrive_time = arrive_time;
-    new_process->service_time = service_time;
-    new_process->remaining_time = service_time;
-    new_process->completion_time = 0;
-    new_process->turnaround_time = 0;
-    new_process->weighted_turnaround = 0.0f;
-    new_process->waiting_time = 0;
-    new_process->unix_pid = -1;  // 模拟进程没有真实UNIX PID
-    new_process->next = NULL;
+    init_pcb(new_process, next_pid++, name, priority, arrive_time, service_time);
     
     return new_process;
 }
 
+// 初始化模拟进程的PCB（不分配内存，可用于PCB数组）
+void init_pcb(PCB *process, int pid, const char *name, int priority, int arrive_time, int service_time) {
+    if (process == NULL) return;
+    
+    process->pid = pid;
+    strncpy(process->name, name, sizeof(process->name) - 1);
+    process->name[sizeof(process->name) - 1] = '\0';
+    process->status = PROCESS_READY;
+    process->priority = priority;
+    process->arrive_time = arrive_time;
+    process->service_time = service_time;
+    process->remaining_time = service_time;
+    process->deadline = 0;
+    process->cpu_burst = 0;
+    process->io_device = 0;
+    process->burst_left = 0;
+    process->io_time = 0;
+    process->completion_time = 0;
+    process->turnaround_time = 0;
+    process->weighted_turnaround = 0.0f;
+    process->waiting_time = 0;
+    process->start_time = -1;
+    process->dispatch_count = 0;
+    process->vruntime = 0;
+    process->unix_pid = -1;  // 模拟进程没有真实UNIX PID
+    process->pool_ticket = 0;
+    process->next = NULL;
+    process->prev = NULL;
+}
+
+// pid 在散列表中的起始槽位（Fibonacci 散列）
+static unsigned int index_home(const ProcessQueue *queue, int pid) {
+    return ((unsigned int)pid * 2654435761u) >> (32 - queue->index_bits);
+}
+
+// 查找 pid 所在槽位，不存在时返回 -1
+static int index_find(const ProcessQueue *queue, int pid) {
+    unsigned int mask = (1u << queue->index_bits) - 1;
+    unsigned int slot = index_home(queue, pid);
+
+    while (queue->index[slot] != NULL) {
+        if (queue->index[slot]->pid == pid) return (int)slot;
+        slot = (slot + 1) & mask;
+    }
+    return -1;
+}
+
+static void index_insert(ProcessQueue *queue, PCB *process) {
+    unsigned int mask = (1u << queue->index_bits) - 1;
+    unsigned int slot = index_home(queue, process->pid);
+
+    while (queue->index[slot] != NULL) {
+        slot = (slot + 1) & mask;
+    }
+    queue->index[slot] = process;
+}
+
+// 删除槽位后把后续探测链上的元素前移，保持线性探测不需要墓碑
+static void index_erase(ProcessQueue *queue, int slot) {
+    unsigned int mask = (1u << queue->index_bits) - 1;
+    unsigned int hole = (unsigned int)slot;
+    unsigned int next = hole;
+
+    queue->index[hole] = NULL;
+    while (1) {
+        next = (next + 1) & mask;
+        if (queue->index[next] == NULL) break;
+
+        // home 落在 (hole, next] 之间的元素留在原处，否则移入空位
+        unsigned int home = index_home(queue, queue->index[next]->pid);
+        int stays = (hole <= next) ? (hole < home && home <= next) : (hole < home || home <= next);
+        if (!stays) {
+            queue->index[hole] = queue->index[next];
+            queue->index[next] = NULL;
+            hole = next;
+        }
+    }
+}
+
+// 装载因子超过 3/4 时容量翻倍，沿链表重建散列表
+static int index_grow(ProcessQueue *queue) {
+    int bits = queue->index_bits + 1;
+    PCB **table = (PCB**)calloc((size_t)1 << bits, sizeof(PCB*));
+    if (table == NULL) {
+        perror("队列索引扩容失败");
+        return -1;
+    }
+
+    free(queue->index);
+    queue->index = table;
+    queue->index_bits = bits;
+    for (PCB *p = queue->head; p != NULL; p = p->next) {
+        index_insert(queue, p);
+    }
+    return 0;
+}
+
+// 把进程从链表和索引中摘下
+static void queue_unlink(ProcessQueue *queue, PCB *process, int slot) {
+    if (process->prev != NULL) {
+        process->prev->next = process->next;
+    } else {
+        queue->head = process->next;
+    }
+    if (process->next != NULL) {
+        process->next->prev = process->prev;
+    } else {
+        queue->tail = process->prev;
+    }
+
+    process->next = NULL;
+    process->prev = NULL;
+    index_erase(queue, slot);
+    queue->count--;
+}
+
 // 创建队列
 ProcessQueue* create_queue() {
     ProcessQueue *queue = (ProcessQueue*)malloc(sizeof(ProcessQueue));
@@ -137,26 +265,43 @@ ProcessQueue* create_queue() {
     queue->head = NULL;
     queue->tail = NULL;
     queue->count = 0;
+    queue->index_bits = QUEUE_INDEX_MIN_BITS;
+    queue->index = (PCB**)calloc((size_t)1 << QUEUE_INDEX_MIN_BITS, sizeof(PCB*));
+    if (queue->index == NULL) {
+        perror("队列创建失败");
+        free(queue);
+        return NULL;
+    }
     
     return queue;
 }
 
 // 将进程添加到队列末尾
-void enqueue(ProcessQueue *queue, PCB *process) {
-    if (queue == NULL || process == NULL) return;
+int enqueue(ProcessQueue *queue, PCB *process) {
+    if (queue == NULL || process == NULL) return -1;
+    
+    // 装载因子保持在 3/4 以下；扩容失败时只要还有空槽就继续插入
+    if ((long long)(queue->count + 1) * 4 > (3LL << queue->index_bits)) {
+        if (index_grow(queue) < 0 && queue->count + 1 >= (1 << queue->index_bits)) {
+            perror("进程入队失败");
+            return -1;
+        }
+    }
     
     process->next = NULL;
+    process->prev = queue->tail;
     
     if (queue->head == NULL) {
         queue->head = process;
-        queue->tail = process;
     } else {
         queue->tail->next = process;
-        queue->tail = process;
     }
+    queue->tail = process;
+    index_insert(queue, process);
     
     queue->count++;
     print_colored("进程[%d] %s 加入队列\n", BLUE, process->pid, process->name);
+    return 0;
 }
 
 // 从队列头取出进程
@@ -164,16 +309,20 @@ PCB* dequeue(ProcessQueue *queue) {
     if (queue == NULL || queue->head == NULL) return NULL;
     
     PCB *process = queue->head;
-    queue->head = process->next;
+    queue_unlink(queue, process, index_find(queue, process->pid));
     
-    if (queue->head == NULL) {
-        queue->tail = NULL;
-    }
+    print_colored("进程[%d] %s 离开队列\n", BLUE, process->pid, process->name);
+    return process;
+}
+
+// 从队列尾取出进程（用于多核调度中的工作窃取）
+PCB* dequeue_tail(ProcessQueue *queue) {
+    if (queue == NULL || queue->tail == NULL) return NULL;
     
-    process->next = NULL;
-    queue->count--;
+    PCB *process = queue->tail;
+    queue_unlink(queue, process, index_find(queue, process->pid));
     
-    print_colored("进程[%d] %s 离开队列\n", BLUE, process->pid, process->name);
+    print_colored("进程[%d] %s 从队尾离开队列\n", BLUE, process->pid, process->name);
     return process;
 }
 
@@ -183,40 +332,51 @@ PCB* peek_queue(ProcessQueue *queue) {
     return queue->head;
 }
 
+// 按pid查找队列中的进程，不在队列中时返回NULL
+PCB* find_process(ProcessQueue *queue, int pid) {
+    if (queue == NULL) return NULL;
+    
+    int slot = index_find(queue, pid);
+    return slot < 0 ? NULL : queue->index[slot];
+}
+
 // 从队列中移除特定进程
 void remove_process(ProcessQueue *queue, int pid) {
-    if (queue == NULL || queue->head == NULL) return;
+    if (queue == NULL) return;
     
-    PCB *current = queue->head;
-    PCB *previous = NULL;
+    int slot = index_find(queue, pid);
+    if (slot < 0) return;
     
-    // 如果是队列头
-    if (current->pid == pid) {
-        queue->head = current->next;
-        if (queue->head == NULL) {
-            queue->tail = NULL;
+    PCB *process = queue->index[slot];
+    queue_unlink(queue, process, slot);
+    print_colored("进程[%d] %s 从队列中移除\n", BLUE, process->pid, process->name);
+}
+
+// 把特定进程移到队尾，返回是否找到该进程
+int move_to_tail(ProcessQueue *queue, int pid) {
+    if (queue == NULL) return 0;
+    
+    int slot = index_find(queue, pid);
+    if (slot < 0) return 0;
+    
+    PCB *process = queue->index[slot];
+    if (process != queue->tail) {
+        // 只调整链表指针，索引中的槽位不变
+        if (process->prev != NULL) {
+            process->prev->next = process->next;
+        } else {
+            queue->head = process->next;
         }
-        queue->count--;
-        print_colored("进程[%d] %s 从队列中移除\n", BLUE, current->pid, current->name);
-        return;
-    }
-    
-    // 搜索队列
-    while (current != NULL && current->pid != pid) {
-        previous = current;
-        current = current->next;
+        process->next->prev = process->prev;
+        
+        process->prev = queue->tail;
+        process->next = NULL;
+        queue->tail->next = process;
+        queue->tail = process;
     }
     
-    // 如果找到了进程
-    if (current != NULL) {
-        previous->next = current->next;
-        if (current->next == NULL) {
-            queue->tail = previous;
-        }
-        current->next = NULL;
-        queue->count--;
-        print_colored("进程[%d] %s 从队列中移除\n", BLUE, current->pid, current->name);
-    }
+    print_colored("进程[%d] %s 移到队尾\n", BLUE, process->pid, process->name);
+    return 1;
 }
 
 // 销毁队列
@@ -232,6 +392,7 @@ void destroy_queue(ProcessQueue *queue) {
         current = next;
     }
     
+    free(queue->index);
     free(queue);
 }
 
@@ -249,21 +410,24 @@ void simulate_process_execution(PCB *process, int time) {
     print_colored("执行进程[%d] %s，执行时间: %d\n", 
                  CYAN, process->pid, process->name, actual_time);
     
-    // 模拟CPU执行
-    for (int i = 0; i < actual_time; i++) {
-        print_colored("\r[", WHITE);
-        for (int j = 0; j < 20; j++) {
-            if (j < (i+1) * 20 / actual_time) {
-                print_colored("=", GREEN);
-            } else {
-                print_colored(" ", WHITE);
+    // 模拟CPU执行，进度条每一步只改写变化的字符；纯文本模式下只输出最终状态
+    Frame *frame = create_frame(32, 1);
+    if (frame != NULL) {
+        set_cursor_visible(0);
+        for (int i = 0; i < actual_time; i++) {
+            if (!is_interactive_output() && i < actual_time - 1) continue;
+            int filled = (i+1) * 20 / actual_time;
+            frame_put(frame, 0, 0, "[", WHITE);
+            for (int j = 0; j < 20; j++) {
+                frame_put(frame, 0, 1 + j, j < filled ? "=" : " ", j < filled ? GREEN : WHITE);
             }
+            frame_text(frame, 0, 21, WHITE, "] %d%%", (i+1) * 100 / actual_time);
+            frame_render(frame);
+            display_delay(200000);  // 减慢速度，便于观察
         }
-        print_colored("] %d%%", WHITE, (i+1) * 100 / actual_time);
-        fflush(stdout);
-        usleep(200000);  // 减慢速度，便于观察
+        set_cursor_visible(1);
+        destroy_frame(frame);
     }
-    print_colored("\n", WHITE);
     
     // 更新进程剩余时间
     process->remaining_time -= actual_time;
@@ -328,125 +492,244 @@ void print_queue(ProcessQueue *queue) {
     print_colored("----------------------------------------------------------\n", WHITE);
 }
 
-// 计算进程统计信息（周转时间、等待时间等）
+// 记录进程完成，计算周转时间、带权周转时间和等待时间（不含阻塞于I/O的时间）
+void record_completion(PCB *process, int completion_time) {
+    if (process == NULL) return;
+    
+    process->remaining_time = 0;
+    process->status = PROCESS_TERMINATED;
+    process->completion_time = completion_time;
+    process->turnaround_time = process->completion_time - process->arrive_time;
+    process->weighted_turnaround = (float)process->turnaround_time / process->service_time;
+    process->waiting_time = process->turnaround_time - process->service_time - process->io_time;
+}
+
+// 计算进程统计信息（周转时间、等待时间等）：逐行列出前 STATS_DETAIL_ROWS 个进程，
+// 并给出全部已完成进程的均值和尾部分位数
 void calculate_statistics(PCB *process_list, int count) {
     if (process_list == NULL || count <= 0) return;
     
-    float avg_turnaround = 0.0f;
-    float avg_weighted_turnaround = 0.0f;
-    float avg_waiting = 0.0f;
+    double avg_turnaround = 0.0;
+    double avg_weighted_turnaround = 0.0;
+    double avg_waiting = 0.0;
+    double avg_response = 0.0;
+    
+    CompletionStats *stats = (CompletionStats*)malloc(sizeof(CompletionStats));
+    if (stats != NULL) {
+        completion_stats_init(stats);
+    }
     
     print_colored("\n进程执行统计信息：\n", CYAN);
-    print_colored("-----------------------------------------------------------------\n", WHITE);
-    print_colored("| %-3s | %-10s | %-4s | %-4s | %-4s | %-4s | %-4s | %-4s |\n", 
-                 WHITE, "PID", "名称", "到达", "服务", "完成", "周转", "带权", "等待");
-    print_colored("-----------------------------------------------------------------\n", WHITE);
+    print_colored("------------------------------------------------------------------------\n", WHITE);
+    print_colored("| %-3s | %-10s | %-4s | %-4s | %-4s | %-4s | %-4s | %-4s | %-4s |\n", 
+                 WHITE, "PID", "名称", "到达", "服务", "完成", "周转", "带权", "等待", "响应");
+    print_colored("------------------------------------------------------------------------\n", WHITE);
     
     for (int i = 0; i < count; i++) {
         PCB *p = &process_list[i];
         
-        print_colored("| %-3d | %-10s | %-4d | %-4d | %-4d | %-4d | %-4.1f | %-4d |\n", 
-                     WHITE, p->pid, p->name, p->arrive_time, p->service_time,
-                     p->completion_time, p->turnaround_time, p->weighted_turnaround, p->waiting_time);
+        // 响应时间：从到达到第一次获得CPU
+        int response = (p->start_time >= 0) ? p->start_time - p->arrive_time : 0;
+        
+        if (i < STATS_DETAIL_ROWS) {
+            print_colored("| %-3d | %-10s | %-4d | %-4d | %-4d | %-4d | %-4.1f | %-4d | %-4d |\n", 
+                         WHITE, p->pid, p->name, p->arrive_time, p->service_time,
+                         p->completion_time, p->turnaround_time, p->weighted_turnaround, p->waiting_time,
+                         response);
+        }
         
         avg_turnaround += p->turnaround_time;
         avg_weighted_turnaround += p->weighted_turnaround;
         avg_waiting += p->waiting_time;
+        avg_response += response;
+        
+        if (stats != NULL && p->status == PROCESS_TERMINATED) {
+            completion_stats_record(stats, p);
+        }
+    }
+    if (count > STATS_DETAIL_ROWS) {
+        print_colored("| ... 其余 %d 个进程省略\n", WHITE, count - STATS_DETAIL_ROWS);
     }
     
-    print_colored("-----------------------------------------------------------------\n", WHITE);
+    print_colored("------------------------------------------------------------------------\n", WHITE);
     
     avg_turnaround /= count;
     avg_weighted_turnaround /= count;
     avg_waiting /= count;
+    avg_response /= count;
     
     print_colored("平均周转时间: %.2f\n", YELLOW, avg_turnaround);
     print_colored("平均带权周转时间: %.2f\n", YELLOW, avg_weighted_turnaround);
     print_colored("平均等待时间: %.2f\n", YELLOW, avg_waiting);
+    print_colored("平均响应时间: %.2f\n", YELLOW, avg_response);
+    
+    if (stats != NULL) {
+        print_completion_stats(stats);
+        free(stats);
+    }
+}
+
+/**
+ * 创建执行记录
+ * @param capacity 最多记录的执行段数，记录过程中不再分配内存
+ * @return 执行记录指针，失败返回NULL
+ */
+ExecTrace* create_exec_trace(int capacity) {
+    ExecTrace *trace = (ExecTrace*)malloc(sizeof(ExecTrace));
+    if (trace == NULL) {
+        perror("内存分配失败");
+        return NULL;
+    }
+
+    trace->capacity = capacity > 0 ? capacity : 1;
+    trace->segments = (ExecSegment*)malloc(sizeof(ExecSegment) * trace->capacity);
+    trace->count = 0;
+    trace->dropped = 0;
+    if (trace->segments == NULL) {
+        perror("内存分配失败");
+        free(trace);
+        return NULL;
+    }
+    return trace;
 }
 
-// 可视化进程执行时间线
-void visualize_execution_timeline(PCB *process_list, int count, int total_time) {
+/**
+ * 记录进程 pid 在 [start, end) 内的一次执行，与上一段首尾相接时直接延长上一段
+ * trace 为NULL时不记录
+ */
+void trace_segment(ExecTrace *trace, int pid, int start, int end) {
+    if (trace == NULL || end <= start) return;
+
+    if (trace->count > 0) {
+        ExecSegment *last = &trace->segments[trace->count - 1];
+        if (last->pid == pid && last->end == start) {
+            last->end = end;
+            return;
+        }
+    }
+
+    if (trace->count >= trace->capacity) {
+        trace->dropped++;
+        return;
+    }
+    trace->segments[trace->count].pid = pid;
+    trace->segments[trace->count].start = start;
+    trace->segments[trace->count].end = end;
+    trace->count++;
+}
+
+/**
+ * 释放执行记录
+ */
+void destroy_exec_trace(ExecTrace *trace) {
+    if (trace == NULL) return;
+    free(trace->segments);
+    free(trace);
+}
+
+// 可视化进程执行时间线：按执行记录绘制甘特图。总时间超过 WIDTH 时每列代表多个时间单位，
+// 进程在一列对应的时间内运行过即标记为执行
+void visualize_execution_timeline(PCB *process_list, int count, const ExecTrace *trace, int total_time) {
     if (process_list == NULL || count <= 0 || total_time <= 0) return;
     
     const int WIDTH = 60;  // 总宽度
     const int name_width = 10;  // 进程名宽度
+    const int FRAME_WIDTH = 80;  // 帧宽度，容纳标题和图例
+    int columns = (total_time < WIDTH) ? total_time : WIDTH;
     
-    print_colored("\n进程执行时间线 (总时间: %d)：\n", CYAN, total_time);
+    // 每行 columns 个字符：'.' 不在系统中, '-' 就绪等待, '=' 执行
+    char *timeline = (char*)malloc((size_t)count * columns);
+    if (timeline == NULL) {
+        perror("内存分配失败");
+        return;
+    }
     
-    // 生成时间刻度
-    print_colored("%-*s", WHITE, name_width, "时间");
-    for (int t = 0; t <= total_time; t += total_time / 10) {
-        int pos = t * WIDTH / total_time;
-        print_colored("%-*d", WHITE, WIDTH / 10, t);
+    // 空行、标题、时间刻度、每个进程一行、图例和可能的一行提示，组装成一帧一次输出
+    int notes = (trace == NULL || trace->count == 0 || trace->dropped > 0) ? 1 : 0;
+    Frame *frame = create_frame(FRAME_WIDTH, count + 4 + notes);
+    if (frame == NULL) {
+        perror("内存分配失败");
+        free(timeline);
+        return;
     }
-    print_colored("\n", WHITE);
     
-    // 为每个进程绘制时间线
+    int col = frame_text(frame, 1, 0, CYAN, "进程执行时间线 (总时间: %d", total_time);
+    if (total_time > columns) {
+        col = frame_text(frame, 1, col, CYAN, ", 每列 %.1f 个时间单位", (double)total_time / columns);
+    }
+    frame_text(frame, 1, col, CYAN, ")：");
+    
+    int min_pid = process_list[0].pid, max_pid = process_list[0].pid;
     for (int i = 0; i < count; i++) {
         PCB *p = &process_list[i];
+        int leave_time = (p->status == PROCESS_TERMINATED) ? p->completion_time : total_time;
         
-        // 打印进程名
-        print_colored("%-*s", WHITE, name_width, p->name);
-        
-        char timeline[WIDTH + 1];
-        memset(timeline, '.', WIDTH);
-        timeline[WIDTH] = '\0';
-        
-        // 标记到达时间
-        int arrive_pos = p->arrive_time * WIDTH / total_time;
-        if (arrive_pos >= 0 && arrive_pos < WIDTH) {
-            timeline[arrive_pos] = '>';
-        }
-        
-        // 标记完成时间
-        int complete_pos = p->completion_time * WIDTH / total_time;
-        if (complete_pos >= 0 && complete_pos < WIDTH) {
-            timeline[complete_pos] = '<';
+        for (int c = 0; c < columns; c++) {
+            int col_start = (int)((long long)c * total_time / columns);
+            int col_end = (int)((long long)(c + 1) * total_time / columns);
+            int present = col_end > p->arrive_time && col_start < leave_time;
+            timeline[(size_t)i * columns + c] = present ? '-' : '.';
         }
         
-        // 标记执行段
-        int start_pos = -1;
-        int in_execution = 0;
+        if (p->pid < min_pid) min_pid = p->pid;
+        if (p->pid > max_pid) max_pid = p->pid;
+    }
+    
+    // pid 到行号的映射，执行记录中只有 pid
+    int *row_of = (int*)malloc(sizeof(int) * (max_pid - min_pid + 1));
+    if (row_of == NULL) {
+        perror("内存分配失败");
+        destroy_frame(frame);
+        free(timeline);
+        return;
+    }
+    for (int i = 0; i <= max_pid - min_pid; i++) {
+        row_of[i] = -1;
+    }
+    for (int i = 0; i < count; i++) {
+        row_of[process_list[i].pid - min_pid] = i;
+    }
+    
+    // 标记执行段
+    for (int s = 0; trace != NULL && s < trace->count; s++) {
+        const ExecSegment *seg = &trace->segments[s];
+        if (seg->pid < min_pid || seg->pid > max_pid || row_of[seg->pid - min_pid] < 0) continue;
+        if (seg->start >= total_time) continue;
         
-        for (int t = 0; t < WIDTH; t++) {
-            int time = t * total_time / WIDTH;
-            
-            // 检查在此时间点进程是否在运行
-            // 这部分需要实际调度算法的输出来确定
-            // 此处只是一个简化的示例
-            if (time >= p->arrive_time && time < p->completion_time) {
-                if (!in_execution) {
-                    in_execution = 1;
-                    start_pos = t;
-                }
-            } else {
-                if (in_execution) {
-                    in_execution = 0;
-                    for (int j = start_pos; j < t; j++) {
-                        timeline[j] = '=';
-                    }
-                }
-            }
+        int end = (seg->end < total_time) ? seg->end : total_time;
+        int first = (int)((long long)seg->start * columns / total_time);
+        int last = (int)((long long)(end - 1) * columns / total_time);
+        char *row = &timeline[(size_t)row_of[seg->pid - min_pid] * columns];
+        for (int c = first; c <= last; c++) {
+            row[c] = '=';
         }
-        
-        // 打印时间线
-        for (int t = 0; t < WIDTH; t++) {
-            char c = timeline[t];
-            switch(c) {
-                case '>':
-                    print_colored("%c", GREEN, c);
-                    break;
-                case '<':
-                    print_colored("%c", RED, c);
-                    break;
-                case '=':
-                    print_colored("%c", CYAN, c);
-                    break;
-                default:
-                    print_colored("%c", WHITE, c);
-            }
+    }
+    
+    // 生成时间刻度，每10列一个
+    frame_text(frame, 2, 0, WHITE, "时间");
+    for (int c = 0; c < columns; c += 10) {
+        frame_text(frame, 2, name_width + c, WHITE, "%d", (int)((long long)c * total_time / columns));
+    }
+    
+    // 为每个进程绘制时间线
+    for (int i = 0; i < count; i++) {
+        const char *row = &timeline[(size_t)i * columns];
+        frame_text(frame, 3 + i, 0, WHITE, "%s", process_list[i].name);
+        for (int c = 0; c < columns; c++) {
+            char glyph[2] = { row[c], '\0' };
+            frame_put(frame, 3 + i, name_width + c, glyph, row[c] == '=' ? CYAN : WHITE);
         }
-        print_colored("\n", WHITE);
     }
-}
\ No newline at end of file
+    
+    frame_text(frame, count + 3, 0, WHITE, "图例: = 执行  - 就绪等待  . 不在系统中");
+    if (trace == NULL || trace->count == 0) {
+        frame_text(frame, count + 4, 0, YELLOW, "没有执行记录，只显示进程在系统中的时间");
+    } else if (trace->dropped > 0) {
+        frame_text(frame, count + 4, 0, YELLOW, "执行记录缓冲区已满，%lld 个执行段未显示", trace->dropped);
+    }
+    
+    frame_render(frame);
+    destroy_frame(frame);
+    free(row_of);
+    free(timeline);
+}
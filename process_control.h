@@ -18,42 +18,83 @@ typedef struct PCB {
     int priority;           // 优先级 (值越大优先级越高)
     int arrive_time;        // 到达时间
     int service_time;       // 需要的服务时间 (总时间)
+    int deadline;           // 相对截止期限，从到达时刻算起 (<=0 表示没有截止期限)
+    int cpu_burst;          // 两次I/O之间的CPU突发长度 (<=0 表示纯CPU作业)
+    int io_device;          // I/O请求所用的设备编号
+    int burst_left;         // 当前CPU突发还需运行的时间
+    int io_time;            // 累计阻塞时间（设备排队 + 服务）
     int remaining_time;     // 剩余执行时间
     int completion_time;    // 完成时间
     int turnaround_time;    // 周转时间
     float weighted_turnaround; // 带权周转时间
     int waiting_time;       // 等待时间
+    int start_time;         // 首次运行时间 (-1 表示尚未运行)
+    int dispatch_count;     // 被调度次数
+    long long vruntime;     // 按权重折算的虚拟运行时间，单位为 1/1024 时间单位 (CFS)
     pid_t unix_pid;         // 真实UNIX进程ID
+    long long pool_ticket;  // 交给预派生进程池时的作业序号
     struct PCB *next;       // 链表指针
+    struct PCB *prev;       // 前驱指针，使移除和移到队尾为O(1)
 } PCB;
 
-// 进程队列结构
+#define QUEUE_INDEX_MIN_BITS 4  // 队列索引的初始容量为 16 个槽位
+
+// 进程队列结构：侵入式双向链表，附带 pid → PCB 的开放寻址散列索引
+// 一个PCB同一时刻只能位于一个队列中
 typedef struct {
     PCB *head;
     PCB *tail;
     int count;
+    PCB **index;            // 线性探测散列表，NULL 表示空槽
+    int index_bits;         // 散列表容量为 2^index_bits
 } ProcessQueue;
 
+// 执行段：进程 pid 在 [start, end) 内占用CPU
+typedef struct {
+    int pid;
+    int start;
+    int end;
+} ExecSegment;
+
+// 执行记录：预分配的执行段缓冲区，同一进程首尾相接的执行段合并为一段
+typedef struct {
+    ExecSegment *segments;
+    int count;
+    int capacity;
+    long long dropped;      // 缓冲区满后丢弃的执行段数
+} ExecTrace;
+
 // 进程控制函数
 PCB* create_process(char *name, int priority, int service_time);
 void terminate_process(PCB *process);
 PCB* create_simulated_process(char *name, int priority, int arrive_time, int service_time);
+void init_pcb(PCB *process, int pid, const char *name, int priority, int arrive_time, int service_time);
 
 // 队列操作函数
 ProcessQueue* create_queue();
-void enqueue(ProcessQueue *queue, PCB *process);
+int enqueue(ProcessQueue *queue, PCB *process);
 PCB* dequeue(ProcessQueue *queue);
+PCB* dequeue_tail(ProcessQueue *queue);
 PCB* peek_queue(ProcessQueue *queue);
+PCB* find_process(ProcessQueue *queue, int pid);
 void remove_process(ProcessQueue *queue, int pid);
+int move_to_tail(ProcessQueue *queue, int pid);
 void destroy_queue(ProcessQueue *queue);
 
 // 进程执行函数
+void run_process_task(const char *name, int service_time);
 void simulate_process_execution(PCB *process, int time);
 void print_process_info(PCB *process);
 void print_queue(ProcessQueue *queue);
 
 // 进程统计函数
+void record_completion(PCB *process, int completion_time);
 void calculate_statistics(PCB *process_list, int count);
-void visualize_execution_timeline(PCB *process_list, int count, int total_time);
+void visualize_execution_timeline(PCB *process_list, int count, const ExecTrace *trace, int total_time);
+
+// 执行记录函数
+ExecTrace* create_exec_trace(int capacity);
+void trace_segment(ExecTrace *trace, int pid, int start, int end);
+void destroy_exec_trace(ExecTrace *trace);
 
 #endif // PROCESS_CONTROL_H
\ No newline at end of file
@@ -0,0 +1,318 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include "rbtree.h"
+
+#define RB_RED 0
+#define RB_BLACK 1
+
+/**
+ * 初始化红黑树
+ * @param tree 目标树
+ * @param capacity 节点下标范围 [0, capacity)
+ * @return 成功返回0，内存不足返回-1
+ */
+int rb_init(RBTree *tree, int capacity) {
+    int slots = capacity + 1;  // 额外一个哨兵节点
+
+    tree->left = (int*)malloc(sizeof(int) * slots);
+    tree->right = (int*)malloc(sizeof(int) * slots);
+    tree->parent = (int*)malloc(sizeof(int) * slots);
+    tree->color = (char*)malloc(slots);
+    tree->keys = NULL;
+    tree->nil = capacity;
+    tree->root = capacity;
+    tree->leftmost = capacity;
+    tree->size = 0;
+
+    if (tree->left == NULL || tree->right == NULL || tree->parent == NULL || tree->color == NULL) {
+        perror("红黑树内存分配失败");
+        rb_destroy(tree);
+        return -1;
+    }
+
+    tree->color[tree->nil] = RB_BLACK;
+    tree->left[tree->nil] = tree->nil;
+    tree->right[tree->nil] = tree->nil;
+    tree->parent[tree->nil] = tree->nil;
+    return 0;
+}
+
+/**
+ * 释放红黑树的节点数组（不释放键数组）
+ */
+void rb_destroy(RBTree *tree) {
+    free(tree->left);
+    free(tree->right);
+    free(tree->parent);
+    free(tree->color);
+    tree->left = tree->right = tree->parent = NULL;
+    tree->color = NULL;
+    tree->size = 0;
+}
+
+// a 是否排在 b 之前
+static int rb_less(const RBTree *tree, int a, int b) {
+    if (tree->keys[a] != tree->keys[b]) {
+        return tree->keys[a] < tree->keys[b];
+    }
+    return a < b;
+}
+
+static void rotate_left(RBTree *tree, int x) {
+    int y = tree->right[x];
+
+    tree->right[x] = tree->left[y];
+    if (tree->left[y] != tree->nil) {
+        tree->parent[tree->left[y]] = x;
+    }
+    tree->parent[y] = tree->parent[x];
+    if (tree->parent[x] == tree->nil) {
+        tree->root = y;
+    } else if (x == tree->left[tree->parent[x]]) {
+        tree->left[tree->parent[x]] = y;
+    } else {
+        tree->right[tree->parent[x]] = y;
+    }
+    tree->left[y] = x;
+    tree->parent[x] = y;
+}
+
+static void rotate_right(RBTree *tree, int x) {
+    int y = tree->left[x];
+
+    tree->left[x] = tree->right[y];
+    if (tree->right[y] != tree->nil) {
+        tree->parent[tree->right[y]] = x;
+    }
+    tree->parent[y] = tree->parent[x];
+    if (tree->parent[x] == tree->nil) {
+        tree->root = y;
+    } else if (x == tree->right[tree->parent[x]]) {
+        tree->right[tree->parent[x]] = y;
+    } else {
+        tree->left[tree->parent[x]] = y;
+    }
+    tree->right[y] = x;
+    tree->parent[x] = y;
+}
+
+static int subtree_min(const RBTree *tree, int x) {
+    while (tree->left[x] != tree->nil) {
+        x = tree->left[x];
+    }
+    return x;
+}
+
+static int subtree_max(const RBTree *tree, int x) {
+    while (tree->right[x] != tree->nil) {
+        x = tree->right[x];
+    }
+    return x;
+}
+
+// 中序后继
+static int successor(const RBTree *tree, int x) {
+    if (tree->right[x] != tree->nil) {
+        return subtree_min(tree, tree->right[x]);
+    }
+    int y = tree->parent[x];
+    while (y != tree->nil && x == tree->right[y]) {
+        x = y;
+        y = tree->parent[y];
+    }
+    return y;
+}
+
+/**
+ * 插入节点，O(log n)
+ */
+void rb_insert(RBTree *tree, int z) {
+    int y = tree->nil;
+    int x = tree->root;
+
+    while (x != tree->nil) {
+        y = x;
+        x = rb_less(tree, z, x) ? tree->left[x] : tree->right[x];
+    }
+
+    tree->parent[z] = y;
+    if (y == tree->nil) {
+        tree->root = z;
+    } else if (rb_less(tree, z, y)) {
+        tree->left[y] = z;
+    } else {
+        tree->right[y] = z;
+    }
+    tree->left[z] = tree->nil;
+    tree->right[z] = tree->nil;
+    tree->color[z] = RB_RED;
+
+    if (tree->leftmost == tree->nil || rb_less(tree, z, tree->leftmost)) {
+        tree->leftmost = z;
+    }
+    tree->size++;
+
+    // 修复红黑性质
+    while (tree->color[tree->parent[z]] == RB_RED) {
+        int p = tree->parent[z];
+        int g = tree->parent[p];
+
+        if (p == tree->left[g]) {
+            int uncle = tree->right[g];
+            if (tree->color[uncle] == RB_RED) {
+                tree->color[p] = RB_BLACK;
+                tree->color[uncle] = RB_BLACK;
+                tree->color[g] = RB_RED;
+                z = g;
+            } else {
+                if (z == tree->right[p]) {
+                    z = p;
+                    rotate_left(tree, z);
+                    p = tree->parent[z];
+                }
+                tree->color[p] = RB_BLACK;
+                tree->color[g] = RB_RED;
+                rotate_right(tree, g);
+            }
+        } else {
+            int uncle = tree->left[g];
+            if (tree->color[uncle] == RB_RED) {
+                tree->color[p] = RB_BLACK;
+                tree->color[uncle] = RB_BLACK;
+                tree->color[g] = RB_RED;
+                z = g;
+            } else {
+                if (z == tree->left[p]) {
+                    z = p;
+                    rotate_right(tree, z);
+                    p = tree->parent[z];
+                }
+                tree->color[p] = RB_BLACK;
+                tree->color[g] = RB_RED;
+                rotate_left(tree, g);
+            }
+        }
+    }
+    tree->color[tree->root] = RB_BLACK;
+}
+
+// 用以 v 为根的子树替换以 u 为根的子树
+static void transplant(RBTree *tree, int u, int v) {
+    if (tree->parent[u] == tree->nil) {
+        tree->root = v;
+    } else if (u == tree->left[tree->parent[u]]) {
+        tree->left[tree->parent[u]] = v;
+    } else {
+        tree->right[tree->parent[u]] = v;
+    }
+    tree->parent[v] = tree->parent[u];
+}
+
+/**
+ * 删除节点，O(log n)
+ */
+void rb_erase(RBTree *tree, int z) {
+    if (z == tree->leftmost) {
+        tree->leftmost = successor(tree, z);
+    }
+
+    int y = z;
+    int y_color = tree->color[y];
+    int x;
+
+    if (tree->left[z] == tree->nil) {
+        x = tree->right[z];
+        transplant(tree, z, tree->right[z]);
+    } else if (tree->right[z] == tree->nil) {
+        x = tree->left[z];
+        transplant(tree, z, tree->left[z]);
+    } else {
+        y = subtree_min(tree, tree->right[z]);
+        y_color = tree->color[y];
+        x = tree->right[y];
+        if (tree->parent[y] == z) {
+            tree->parent[x] = y;
+        } else {
+            transplant(tree, y, tree->right[y]);
+            tree->right[y] = tree->right[z];
+            tree->parent[tree->right[y]] = y;
+        }
+        transplant(tree, z, y);
+        tree->left[y] = tree->left[z];
+        tree->parent[tree->left[y]] = y;
+        tree->color[y] = tree->color[z];
+    }
+    tree->size--;
+
+    if (y_color != RB_BLACK) return;
+
+    // 修复红黑性质
+    while (x != tree->root && tree->color[x] == RB_BLACK) {
+        int p = tree->parent[x];
+
+        if (x == tree->left[p]) {
+            int w = tree->right[p];
+            if (tree->color[w] == RB_RED) {
+                tree->color[w] = RB_BLACK;
+                tree->color[p] = RB_RED;
+                rotate_left(tree, p);
+                w = tree->right[p];
+            }
+            if (tree->color[tree->left[w]] == RB_BLACK && tree->color[tree->right[w]] == RB_BLACK) {
+                tree->color[w] = RB_RED;
+                x = p;
+            } else {
+                if (tree->color[tree->right[w]] == RB_BLACK) {
+                    tree->color[tree->left[w]] = RB_BLACK;
+                    tree->color[w] = RB_RED;
+                    rotate_right(tree, w);
+                    w = tree->right[p];
+                }
+                tree->color[w] = tree->color[p];
+                tree->color[p] = RB_BLACK;
+                tree->color[tree->right[w]] = RB_BLACK;
+                rotate_left(tree, p);
+                x = tree->root;
+            }
+        } else {
+            int w = tree->left[p];
+            if (tree->color[w] == RB_RED) {
+                tree->color[w] = RB_BLACK;
+                tree->color[p] = RB_RED;
+                rotate_right(tree, p);
+                w = tree->left[p];
+            }
+            if (tree->color[tree->right[w]] == RB_BLACK && tree->color[tree->left[w]] == RB_BLACK) {
+                tree->color[w] = RB_RED;
+                x = p;
+            } else {
+                if (tree->color[tree->left[w]] == RB_BLACK) {
+                    tree->color[tree->right[w]] = RB_BLACK;
+                    tree->color[w] = RB_RED;
+                    rotate_left(tree, w);
+                    w = tree->left[p];
+                }
+                tree->color[w] = tree->color[p];
+                tree->color[p] = RB_BLACK;
+                tree->color[tree->left[w]] = RB_BLACK;
+                rotate_right(tree, p);
+                x = tree->root;
+            }
+        }
+    }
+    tree->color[x] = RB_BLACK;
+}
+
+/**
+ * 最小节点，树为空时返回-1
+ */
+int rb_first(const RBTree *tree) {
+    return tree->leftmost == tree->nil ? -1 : tree->leftmost;
+}
+
+/**
+ * 最大节点，树为空时返回-1，O(log n)
+ */
+int rb_last(const RBTree *tree) {
+    return tree->root == tree->nil ? -1 : subtree_max(tree, tree->root);
+}
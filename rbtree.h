@@ -0,0 +1,26 @@
+#ifndef RBTREE_H
+#define RBTREE_H
+
+// 以数组下标为节点的红黑树，按 (keys[下标], 下标) 升序排列
+// 节点信息存放在预分配的数组中，插入和删除不再分配内存；节点在树中时不得修改其键
+typedef struct {
+    int *left;
+    int *right;
+    int *parent;
+    char *color;
+    const long long *keys;  // 各节点的键，由调用者维护
+    int nil;                // 哨兵节点下标 (== capacity)
+    int root;
+    int leftmost;           // 缓存的最小节点，取最小值为 O(1)
+    int size;
+} RBTree;
+
+// 红黑树函数
+int rb_init(RBTree *tree, int capacity);
+void rb_destroy(RBTree *tree);
+void rb_insert(RBTree *tree, int node);
+void rb_erase(RBTree *tree, int node);
+int rb_first(const RBTree *tree);
+int rb_last(const RBTree *tree);
+
+#endif // RBTREE_H
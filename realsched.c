@@ -0,0 +1,449 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <poll.h>
+#include <signal.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/signalfd.h>
+#include <sys/timerfd.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include "process_control.h"
+#include "realsched.h"
+#include "simulator.h"
+#include "visualization.h"
+
+// 从 start 到现在经过的毫秒数
+static double elapsed_ms(const struct timespec *start) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (now.tv_sec - start->tv_sec) * 1000.0 + (now.tv_nsec - start->tv_nsec) / 1e6;
+}
+
+// 子进程：消耗 cpu_ms 毫秒的CPU时间后退出。被 SIGSTOP 暂停期间不消耗CPU时间，
+// 因此子进程实际运行的总时长与被调度的方式无关
+static void burn_cpu(int cpu_ms) {
+    volatile unsigned long sink = 0;
+    struct timespec ts;
+
+    do {
+        for (int i = 0; i < 100000; i++) {
+            sink += i;
+        }
+        clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &ts);
+    } while (ts.tv_sec * 1000.0 + ts.tv_nsec / 1e6 < cpu_ms);
+}
+
+// 创建一个处于暂停状态的工作进程，等到第一次 SIGCONT 才开始消耗CPU
+static pid_t spawn_worker(int cpu_ms, const sigset_t *child_mask) {
+    pid_t pid = fork();
+    if (pid < 0) {
+        perror("fork失败");
+        return -1;
+    }
+    if (pid == 0) {
+        sigprocmask(SIG_SETMASK, child_mask, NULL);
+        raise(SIGSTOP);
+        burn_cpu(cpu_ms);
+        _exit(0);
+    }
+
+    // 确认子进程已经暂停，之后的 SIGCONT 才不会丢失
+    int status;
+    if (waitpid(pid, &status, WUNTRACED) != pid || !WIFSTOPPED(status)) {
+        kill(pid, SIGKILL);
+        waitpid(pid, NULL, 0);
+        return -1;
+    }
+    return pid;
+}
+
+// 把定时器设置为在 start + deadline_ms 时到期，deadline_ms < 0 时关闭定时器
+static void arm_timer(int tfd, const struct timespec *start, double deadline_ms) {
+    struct itimerspec its;
+    memset(&its, 0, sizeof(its));
+
+    if (deadline_ms >= 0) {
+        long long ns = start->tv_sec * 1000000000LL + start->tv_nsec + (long long)(deadline_ms * 1e6);
+        its.it_value.tv_sec = ns / 1000000000LL;
+        its.it_value.tv_nsec = ns % 1000000000LL;
+        if (its.it_value.tv_sec == 0 && its.it_value.tv_nsec == 0) {
+            its.it_value.tv_nsec = 1;
+        }
+    }
+    timerfd_settime(tfd, TFD_TIMER_ABSTIME, &its, NULL);
+}
+
+// 读空非阻塞描述符中的所有数据
+static void drain_fd(int fd) {
+    char buffer[sizeof(struct signalfd_siginfo) * 8];
+    while (read(fd, buffer, sizeof(buffer)) > 0) {
+    }
+}
+
+// 接纳到达时刻不晚于 now 的进程，RR 同时放入环形就绪队列，返回下一个未到达进程在 order 中的位置
+static int admit_arrivals(PCB *processes, int count, const int *order, int next_arrival, double now,
+                          char *ready, int *ring, int ring_head, int *ring_size, const RealSchedConfig *config) {
+    while (next_arrival < count && processes[order[next_arrival]].arrive_time <= now) {
+        int idx = order[next_arrival++];
+        ready[idx] = 1;
+        if (config->algorithm == ALGO_RR) {
+            ring[(ring_head + (*ring_size)++) % count] = idx;
+        }
+        if (config->verbose) {
+            print_colored("%8.1f ms: 进程[%d] %s 到达\n", BLUE, now, processes[idx].pid, processes[idx].name);
+        }
+    }
+    return next_arrival;
+}
+
+// 从已到达的就绪进程中按策略选择下一个（FCFS/Priority/SJF），没有则返回-1
+static int pick_next(const PCB *processes, int count, const char *ready, SchedAlgorithm algorithm) {
+    int best = -1;
+
+    for (int i = 0; i < count; i++) {
+        if (!ready[i]) continue;
+        if (best < 0) {
+            best = i;
+            continue;
+        }
+
+        const PCB *p = &processes[i];
+        const PCB *b = &processes[best];
+        int better;
+        if (algorithm == ALGO_PRIORITY) {
+            better = p->priority > b->priority ||
+                     (p->priority == b->priority && p->arrive_time < b->arrive_time);
+        } else if (algorithm == ALGO_SJF) {
+            better = p->service_time < b->service_time ||
+                     (p->service_time == b->service_time && p->arrive_time < b->arrive_time);
+        } else {
+            better = p->arrive_time < b->arrive_time;
+        }
+        if (better) best = i;
+    }
+    return best;
+}
+
+// 进程结束一次运行：记录执行段，按实际运行的墙钟时间扣减剩余时间
+static void end_run(PCB *p, double run_start, double now, const RealSchedConfig *config,
+                    RealSchedResult *result) {
+    trace_segment(config->trace, p->pid, (int)(run_start + 0.5), (int)(now + 0.5));
+    result->busy_ms += now - run_start;
+    p->remaining_time -= (int)(now - run_start + 0.5);
+    if (p->remaining_time < 0) p->remaining_time = 0;
+}
+
+static void complete_worker(PCB *p, double now, const RealSchedConfig *config) {
+    record_completion(p, (int)(now + 0.5));
+    if (config->verbose) {
+        print_colored("%8.1f ms: 子进程[%d] %s 退出\n", GREEN, now, p->unix_pid, p->name);
+    }
+}
+
+/**
+ * 用真实的子进程运行调度策略
+ * 每个PCB派生一个暂停状态的子进程，需要 service_time 个时间单位的CPU时间。调度器按策略向子进程发送
+ * SIGCONT，RR 在 timerfd 定时的时间片结束时发送 SIGSTOP 抢占，子进程退出后由 waitpid 回收。
+ * 运行后PCB中的时间字段（到达、服务、完成、周转、等待、开始）均以毫秒为单位
+ * @param processes 进程数组（会被修改）
+ * @param count 进程数量
+ * @param config 调度参数
+ * @param result 输出的测量结果
+ * @return 成功返回0，失败返回-1
+ */
+int run_real_scheduler(PCB *processes, int count, const RealSchedConfig *config, RealSchedResult *result) {
+    if (processes == NULL || count <= 0 || config == NULL || result == NULL) return -1;
+
+    SchedAlgorithm algorithm = config->algorithm;
+    if (algorithm != ALGO_FCFS && algorithm != ALGO_RR && algorithm != ALGO_PRIORITY && algorithm != ALGO_SJF) {
+        print_colored("真实进程调度只支持 FCFS/RR/Priority/SJF\n", RED);
+        return -1;
+    }
+
+    int unit = config->unit_ms > 0 ? config->unit_ms : 10;
+    double quantum_ms = (double)(config->time_quantum > 0 ? config->time_quantum : 1) * unit;
+    memset(result, 0, sizeof(RealSchedResult));
+
+    for (int i = 0; i < count; i++) {
+        PCB *p = &processes[i];
+        p->arrive_time *= unit;
+        p->service_time *= unit;
+        p->remaining_time = p->service_time;
+        p->status = PROCESS_READY;
+        p->start_time = -1;
+        p->dispatch_count = 0;
+        p->unix_pid = -1;
+    }
+
+    int *order = sort_by_arrival(processes, count);
+    int *ring = (int*)malloc(sizeof(int) * count);     // RR就绪队列（环形）
+    char *ready = (char*)calloc(count, 1);             // 已到达且等待CPU
+    if (order == NULL || ring == NULL || ready == NULL) {
+        free(order);
+        free(ring);
+        free(ready);
+        return -1;
+    }
+
+    // SIGCHLD 改由 signalfd 接收，与时间片定时器一起在 poll 中等待
+    sigset_t chld_mask, old_mask;
+    sigemptyset(&chld_mask);
+    sigaddset(&chld_mask, SIGCHLD);
+    sigprocmask(SIG_BLOCK, &chld_mask, &old_mask);
+    int sfd = signalfd(-1, &chld_mask, SFD_NONBLOCK | SFD_CLOEXEC);
+    int tfd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+    int ok = (sfd >= 0 && tfd >= 0);
+    if (!ok) {
+        perror("创建 signalfd/timerfd 失败");
+    }
+
+    fflush(stdout);
+    for (int i = 0; ok && i < count; i++) {
+        processes[i].unix_pid = spawn_worker(processes[i].service_time, &old_mask);
+        if (processes[i].unix_pid < 0) ok = 0;
+    }
+
+    struct timespec start;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+
+    int ring_head = 0, ring_size = 0;
+    int next_arrival = 0;
+    int completed = 0;
+    int running = -1;
+    double run_start = 0.0;         // 本次获得CPU的时刻
+    double slice_start = 0.0;       // 当前时间片开始的时刻
+    double switch_begin = -1.0;     // 上一个进程让出CPU的时刻，<0 表示没有进行中的切换
+
+    while (ok && completed < count) {
+        double now = elapsed_ms(&start);
+
+        next_arrival = admit_arrivals(processes, count, order, next_arrival, now, ready,
+                                      ring, ring_head, &ring_size, config);
+
+        if (running < 0) {
+            int idx = -1;
+            if (algorithm == ALGO_RR) {
+                if (ring_size > 0) {
+                    idx = ring[ring_head];
+                    ring_head = (ring_head + 1) % count;
+                    ring_size--;
+                }
+            } else {
+                idx = pick_next(processes, count, ready, algorithm);
+            }
+
+            if (idx >= 0) {
+                PCB *p = &processes[idx];
+                kill(p->unix_pid, SIGCONT);
+                now = elapsed_ms(&start);
+
+                if (switch_begin >= 0) {
+                    double cost = now - switch_begin;
+                    result->switches++;
+                    result->switch_total_ms += cost;
+                    if (cost > result->switch_max_ms) result->switch_max_ms = cost;
+                }
+
+                ready[idx] = 0;
+                p->status = PROCESS_RUNNING;
+                p->dispatch_count++;
+                if (p->start_time < 0) {
+                    p->start_time = (int)(now + 0.5);
+                }
+                running = idx;
+                run_start = slice_start = now;
+
+                if (config->verbose) {
+                    print_colored("%8.1f ms: SIGCONT -> 子进程[%d] %s\n", CYAN, now, p->unix_pid, p->name);
+                }
+            }
+            switch_begin = -1.0;
+        }
+
+        // 定时器在下一个到达时刻或当前时间片结束时到期，子进程退出由 SIGCHLD 唤醒
+        double deadline = -1.0;
+        if (next_arrival < count) {
+            deadline = processes[order[next_arrival]].arrive_time;
+        }
+        if (running >= 0 && algorithm == ALGO_RR && (deadline < 0 || slice_start + quantum_ms < deadline)) {
+            deadline = slice_start + quantum_ms;
+        }
+        arm_timer(tfd, &start, deadline);
+
+        struct pollfd fds[2] = { { tfd, POLLIN, 0 }, { sfd, POLLIN, 0 } };
+        if (poll(fds, 2, -1) < 0) {
+            if (errno == EINTR) continue;
+            perror("poll失败");
+            ok = 0;
+            break;
+        }
+        drain_fd(tfd);
+        drain_fd(sfd);
+
+        if (running < 0) continue;
+
+        PCB *p = &processes[running];
+        int status;
+        pid_t reaped = waitpid(p->unix_pid, &status, WNOHANG);
+        now = elapsed_ms(&start);
+
+        if (reaped == p->unix_pid) {
+            end_run(p, run_start, now, config, result);
+            complete_worker(p, now, config);
+            completed++;
+            running = -1;
+            switch_begin = now;
+        } else if (algorithm == ALGO_RR && now >= slice_start + quantum_ms) {
+            // 与模拟引擎的RR相同：先接纳新到达的进程，再把被抢占的进程放回队尾
+            next_arrival = admit_arrivals(processes, count, order, next_arrival, now, ready,
+                                          ring, ring_head, &ring_size, config);
+            if (ring_size == 0) {
+                // 没有其他就绪进程，继续运行，不做无谓的切换
+                slice_start = now;
+                continue;
+            }
+
+            switch_begin = now;
+            kill(p->unix_pid, SIGSTOP);
+            waitpid(p->unix_pid, &status, WUNTRACED);
+            now = elapsed_ms(&start);
+            end_run(p, run_start, now, config, result);
+
+            if (WIFSTOPPED(status)) {
+                p->status = PROCESS_READY;
+                ready[running] = 1;
+                ring[(ring_head + ring_size++) % count] = running;
+                if (config->verbose) {
+                    print_colored("%8.1f ms: SIGSTOP -> 子进程[%d] %s 时间片用完\n", YELLOW,
+                                 now, p->unix_pid, p->name);
+                }
+            } else {
+                // 在暂停前已经退出
+                complete_worker(p, now, config);
+                completed++;
+            }
+            running = -1;
+        }
+    }
+
+    result->makespan_ms = (int)(elapsed_ms(&start) + 0.5);
+
+    // 出错时结束所有尚未回收的子进程
+    for (int i = 0; i < count; i++) {
+        if (processes[i].unix_pid > 0 && processes[i].status != PROCESS_TERMINATED) {
+            kill(processes[i].unix_pid, SIGKILL);
+            waitpid(processes[i].unix_pid, NULL, 0);
+        }
+    }
+
+    if (sfd >= 0) close(sfd);
+    if (tfd >= 0) close(tfd);
+    sigprocmask(SIG_SETMASK, &old_mask, NULL);
+    free(order);
+    free(ring);
+    free(ready);
+    return ok ? 0 : -1;
+}
+
+/**
+ * 打印真实调度的切换开销与CPU利用率
+ */
+void print_real_result(const RealSchedResult *result) {
+    print_colored("\n真实调度测量 (毫秒):\n", CYAN);
+    print_colored("完成时刻: %d ms\n", YELLOW, result->makespan_ms);
+    print_colored("子进程占用CPU: %.1f ms (%.1f%%)\n", YELLOW, result->busy_ms,
+                 result->makespan_ms > 0 ? result->busy_ms * 100 / result->makespan_ms : 0.0);
+    print_colored("切换次数: %d, 平均切换开销: %.3f ms, 最大: %.3f ms\n", YELLOW, result->switches,
+                 result->switches > 0 ? result->switch_total_ms / result->switches : 0.0,
+                 result->switch_max_ms);
+}
+
+static void print_real_usage(const char *prog) {
+    print_colored("用法: %s real [选项]\n", YELLOW, prog);
+    print_colored("  -n 数量    生成的进程数量 (默认 6)\n", WHITE);
+    print_colored("  -s 种子    随机种子 (默认 1)\n", WHITE);
+    print_colored("  -f 文件    从文件加载工作负载\n", WHITE);
+    print_colored("  -a 算法    FCFS|RR|Priority|SJF (默认 RR)\n", WHITE);
+    print_colored("  -q 片长    RR时间片，单位为时间单位 (默认 2)\n", WHITE);
+    print_colored("  -u 毫秒    一个时间单位对应的CPU毫秒数 (默认 10)\n", WHITE);
+}
+
+/**
+ * 真实进程调度命令行入口
+ * @return 进程退出码
+ */
+int real_main(int argc, char *argv[]) {
+    int count = 6;
+    unsigned int seed = 1;
+    const char *path = NULL;
+    RealSchedConfig config = { .algorithm = ALGO_RR, .time_quantum = 2, .unit_ms = 10, .verbose = 1 };
+
+    for (int i = 1; i < argc; i += 2) {
+        const char *opt = argv[i];
+        const char *value = (i + 1 < argc) ? argv[i + 1] : NULL;
+
+        if (value == NULL || opt[0] != '-' || opt[1] == '\0' || opt[2] != '\0') {
+            print_real_usage(argv[0]);
+            return 1;
+        }
+
+        switch (opt[1]) {
+            case 'n': count = atoi(value); break;
+            case 's': seed = (unsigned int)strtoul(value, NULL, 10); break;
+            case 'f': path = value; break;
+            case 'q': config.time_quantum = atoi(value); break;
+            case 'u': config.unit_ms = atoi(value); break;
+            case 'a': {
+                int a = parse_sched_algorithm(value);
+                if (a < 0) {
+                    print_colored("未知调度算法: %s\n", RED, value);
+                    return 1;
+                }
+                config.algorithm = (SchedAlgorithm)a;
+                break;
+            }
+            default:
+                print_real_usage(argv[0]);
+                return 1;
+        }
+    }
+
+    PCB *processes;
+    if (path != NULL) {
+        processes = load_workload(path, &count);
+    } else if (count > 0) {
+        processes = generate_workload(count, seed);
+    } else {
+        print_colored("进程数量必须大于0\n", RED);
+        return 1;
+    }
+    if (processes == NULL) return 1;
+
+    int total_service = 0;
+    for (int i = 0; i < count; i++) {
+        total_service += processes[i].service_time;
+    }
+    ExecTrace *trace = create_exec_trace(total_service + count);
+    config.trace = trace;
+
+    print_colored("真实进程调度: %d 个子进程, 算法 %s, 时间片 %d, 1 时间单位 = %d ms\n", CYAN,
+                 count, sched_algorithm_name(config.algorithm), config.time_quantum, config.unit_ms);
+
+    RealSchedResult result;
+    int rc = run_real_scheduler(processes, count, &config, &result);
+    if (rc == 0) {
+        print_colored("\n以下时间均以毫秒为单位\n", WHITE);
+        calculate_statistics(processes, count);
+        visualize_execution_timeline(processes, count, trace, result.makespan_ms);
+        print_real_result(&result);
+    } else {
+        print_colored("真实进程调度失败\n", RED);
+    }
+
+    destroy_exec_trace(trace);
+    free(processes);
+    return rc == 0 ? 0 : 1;
+}
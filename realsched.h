@@ -0,0 +1,31 @@
+#ifndef REALSCHED_H
+#define REALSCHED_H
+
+#include "process_control.h"
+#include "simulator.h"
+
+// 真实进程调度参数：每个PCB对应一个fork出的CPU密集型子进程，
+// 调度器用 SIGCONT 让其运行、用 SIGSTOP 抢占，用 waitpid 回收
+typedef struct {
+    SchedAlgorithm algorithm;   // 仅支持 FCFS/RR/Priority/SJF
+    int time_quantum;           // RR时间片（时间单位）
+    int unit_ms;                // 一个时间单位对应的CPU毫秒数
+    int verbose;                // 非零时打印调度事件
+    ExecTrace *trace;           // 非NULL时记录执行段（毫秒）
+} RealSchedConfig;
+
+// 真实调度的测量结果
+typedef struct {
+    int makespan_ms;            // 全部子进程退出的时刻
+    int switches;               // 切换次数（上一个进程让出CPU后紧接着恢复下一个进程）
+    double switch_total_ms;     // 切换开销总和：让出CPU到下一个进程收到 SIGCONT
+    double switch_max_ms;       // 单次切换开销最大值
+    double busy_ms;             // 有子进程被允许运行的总时间
+} RealSchedResult;
+
+// 真实进程调度函数
+int run_real_scheduler(PCB *processes, int count, const RealSchedConfig *config, RealSchedResult *result);
+void print_real_result(const RealSchedResult *result);
+int real_main(int argc, char *argv[]);
+
+#endif // REALSCHED_H
@@ -0,0 +1,141 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "export.h"
+#include "process_control.h"
+#include "sched_export.h"
+#include "simulator.h"
+#include "timeutil.h"
+#include "visualization.h"
+
+// 导出一个文件并报告大小与速度
+static int report_export(const char *path, long long bytes, double elapsed) {
+    if (bytes < 0) {
+        print_colored("导出失败: %s\n", RED, path);
+        return -1;
+    }
+    double mb = bytes / (1024.0 * 1024.0);
+    print_colored("  %-32s %10.1f MB  %8.1f ms  %8.1f MB/s\n", GREEN, path, mb, elapsed,
+                 elapsed > 0 ? mb * 1000.0 / elapsed : 0.0);
+    return 0;
+}
+
+static void print_export_usage(const char *prog) {
+    print_colored("用法: %s export [选项]\n", YELLOW, prog);
+    print_colored("  -n 数量    生成的进程数量 (默认 1000000)\n", WHITE);
+    print_colored("  -s 种子    随机种子 (默认 1)\n", WHITE);
+    print_colored("  -f 文件    从文件加载工作负载\n", WHITE);
+    print_colored("  -a 算法    调度算法 (默认 RR)，可选:", WHITE);
+    for (int i = 0; i < ALGO_COUNT; i++) {
+        print_colored(" %s", WHITE, sched_algorithm_name((SchedAlgorithm)i));
+    }
+    print_colored("\n", WHITE);
+    print_colored("  -q 片长    时间片，用于RR、Stride、Lottery和MLFQ第0级 (默认 4)\n", WHITE);
+    print_colored("  -l 级数    MLFQ队列级数 (默认 3)\n", WHITE);
+    print_colored("  -b 周期    MLFQ优先级提升周期，0表示不提升 (默认 500)\n", WHITE);
+    print_colored("  -g 周期    抢占式优先级每等待多少时间单位优先级加1，0表示不老化 (默认 100)\n", WHITE);
+    print_colored("  -o 前缀    输出文件前缀 (默认 sched_export)\n", WHITE);
+    print_colored("  -t 格式    csv、bin 或 all (默认 all)\n", WHITE);
+}
+
+/**
+ * 结果导出命令行入口：运行一次调度模拟，把每个进程的统计写成CSV和/或列式文件
+ * @return 进程退出码
+ */
+int export_main(int argc, char *argv[]) {
+    int count = 1000000;
+    unsigned int seed = 1;
+    const char *path = NULL;
+    const char *prefix = "sched_export";
+    const char *format = "all";
+    SchedConfig config;
+    sched_config_defaults(&config, ALGO_RR);
+    config.random_seed = seed;
+
+    for (int i = 1; i < argc; i += 2) {
+        const char *opt = argv[i];
+        const char *value = (i + 1 < argc) ? argv[i + 1] : NULL;
+
+        if (value == NULL || opt[0] != '-' || opt[1] == '\0' || opt[2] != '\0') {
+            print_export_usage(argv[0]);
+            return 1;
+        }
+
+        switch (opt[1]) {
+            case 'n': count = atoi(value); break;
+            case 's':
+                seed = (unsigned int)strtoul(value, NULL, 10);
+                config.random_seed = seed;
+                break;
+            case 'f': path = value; break;
+            case 'a': {
+                int algorithm = parse_sched_algorithm(value);
+                if (algorithm < 0) {
+                    print_colored("未知调度算法: %s\n", RED, value);
+                    print_export_usage(argv[0]);
+                    return 1;
+                }
+                config.algorithm = (SchedAlgorithm)algorithm;
+                break;
+            }
+            case 'q': config.time_quantum = atoi(value); break;
+            case 'l': config.mlfq_levels = atoi(value); break;
+            case 'b': config.boost_interval = atoi(value); break;
+            case 'g': config.aging_interval = atoi(value); break;
+            case 'o': prefix = value; break;
+            case 't': format = value; break;
+            default:
+                print_export_usage(argv[0]);
+                return 1;
+        }
+    }
+
+    int want_csv = strcmp(format, "csv") == 0 || strcmp(format, "all") == 0;
+    int want_columns = strcmp(format, "bin") == 0 || strcmp(format, "all") == 0;
+    if (!want_csv && !want_columns) {
+        print_colored("未知导出格式: %s\n", RED, format);
+        return 1;
+    }
+
+    PCB *processes;
+    if (path != NULL) {
+        processes = load_workload(path, &count);
+    } else if (count > 0) {
+        processes = generate_workload(count, seed);
+    } else {
+        print_colored("进程数量必须大于0\n", RED);
+        return 1;
+    }
+    if (processes == NULL) return 1;
+
+    print_colored("模拟 %s: %d 个进程...\n", CYAN, sched_algorithm_name(config.algorithm), count);
+    int was_quiet = is_quiet_mode();
+    set_quiet_mode(1);
+    int result = run_simulation(processes, count, &config);
+    set_quiet_mode(was_quiet);
+    if (result < 0) {
+        print_colored("模拟失败\n", RED);
+        free(processes);
+        return 1;
+    }
+
+    char file[4096];
+    int failed = 0;
+    print_colored("导出 %d 行:\n", CYAN, count);
+    if (want_csv) {
+        snprintf(file, sizeof(file), "%s_processes.csv", prefix);
+        double start = now_ms();
+        long long bytes = export_processes_csv(file, processes, count);
+        failed |= report_export(file, bytes, now_ms() - start);
+    }
+    if (want_columns) {
+        snprintf(file, sizeof(file), "%s_processes.col", prefix);
+        double start = now_ms();
+        long long bytes = export_processes_columns(file, processes, count);
+        failed |= report_export(file, bytes, now_ms() - start);
+    }
+
+    free(processes);
+    return failed ? 1 : 0;
+}
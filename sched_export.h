@@ -0,0 +1,7 @@
+#ifndef SCHED_EXPORT_H
+#define SCHED_EXPORT_H
+
+// 调度结果导出命令行入口，文件格式见 export.h
+int export_main(int argc, char *argv[]);
+
+#endif // SCHED_EXPORT_H
@@ -1,8 +1,22 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <time.h>
 #include <unistd.h>
 #include "process_control.h"
+#include "metrics.h"
+#include "mpmc.h"
+#include "checkpoint.h"
+#include "deadline.h"
+#include "fairness.h"
+#include "iosim.h"
+#include "multicore.h"
+#include "realsched.h"
+#include "sched_export.h"
+#include "share.h"
+#include "spawn.h"
+#include "simulator.h"
+#include "sweep.h"
 #include "visualization.h"
 
 // 模拟时钟
@@ -28,24 +42,22 @@ PCB* create_test_processes(int *count) {
     PCB *processes = (PCB*)malloc(sizeof(PCB) * (*count));
     
     for (int i = 0; i < *count; i++) {
-        strcpy(processes[i].name, test_data[i].name);
-        processes[i].pid = i + 1;
-        processes[i].status = PROCESS_READY;
-        processes[i].priority = test_data[i].priority;
-        processes[i].arrive_time = test_data[i].arrive_time;
-        processes[i].service_time = test_data[i].service_time;
-        processes[i].remaining_time = test_data[i].service_time;
-        processes[i].completion_time = 0;
-        processes[i].turnaround_time = 0;
-        processes[i].weighted_turnaround = 0.0f;
-        processes[i].waiting_time = 0;
-        processes[i].unix_pid = -1;  // 模拟进程
-        processes[i].next = NULL;
+        init_pcb(&processes[i], i + 1, test_data[i].name, test_data[i].priority,
+                 test_data[i].arrive_time, test_data[i].service_time);
     }
     
     return processes;
 }
 
+// 为一次调度模拟创建执行记录：每个时间单位最多产生一个执行段，容量取总服务时间
+static ExecTrace* create_trace_for(PCB *processes, int count) {
+    int total_service = 0;
+    for (int i = 0; i < count; i++) {
+        total_service += processes[i].service_time;
+    }
+    return create_exec_trace(total_service);
+}
+
 // 先来先服务 (FCFS) 调度算法
 void FCFS_scheduler(PCB *processes, int count) {
     clear_screen();
@@ -53,6 +65,7 @@ void FCFS_scheduler(PCB *processes, int count) {
     
     // 创建就绪队列
     ProcessQueue *ready_queue = create_queue();
+    ExecTrace *trace = create_trace_for(processes, count);
     
     // 按到达时间排序进程
     for (int i = 0; i < count; i++) {
@@ -91,17 +104,16 @@ void FCFS_scheduler(PCB *processes, int count) {
         if (current_process_idx == -1) {
             PCB *next = dequeue(ready_queue);
             if (next != NULL) {
-                for (int i = 0; i < count; i++) {
-                    if (processes[i].pid == next->pid) {
-                        current_process_idx = i;
-                        break;
-                    }
-                }
+                // 队列中的PCB就是 processes 数组的元素，直接由指针得到下标
+                current_process_idx = (int)(next - processes);
                 
                 print_colored("时间 %d: 调度进程[%d] %s 开始执行\n", 
                              GREEN, simulation_clock, processes[current_process_idx].pid, 
                              processes[current_process_idx].name);
                 processes[current_process_idx].status = PROCESS_RUNNING;
+                if (processes[current_process_idx].start_time < 0) {
+                    processes[current_process_idx].start_time = simulation_clock;
+                }
             }
         }
         
@@ -109,6 +121,8 @@ void FCFS_scheduler(PCB *processes, int count) {
         if (current_process_idx != -1) {
             // 执行一个时间单位
             processes[current_process_idx].remaining_time--;
+            trace_segment(trace, processes[current_process_idx].pid,
+                          simulation_clock, simulation_clock + 1);
             
             print_colored("时间 %d: 进程[%d] %s 正在执行，剩余时间: %d\n", 
                          CYAN, simulation_clock, processes[current_process_idx].pid, 
@@ -144,7 +158,7 @@ void FCFS_scheduler(PCB *processes, int count) {
         
         // 时钟前进
         simulation_clock++;
-        usleep(500000);  // 放慢显示速度
+        display_delay(500000);  // 放慢显示速度
     }
     
     print_colored("\nFCFS调度完成，所有进程已执行完毕\n", YELLOW);
@@ -153,10 +167,11 @@ void FCFS_scheduler(PCB *processes, int count) {
     calculate_statistics(processes, count);
     
     // 可视化时间线
-    visualize_execution_timeline(processes, count, simulation_clock);
+    visualize_execution_timeline(processes, count, trace, simulation_clock);
     
     // 清理资源
     destroy_queue(ready_queue);
+    destroy_exec_trace(trace);
 }
 
 // 时间片轮转 (RR) 调度算法
@@ -167,6 +182,7 @@ void RR_scheduler(PCB *processes, int count, int time_quantum) {
     
     // 创建就绪队列
     ProcessQueue *ready_queue = create_queue();
+    ExecTrace *trace = create_trace_for(processes, count);
     
     // 按到达时间排序进程
     for (int i = 0; i < count; i++) {
@@ -220,17 +236,16 @@ void RR_scheduler(PCB *processes, int count, int time_quantum) {
             // 从队列选取下一个进程
             PCB *next = dequeue(ready_queue);
             if (next != NULL) {
-                for (int i = 0; i < count; i++) {
-                    if (processes[i].pid == next->pid) {
-                        current_process_idx = i;
-                        break;
-                    }
-                }
+                // 队列中的PCB就是 processes 数组的元素，直接由指针得到下标
+                current_process_idx = (int)(next - processes);
                 
                 print_colored("时间 %d: 调度进程[%d] %s 开始执行\n", 
                              GREEN, simulation_clock, processes[current_process_idx].pid, 
                              processes[current_process_idx].name);
                 processes[current_process_idx].status = PROCESS_RUNNING;
+                if (processes[current_process_idx].start_time < 0) {
+                    processes[current_process_idx].start_time = simulation_clock;
+                }
             }
         }
         
@@ -238,6 +253,8 @@ void RR_scheduler(PCB *processes, int count, int time_quantum) {
         if (current_process_idx != -1) {
             // 执行一个时间单位
             processes[current_process_idx].remaining_time--;
+            trace_segment(trace, processes[current_process_idx].pid,
+                          simulation_clock, simulation_clock + 1);
             time_slice_used++;
             
             print_colored("时间 %d: 进程[%d] %s 正在执行，剩余时间: %d, 时间片: %d/%d\n", 
@@ -276,7 +293,7 @@ void RR_scheduler(PCB *processes, int count, int time_quantum) {
         
         // 时钟前进
         simulation_clock++;
-        usleep(500000);  // 放慢显示速度
+        display_delay(500000);  // 放慢显示速度
     }
     
     print_colored("\nRR调度完成，所有进程已执行完毕\n", YELLOW);
@@ -285,10 +302,11 @@ void RR_scheduler(PCB *processes, int count, int time_quantum) {
     calculate_statistics(processes, count);
     
     // 可视化时间线
-    visualize_execution_timeline(processes, count, simulation_clock);
+    visualize_execution_timeline(processes, count, trace, simulation_clock);
     
     // 清理资源
     destroy_queue(ready_queue);
+    destroy_exec_trace(trace);
 }
 
 // 优先级调度算法
@@ -309,6 +327,7 @@ void Priority_scheduler(PCB *processes, int count) {
     // 模拟时钟
     simulation_clock = 0;
     int completed = 0;
+    ExecTrace *trace = create_trace_for(processes, count);
     
     while (completed < count) {
         // 检查到达系统的新进程
@@ -341,6 +360,7 @@ void Priority_scheduler(PCB *processes, int count) {
                          processes[highest_priority_idx].priority);
             
             processes[highest_priority_idx].status = PROCESS_RUNNING;
+            processes[highest_priority_idx].start_time = simulation_clock;
             
             // 非抢占式优先级调度，执行直到完成
             int execution_time = processes[highest_priority_idx].remaining_time;
@@ -351,10 +371,12 @@ void Priority_scheduler(PCB *processes, int count) {
                 print_colored("时间 %d: 进程[%d] %s 正在执行，剩余时间: %d\n", 
                              CYAN, simulation_clock + t, processes[highest_priority_idx].pid, 
                              processes[highest_priority_idx].name, execution_time - t);
-                usleep(500000);  // 放慢显示速度
+                display_delay(500000);  // 放慢显示速度
             }
             
             // 更新完成时间
+            trace_segment(trace, processes[highest_priority_idx].pid,
+                          simulation_clock, simulation_clock + execution_time);
             simulation_clock += execution_time;
             processes[highest_priority_idx].status = PROCESS_TERMINATED;
             processes[highest_priority_idx].completion_time = simulation_clock;
@@ -389,7 +411,8 @@ void Priority_scheduler(PCB *processes, int count) {
     calculate_statistics(processes, count);
     
     // 可视化时间线
-    visualize_execution_timeline(processes, count, simulation_clock);
+    visualize_execution_timeline(processes, count, trace, simulation_clock);
+    destroy_exec_trace(trace);
 }
 
 // 短作业优先调度算法
@@ -407,6 +430,7 @@ void SJF_scheduler(PCB *processes, int count) {
     // 模拟时钟
     simulation_clock = 0;
     int completed = 0;
+    ExecTrace *trace = create_trace_for(processes, count);
     
     while (completed < count) {
         // 检查到达系统的新进程
@@ -439,6 +463,7 @@ void SJF_scheduler(PCB *processes, int count) {
                          processes[shortest_job_idx].service_time);
             
             processes[shortest_job_idx].status = PROCESS_RUNNING;
+            processes[shortest_job_idx].start_time = simulation_clock;
             
             // 非抢占式SJF，执行直到完成
             int execution_time = processes[shortest_job_idx].remaining_time;
@@ -449,10 +474,12 @@ void SJF_scheduler(PCB *processes, int count) {
                 print_colored("时间 %d: 进程[%d] %s 正在执行，剩余时间: %d\n", 
                              CYAN, simulation_clock + t, processes[shortest_job_idx].pid, 
                              processes[shortest_job_idx].name, execution_time - t);
-                usleep(500000);  // 放慢显示速度
+                display_delay(500000);  // 放慢显示速度
             }
             
             // 更新完成时间
+            trace_segment(trace, processes[shortest_job_idx].pid,
+                          simulation_clock, simulation_clock + execution_time);
             simulation_clock += execution_time;
             processes[shortest_job_idx].status = PROCESS_TERMINATED;
             processes[shortest_job_idx].completion_time = simulation_clock;
@@ -487,27 +514,63 @@ void SJF_scheduler(PCB *processes, int count) {
     calculate_statistics(processes, count);
     
     // 可视化时间线
-    visualize_execution_timeline(processes, count, simulation_clock);
+    visualize_execution_timeline(processes, count, trace, simulation_clock);
+    destroy_exec_trace(trace);
+}
+
+// 使用模拟引擎运行调度算法并显示调度事件和统计结果
+void engine_scheduler(PCB *processes, int count, SchedConfig *config, const char *title) {
+    clear_screen();
+    print_title(title);
+    
+    print_colored("初始进程状态:\n", CYAN);
+    for (int i = 0; i < count; i++) {
+        print_process_info(&processes[i]);
+    }
+    
+    print_colored("\n开始%s调度模拟...\n", YELLOW, sched_algorithm_name(config->algorithm));
+    
+    ExecTrace *trace = create_trace_for(processes, count);
+    config->verbose = 1;
+    config->trace = trace;
+    simulation_clock = run_simulation(processes, count, config);
+    config->trace = NULL;
+    if (simulation_clock < 0) {
+        print_colored("调度模拟失败\n", RED);
+        destroy_exec_trace(trace);
+        return;
+    }
+    
+    print_colored("\n%s调度完成，所有进程已执行完毕\n", YELLOW, sched_algorithm_name(config->algorithm));
+    
+    // 打印统计信息
+    calculate_statistics(processes, count);
+    
+    // 可视化时间线
+    visualize_execution_timeline(processes, count, trace, simulation_clock);
+    destroy_exec_trace(trace);
 }
 
-// 演示进程创建与撤销
+// 演示进程创建与撤销：先比较各种创建方式的延迟，再演示 create_process 使用预派生进程池
 void demo_process_creation() {
     clear_screen();
-    print_title("进程创建与撤销演示");
+    print_title("进程创建与撤销基准");
     
-    print_colored("创建几个示例进程...\n", YELLOW);
+    char *args[] = {"process_scheduler", "-n", "1000"};
+    spawn_main(3, args);
+    
+    print_colored("\n启动预派生进程池，create_process 将直接使用池中的子进程...\n", YELLOW);
+    process_pool_start(3);
     
     PCB *p1 = create_process("进程1", 5, 3);
     PCB *p2 = create_process("进程2", 3, 2);
     PCB *p3 = create_process("进程3", 7, 4);
     
-    print_colored("\n进程创建完成，等待子进程执行...\n", YELLOW);
-    sleep(2);
-    
     print_colored("\n开始回收进程资源...\n", YELLOW);
     terminate_process(p1);
     terminate_process(p2);
     terminate_process(p3);
+    process_pool_stop();
     
     print_colored("\n所有进程已撤销\n", GREEN);
     
@@ -522,6 +585,8 @@ void show_scheduler_menu() {
     int choice = 0;
     char buffer[100];
     
+    // 菜单在备用屏幕中显示，退出后恢复原来的终端内容
+    enter_alternate_screen();
     while (1) {
         clear_screen();
         print_title("操作系统进程管理模拟系统");
@@ -529,12 +594,23 @@ void show_scheduler_menu() {
         print_colored("┌─────────────────────────────┐\n", CYAN);
         print_colored("│       主菜单                │\n", CYAN);
         print_colored("├─────────────────────────────┤\n", CYAN);
-        print_colored("│ 1. 演示进程创建与撤销        │\n", WHITE);
+        print_colored("│ 1. 进程创建与撤销基准        │\n", WHITE);
         print_colored("│ 2. 先来先服务(FCFS)调度算法  │\n", WHITE);
         print_colored("│ 3. 时间片轮转(RR)调度算法    │\n", WHITE);
         print_colored("│ 4. 优先级调度算法           │\n", WHITE);
         print_colored("│ 5. 短作业优先(SJF)调度算法   │\n", WHITE);
         print_colored("│ 6. 银行账户管理系统         │\n", WHITE);
+        print_colored("│ 7. 调度参数扫描实验         │\n", WHITE);
+        print_colored("│ 8. 多级反馈队列(MLFQ)调度    │\n", WHITE);
+        print_colored("│ 9. 最短剩余时间优先(SRTF)    │\n", WHITE);
+        print_colored("│ 10. 抢占式优先级(老化)       │\n", WHITE);
+        print_colored("│ 11. 多核调度模拟            │\n", WHITE);
+        print_colored("│ 12. 完全公平调度(CFS)       │\n", WHITE);
+        print_colored("│ 13. 步长调度(Stride)        │\n", WHITE);
+        print_colored("│ 14. 彩票调度(Lottery)       │\n", WHITE);
+        print_colored("│ 15. 真实进程调度(信号驱动)  │\n", WHITE);
+        print_colored("│ 16. 最早截止期限优先(EDF)   │\n", WHITE);
+        print_colored("│ 17. I/O阻塞与设备队列       │\n", WHITE);
         print_colored("│ 0. 退出                    │\n", WHITE);
         print_colored("└─────────────────────────────┘\n", CYAN);
         print_colored("请选择操作: ", YELLOW);
@@ -584,10 +660,147 @@ void show_scheduler_menu() {
                 break;
             }
             case 6:
-                // 运行原来的银行账户系统
+                // 运行原来的银行账户系统，它会使用自己的备用屏幕
+                leave_alternate_screen();
                 system("./bank_system");
+                enter_alternate_screen();
+                break;
+            case 7: {
+                print_colored("请输入生成的进程数量: ", YELLOW);
+                int count = 10000; // 默认值
+                if (fgets(buffer, sizeof(buffer), stdin) && atoi(buffer) > 0) {
+                    count = atoi(buffer);
+                }
+                char count_arg[16];
+                snprintf(count_arg, sizeof(count_arg), "%d", count);
+                char *args[] = {"process_scheduler", "-n", count_arg};
+                sweep_main(3, args);
+                break;
+            }
+            case 8: {
+                int count;
+                PCB *processes = create_test_processes(&count);
+                print_colored("请输入第0级时间片大小: ", YELLOW);
+                int quantum = 1; // 默认值
+                if (fgets(buffer, sizeof(buffer), stdin)) {
+                    quantum = atoi(buffer);
+                }
+                if (quantum < 1) quantum = 1;
+                SchedConfig config = { .algorithm = ALGO_MLFQ, .time_quantum = quantum,
+                                       .mlfq_levels = 3, .boost_interval = 10 };
+                engine_scheduler(processes, count, &config, "多级反馈队列 (MLFQ) 调度算法模拟");
+                free(processes);
+                break;
+            }
+            case 9: {
+                int count;
+                PCB *processes = create_test_processes(&count);
+                SchedConfig config = { .algorithm = ALGO_SRTF };
+                engine_scheduler(processes, count, &config, "最短剩余时间优先 (SRTF) 调度算法模拟");
+                free(processes);
+                break;
+            }
+            case 10: {
+                int count;
+                PCB *processes = create_test_processes(&count);
+                print_colored("请输入老化周期 (每等待多少时间单位优先级加1，0表示不老化): ", YELLOW);
+                int aging = 2; // 默认值
+                if (fgets(buffer, sizeof(buffer), stdin)) {
+                    aging = atoi(buffer);
+                }
+                SchedConfig config = { .algorithm = ALGO_PRIORITY_AGING, .aging_interval = aging };
+                engine_scheduler(processes, count, &config, "抢占式优先级调度算法模拟 (老化)");
+                free(processes);
                 break;
+            }
+            case 11: {
+                print_colored("请输入核数: ", YELLOW);
+                int cpus = 4; // 默认值
+                if (fgets(buffer, sizeof(buffer), stdin) && atoi(buffer) > 0) {
+                    cpus = atoi(buffer);
+                }
+                char cpu_arg[16];
+                snprintf(cpu_arg, sizeof(cpu_arg), "%d", cpus);
+                char *args[] = {"process_scheduler", "-n", "10000", "-c", cpu_arg};
+                multicore_main(5, args);
+                break;
+            }
+            case 12: {
+                int count;
+                PCB *processes = create_test_processes(&count);
+                SchedConfig config = { .algorithm = ALGO_CFS, .min_granularity = 1, .target_latency = 6 };
+                engine_scheduler(processes, count, &config, "完全公平调度 (CFS) 算法模拟");
+                free(processes);
+                break;
+            }
+            case 13:
+            case 14: {
+                int count;
+                PCB *processes = create_test_processes(&count);
+                print_colored("请输入时间片大小: ", YELLOW);
+                int quantum = 1; // 默认值
+                if (fgets(buffer, sizeof(buffer), stdin)) {
+                    quantum = atoi(buffer);
+                }
+                if (quantum < 1) quantum = 1;
+                SchedConfig config = { .algorithm = choice == 13 ? ALGO_STRIDE : ALGO_LOTTERY,
+                                       .time_quantum = quantum, .random_seed = (unsigned int)time(NULL) };
+                engine_scheduler(processes, count, &config, choice == 13 ? "步长调度 (Stride) 算法模拟"
+                                                                         : "彩票调度 (Lottery) 算法模拟");
+                free(processes);
+                break;
+            }
+            case 15: {
+                print_colored("请输入调度算法 (FCFS/RR/Priority/SJF): ", YELLOW);
+                char algorithm[32] = "RR"; // 默认值
+                if (fgets(buffer, sizeof(buffer), stdin) && sscanf(buffer, "%31s", algorithm) != 1) {
+                    strcpy(algorithm, "RR");
+                }
+                char *args[] = {"process_scheduler", "-a", algorithm, "-q", "2", "-u", "20"};
+                real_main(7, args);
+                break;
+            }
+            case 16: {
+                int count;
+                PCB *processes = create_test_processes(&count);
+                for (int i = 0; i < count; i++) {
+                    processes[i].deadline = processes[i].service_time * 2;
+                }
+                DeadlineStats stats;
+                deadline_stats_init(&stats);
+                SchedConfig config = { .algorithm = ALGO_EDF, .admission_control = 1, .deadline_stats = &stats };
+                engine_scheduler(processes, count, &config, "最早截止期限优先 (EDF) 调度算法模拟");
+                print_deadline_stats(&stats);
+                free(processes);
+                
+                print_colored("\n不同负载下 EDF 与优先级调度的对比:\n", YELLOW);
+                char *args[] = {"process_scheduler", "-n", "10000"};
+                deadline_main(3, args);
+                break;
+            }
+            case 17: {
+                int count;
+                PCB *processes = create_test_processes(&count);
+                // 进程A、C、E为I/O密集型，分别使用设备0、1、0
+                for (int i = 0; i < count; i += 2) {
+                    processes[i].cpu_burst = 1;
+                    processes[i].io_device = i / 2 % 2;
+                }
+                IoStats io;
+                io_stats_init(&io);
+                SchedConfig config = { .algorithm = ALGO_RR, .time_quantum = 2, .io_devices = 2,
+                                       .io_latency = {3, 2}, .io_stats = &io };
+                engine_scheduler(processes, count, &config, "I/O阻塞与设备队列模拟 (RR)");
+                print_io_stats(&io, simulation_clock);
+                free(processes);
+                
+                print_colored("\n各调度算法在I/O密集型工作负载上的表现:\n", YELLOW);
+                char *args[] = {"process_scheduler", "-n", "5000"};
+                io_main(3, args);
+                break;
+            }
             case 0:
+                leave_alternate_screen();
                 print_colored("谢谢使用，再见!\n", GREEN);
                 return;
             default:
@@ -599,7 +812,66 @@ void show_scheduler_menu() {
     }
 }
 
-int main() {
-    show_scheduler_menu();
-    return 0;
+// 子命令表，按名称分发
+typedef struct {
+    const char *name;
+    int (*main)(int argc, char *argv[]);
+} SubCommand;
+
+static const SubCommand sub_commands[] = {
+    { "sweep", sweep_main },
+    { "fairness", fairness_main },
+    { "share", share_main },
+    { "deadline", deadline_main },
+    { "io", io_main },
+    { "checkpoint", checkpoint_main },
+    { "mpmc", mpmc_main },
+    { "spawn", spawn_main },
+    { "real", real_main },
+    { "multicore", multicore_main },
+    { "export", export_main },
+};
+
+// 按子命令分发，没有参数时进入交互式菜单
+static int run_command(int argc, char *argv[]) {
+    if (argc == 1) {
+        show_scheduler_menu();
+        return 0;
+    }
+
+    // 子命令收到的 argv[0] 仍是程序名，用法提示显示为 "process_scheduler sweep ..."
+    const char *command = argv[1];
+    for (size_t i = 0; i < sizeof(sub_commands) / sizeof(sub_commands[0]); i++) {
+        if (strcmp(command, sub_commands[i].name) == 0) {
+            argv[1] = argv[0];
+            return sub_commands[i].main(argc - 1, argv + 1);
+        }
+    }
+
+    print_colored("未知子命令: %s\n", RED, command);
+    print_colored("用法: %s [指标导出选项] [子命令 [选项]]，不带参数时进入交互式菜单\n", YELLOW, argv[0]);
+    print_colored("子命令:", WHITE);
+    for (size_t i = 0; i < sizeof(sub_commands) / sizeof(sub_commands[0]); i++) {
+        print_colored(" %s", WHITE, sub_commands[i].name);
+    }
+    print_colored("\n", WHITE);
+    return 1;
+}
+
+int main(int argc, char *argv[]) {
+    // 子命令之前可以加指标导出选项：process_scheduler [-m 地址] [-o 文件] [-i 毫秒] [-w 秒] [子命令 ...]
+    int used = metrics_options(argc, argv);
+    if (used < 0) {
+        print_colored("用法: %s [指标导出选项] [子命令 [选项]]\n", YELLOW, argv[0]);
+        print_metrics_usage();
+        return 1;
+    }
+    if (metrics_enabled()) {
+        simulator_register_metrics();
+    }
+    argv[used] = argv[0];
+
+    int result = run_command(argc - used, argv + used);
+    metrics_shutdown();
+    return result;
 }
\ No newline at end of file
@@ -0,0 +1,138 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "process_control.h"
+#include "share.h"
+#include "simulator.h"
+#include "timeutil.h"
+#include "visualization.h"
+
+/**
+ * 份额实验命令行入口：所有进程在时刻0到达且在截止时刻前都不会完成，
+ * 以优先级为彩票数，比较 Stride 与 Lottery 实际获得的CPU份额与目标份额的偏差
+ * @return 进程退出码
+ */
+int share_main(int argc, char *argv[]) {
+    int count = 10000;
+    unsigned int seed = 1;
+    int horizon = 0;
+    int quantum = 1;
+    int shown = 10;
+    SchedConfig configs[2] = {
+        { .algorithm = ALGO_STRIDE },
+        { .algorithm = ALGO_LOTTERY }
+    };
+
+    for (int i = 1; i < argc; i += 2) {
+        const char *opt = argv[i];
+        const char *value = (i + 1 < argc) ? argv[i + 1] : NULL;
+
+        if (value == NULL || opt[0] != '-' || opt[1] == '\0' || opt[2] != '\0') {
+            print_colored("用法: %s share [-n 数量] [-s 种子] [-t 截止时刻] [-q 时间片] [-p 展示进程数]\n",
+                         YELLOW, argv[0]);
+            return 1;
+        }
+
+        switch (opt[1]) {
+            case 'n': count = atoi(value); break;
+            case 's': seed = (unsigned int)strtoul(value, NULL, 10); break;
+            case 't': horizon = atoi(value); break;
+            case 'q': quantum = atoi(value); break;
+            case 'p': shown = atoi(value); break;
+            default:
+                print_colored("未知选项: %s\n", RED, opt);
+                return 1;
+        }
+    }
+    if (count <= 0) {
+        print_colored("进程数量必须大于0\n", RED);
+        return 1;
+    }
+    if (horizon <= 0) {
+        horizon = count * 100;  // 平均每张彩票约获得18个时间单位
+    }
+    if (shown > count) shown = count;
+
+    PCB *workload = generate_workload(count, seed);
+    PCB *processes = (PCB*)malloc(sizeof(PCB) * count);
+    double *achieved = (double*)malloc(sizeof(double) * count * 2);
+    if (workload == NULL || processes == NULL || achieved == NULL) {
+        free(workload);
+        free(processes);
+        free(achieved);
+        return 1;
+    }
+
+    long long total_tickets = 0;
+    for (int i = 0; i < count; i++) {
+        workload[i].arrive_time = 0;
+        workload[i].service_time = horizon + 1;
+        workload[i].remaining_time = horizon + 1;
+        total_tickets += priority_to_tickets(workload[i].priority);
+    }
+
+    print_colored("份额实验: %d 个可运行进程, 总彩票 %lld, 截止时刻 %d, 时间片 %d\n", CYAN,
+                 count, total_tickets, horizon, quantum);
+    print_colored("----------------------------------------------------------------------------------\n", WHITE);
+    print_colored("| %-8s | %-10s | %-12s | %-12s | %-12s | %-8s |\n", WHITE,
+                 "算法", "决策次数", "平均相对误差", "最大相对误差", "误差>10%占比", "耗时ms");
+    print_colored("----------------------------------------------------------------------------------\n", WHITE);
+
+    int was_quiet = is_quiet_mode();
+    for (int k = 0; k < 2; k++) {
+        memcpy(processes, workload, sizeof(PCB) * count);
+        configs[k].time_quantum = quantum;
+        configs[k].time_limit = horizon;
+        configs[k].random_seed = seed;
+
+        set_quiet_mode(1);
+        double start = now_ms();
+        int result = run_simulation(processes, count, &configs[k]);
+        double elapsed = now_ms() - start;
+        set_quiet_mode(was_quiet);
+
+        if (result < 0) {
+            print_colored("| %-8s | 模拟失败\n", RED, sched_algorithm_name(configs[k].algorithm));
+            continue;
+        }
+
+        // 实际份额 = 获得的CPU时间 / 截止时刻；目标份额 = 彩票数 / 总彩票数
+        long long decisions = 0;
+        double sum_error = 0.0, max_error = 0.0;
+        int off = 0;
+        for (int i = 0; i < count; i++) {
+            double target = (double)priority_to_tickets(processes[i].priority) / total_tickets;
+            double share = (double)(processes[i].service_time - processes[i].remaining_time) / result;
+            double error = fabs(share - target) / target;
+
+            achieved[k * count + i] = share;
+            decisions += processes[i].dispatch_count;
+            sum_error += error;
+            if (error > max_error) max_error = error;
+            if (error > 0.1) off++;
+        }
+
+        print_colored("| %-8s | %-10lld | %-11.2f%% | %-11.2f%% | %-11.2f%% | %-8.1f |\n", WHITE,
+                     sched_algorithm_name(configs[k].algorithm), decisions,
+                     sum_error / count * 100, max_error * 100, off * 100.0 / count, elapsed);
+    }
+    print_colored("----------------------------------------------------------------------------------\n", WHITE);
+
+    if (shown > 0) {
+        print_colored("\n前 %d 个进程的份额 (%%):\n", CYAN, shown);
+        print_colored("| %-6s | %-6s | %-10s | %-10s | %-10s |\n", WHITE,
+                     "PID", "彩票", "目标", "Stride", "Lottery");
+        for (int i = 0; i < shown; i++) {
+            int tickets = priority_to_tickets(workload[i].priority);
+            print_colored("| %-6d | %-6d | %-10.5f | %-10.5f | %-10.5f |\n", WHITE,
+                         workload[i].pid, tickets, (double)tickets / total_tickets * 100,
+                         achieved[i] * 100, achieved[count + i] * 100);
+        }
+    }
+
+    free(achieved);
+    free(processes);
+    free(workload);
+    return 0;
+}
@@ -0,0 +1,7 @@
+#ifndef SHARE_H
+#define SHARE_H
+
+// 份额实验命令行入口：Stride 与 Lottery 实际获得的CPU份额与目标份额的偏差
+int share_main(int argc, char *argv[]);
+
+#endif // SHARE_H
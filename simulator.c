@@ -0,0 +1,1553 @@
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <time.h>
+#include "checkpoint.h"
+#include "dashboard.h"
+#include "metrics.h"
+#include "process_control.h"
+#include "rbtree.h"
+#include "simulator.h"
+#include "timeutil.h"
+#include "visualization.h"
+
+// 算法名称，与 SchedAlgorithm 顺序一致
+static const char *algorithm_names[ALGO_COUNT] = {
+    "FCFS", "RR", "Priority", "SJF", "MLFQ", "SRTF", "PrioAging", "CFS", "Stride", "Lottery", "EDF"
+};
+
+// 以PCB数组下标为元素的小根堆，按 keys[下标] 排序，键相同时下标小者优先
+// 进程在堆中时不得修改其键
+typedef struct {
+    int *items;
+    int size;
+    const long long *keys;
+} IndexHeap;
+
+static int heap_init(IndexHeap *heap, int capacity) {
+    heap->items = (int*)malloc(sizeof(int) * (capacity > 0 ? capacity : 1));
+    heap->size = 0;
+    heap->keys = NULL;
+    return heap->items == NULL ? -1 : 0;
+}
+
+static int heap_less(const IndexHeap *heap, int a, int b) {
+    if (heap->keys[a] != heap->keys[b]) {
+        return heap->keys[a] < heap->keys[b];
+    }
+    return a < b;
+}
+
+static void heap_push(IndexHeap *heap, int idx) {
+    int pos = heap->size++;
+
+    // 上浮
+    while (pos > 0) {
+        int parent = (pos - 1) / 2;
+        if (!heap_less(heap, idx, heap->items[parent])) break;
+        heap->items[pos] = heap->items[parent];
+        pos = parent;
+    }
+    heap->items[pos] = idx;
+}
+
+static int heap_pop(IndexHeap *heap) {
+    int top = heap->items[0];
+    int last = heap->items[--heap->size];
+    int pos = 0;
+
+    // 下沉
+    while (1) {
+        int child = pos * 2 + 1;
+        if (child >= heap->size) break;
+        if (child + 1 < heap->size && heap_less(heap, heap->items[child + 1], heap->items[child])) {
+            child++;
+        }
+        if (!heap_less(heap, heap->items[child], last)) break;
+        heap->items[pos] = heap->items[child];
+        pos = child;
+    }
+    if (heap->size > 0) {
+        heap->items[pos] = last;
+    }
+    return top;
+}
+
+static int compare_keys(const void *a, const void *b) {
+    long long x = *(const long long*)a;
+    long long y = *(const long long*)b;
+    return (x > y) - (x < y);
+}
+
+/**
+ * 按 (到达时间, 下标) 排序
+ * @return 新分配的下标数组，失败返回NULL
+ */
+int* sort_by_arrival(const PCB *processes, int count) {
+    long long *keys = (long long*)malloc(sizeof(long long) * count);
+    int *order = (int*)malloc(sizeof(int) * count);
+    if (keys == NULL || order == NULL) {
+        free(keys);
+        free(order);
+        return NULL;
+    }
+
+    for (int i = 0; i < count; i++) {
+        keys[i] = ((long long)processes[i].arrive_time << 32) | (unsigned int)i;
+    }
+    qsort(keys, count, sizeof(long long), compare_keys);
+    for (int i = 0; i < count; i++) {
+        order[i] = (int)(keys[i] & 0xffffffffLL);
+    }
+
+    free(keys);
+    return order;
+}
+
+// 各算法导出的指标，simulator_register_metrics 之前都是NULL
+static Metric *simulations_metrics[ALGO_COUNT];
+static Metric *dispatch_metrics[ALGO_COUNT];
+static Metric *completed_metrics[ALGO_COUNT];
+static Metric *ticks_metrics[ALGO_COUNT];
+static Metric *clock_metrics[ALGO_COUNT];
+static Metric *waiting_metrics[ALGO_COUNT];
+static Metric *turnaround_metrics[ALGO_COUNT];
+
+/**
+ * 注册调度模拟的指标，按算法分别计数。模拟循环只更新原子变量，抓取不会使模拟停顿
+ */
+void simulator_register_metrics() {
+    static const double time_bounds[] = { 1, 4, 16, 64, 256, 1024, 4096, 16384, 65536, 262144 };
+    const int num_bounds = sizeof(time_bounds) / sizeof(time_bounds[0]);
+
+    for (int i = 0; i < ALGO_COUNT; i++) {
+        char labels[64];
+        snprintf(labels, sizeof(labels), "algorithm=\"%s\"", algorithm_names[i]);
+        simulations_metrics[i] = metrics_counter("sched_simulations_total", "完成的模拟次数", labels);
+        dispatch_metrics[i] = metrics_counter("sched_dispatches_total", "调度决策次数", labels);
+        completed_metrics[i] = metrics_counter("sched_completed_total", "完成的进程数", labels);
+        ticks_metrics[i] = metrics_counter("sched_simulated_time_total", "CPU执行的模拟时间单位", labels);
+        clock_metrics[i] = metrics_gauge("sched_clock", "最近一个进程完成时的模拟时钟", labels);
+        waiting_metrics[i] = metrics_histogram("sched_waiting_time", "进程等待时间（模拟时间单位）", labels,
+                                               time_bounds, num_bounds);
+        turnaround_metrics[i] = metrics_histogram("sched_turnaround_time", "进程周转时间（模拟时间单位）",
+                                                  labels, time_bounds, num_bounds);
+    }
+}
+
+// 进程完成时填写统计字段
+static void finish_process(PCB *p, int clock, const SchedConfig *config) {
+    record_completion(p, clock);
+    metric_inc(completed_metrics[config->algorithm], 1);
+    metric_set(clock_metrics[config->algorithm], clock);
+    metric_observe(waiting_metrics[config->algorithm], p->waiting_time);
+    metric_observe(turnaround_metrics[config->algorithm], p->turnaround_time);
+    if (config->stats != NULL) {
+        completion_stats_record(config->stats, p);
+    }
+    if (config->deadline_stats != NULL) {
+        deadline_stats_record(config->deadline_stats, p);
+    }
+
+    if (config->verbose) {
+        print_colored("时间 %d: 进程[%d] %s 执行完成\n", GREEN, clock, p->pid, p->name);
+    }
+}
+
+// 进程获得CPU，首次运行时记录开始时间
+static void dispatch_process(PCB *p, int clock, const SchedConfig *config) {
+    p->status = PROCESS_RUNNING;
+    p->dispatch_count++;
+    metric_inc(dispatch_metrics[config->algorithm], 1);
+    if (p->start_time < 0) {
+        p->start_time = clock;
+    }
+
+    if (config->verbose) {
+        print_colored("时间 %d: 调度进程[%d] %s 开始执行，剩余时间: %d\n",
+                     CYAN, clock, p->pid, p->name, p->remaining_time);
+    }
+}
+
+// 进程从 clock 开始执行 ran 个时间单位：扣减剩余时间、按权重累计虚拟运行时间，并记录执行段和CPU忙碌时间
+static void charge_runtime(PCB *p, int clock, int ran, const SchedConfig *config) {
+    if (config->trace != NULL) {
+        trace_segment(config->trace, p->pid, clock, clock + ran);
+    }
+    if (config->io_stats != NULL) {
+        io_stats_record_cpu(config->io_stats, clock, ran);
+    }
+    dashboard_count(DASH_TICKS, ran);
+    metric_inc(ticks_metrics[config->algorithm], ran);
+    p->remaining_time -= ran;
+    p->vruntime += (long long)ran * NICE_0_LOAD * NICE_0_LOAD / priority_to_weight(p->priority);
+}
+
+// 是否已到达模拟截止时刻
+static int time_limit_reached(int clock, const SchedConfig *config) {
+    return config->time_limit > 0 && clock >= config->time_limit;
+}
+
+// 把一次运行的长度截断到模拟截止时刻
+static int clamp_to_limit(int clock, int run, const SchedConfig *config) {
+    if (config->time_limit > 0 && clock + run > config->time_limit) {
+        return config->time_limit - clock;
+    }
+    return run;
+}
+
+// 就绪事件源：按时间顺序合并新进程到达与I/O完成唤醒，所有调度算法都通过它接纳进程。
+// 设备按FIFO服务且每个请求耗时固定，只需记录每个设备处理完已提交请求的时刻即可得到完成时间
+typedef struct {
+    PCB *processes;
+    int count;
+    const int *order;           // 按到达时间排序的下标
+    int next_arrival;           // order 中下一个尚未到达的位置
+    int io;                     // 是否模拟I/O
+    IndexHeap blocked;          // 阻塞进程，按I/O完成时刻排序
+    long long *wake_time;       // 各进程本次I/O的完成时刻
+    int device_free[IO_MAX_DEVICES];
+    const SchedConfig *config;
+} EventSource;
+
+static void events_destroy(EventSource *ev) {
+    free(ev->blocked.items);
+    free(ev->wake_time);
+    ev->blocked.items = NULL;
+    ev->wake_time = NULL;
+}
+
+static int events_init(EventSource *ev, PCB *processes, int count, const int *order, const SchedConfig *config) {
+    ev->processes = processes;
+    ev->count = count;
+    ev->order = order;
+    ev->next_arrival = 0;
+    ev->io = config->io_devices > 0;
+    ev->blocked.items = NULL;
+    ev->blocked.size = 0;
+    ev->wake_time = NULL;
+    memset(ev->device_free, 0, sizeof(ev->device_free));
+    ev->config = config;
+
+    if (!ev->io) return 0;
+
+    ev->wake_time = (long long*)malloc(sizeof(long long) * count);
+    if (heap_init(&ev->blocked, count) != 0 || ev->wake_time == NULL) {
+        events_destroy(ev);
+        return -1;
+    }
+    ev->blocked.keys = ev->wake_time;
+    return 0;
+}
+
+// 下一个到达或唤醒的时刻，没有后续事件时返回 INT_MAX
+static int events_next_time(const EventSource *ev) {
+    int next = INT_MAX;
+    if (ev->next_arrival < ev->count) {
+        next = ev->processes[ev->order[ev->next_arrival]].arrive_time;
+    }
+    if (ev->blocked.size > 0 && ev->wake_time[ev->blocked.items[0]] < next) {
+        next = (int)ev->wake_time[ev->blocked.items[0]];
+    }
+    return next;
+}
+
+// 取出一个不晚于 clock 到达或完成I/O的进程下标，没有时返回-1；同一时刻新到达的进程优先
+static int events_next_ready(EventSource *ev, int clock) {
+    if (ev->next_arrival < ev->count) {
+        int idx = ev->order[ev->next_arrival];
+        PCB *p = &ev->processes[idx];
+        if (p->arrive_time <= clock &&
+            (ev->blocked.size == 0 || p->arrive_time <= ev->wake_time[ev->blocked.items[0]])) {
+            ev->next_arrival++;
+            p->burst_left = p->cpu_burst;
+            return idx;
+        }
+    }
+
+    if (ev->blocked.size > 0 && ev->wake_time[ev->blocked.items[0]] <= clock) {
+        int idx = heap_pop(&ev->blocked);
+        PCB *p = &ev->processes[idx];
+        p->status = PROCESS_READY;
+        p->burst_left = p->cpu_burst;
+        if (ev->config->verbose) {
+            print_colored("时间 %lld: 进程[%d] %s I/O完成，重新就绪\n",
+                         BLUE, ev->wake_time[idx], p->pid, p->name);
+        }
+        return idx;
+    }
+    return -1;
+}
+
+// 把一次运行截断到当前CPU突发的剩余长度
+static int clamp_to_burst(const EventSource *ev, const PCB *p, int run) {
+    if (ev->io && p->cpu_burst > 0 && p->burst_left < run) {
+        return p->burst_left;
+    }
+    return run;
+}
+
+// 进程运行 ran 个时间单位后仍未完成：若当前CPU突发已用完，则向设备提交I/O请求并进入阻塞状态
+// @return 进程是否被阻塞
+static int block_for_io(EventSource *ev, int idx, int clock, int ran) {
+    PCB *p = &ev->processes[idx];
+    if (!ev->io || p->cpu_burst <= 0) return 0;
+
+    p->burst_left -= ran;
+    if (p->burst_left > 0) return 0;
+
+    const SchedConfig *config = ev->config;
+    int device = p->io_device % config->io_devices;
+    int latency = config->io_latency[device] > 0 ? config->io_latency[device] : IO_DEFAULT_LATENCY;
+    int start = ev->device_free[device] > clock ? ev->device_free[device] : clock;
+    int depth = (start - clock + latency - 1) / latency + 1;   // 含本次请求在内的队列长度
+
+    ev->device_free[device] = start + latency;
+    ev->wake_time[idx] = start + latency;
+    heap_push(&ev->blocked, idx);
+    p->status = PROCESS_BLOCKED;
+    p->io_time += start + latency - clock;
+
+    if (config->io_stats != NULL) {
+        io_stats_record_request(config->io_stats, clock, start, start + latency, depth);
+    }
+    if (config->verbose) {
+        print_colored("时间 %d: 进程[%d] %s 请求设备%d，阻塞至 %d\n",
+                     MAGENTA, clock, p->pid, p->name, device, start + latency);
+    }
+    return 1;
+}
+
+// 恢复时依次取出已到达且处于就绪状态的进程下标（从 *pos 开始），没有时返回-1，
+// 用于重建按键排序的就绪结构，其中元素的出队顺序与插入顺序无关
+static int events_next_restored(const EventSource *ev, int *pos) {
+    while (*pos < ev->next_arrival) {
+        int idx = ev->order[(*pos)++];
+        if (ev->processes[idx].status == PROCESS_READY) return idx;
+    }
+    return -1;
+}
+
+// 从检查点恢复事件源：阻塞进程按I/O完成时刻重新入堆，已完成进程重新计入完成统计
+static void events_restore(EventSource *ev, const SimSnapshot *snap) {
+    const SchedConfig *config = ev->config;
+    ev->next_arrival = snap->next_arrival;
+    memcpy(ev->device_free, snap->device_free, sizeof(ev->device_free));
+
+    for (int i = 0; i < ev->count; i++) {
+        PCB *p = &ev->processes[i];
+        if (p->status == PROCESS_BLOCKED && ev->io && snap->wake_time != NULL) {
+            ev->wake_time[i] = snap->wake_time[i];
+            heap_push(&ev->blocked, i);
+        } else if (p->status == PROCESS_TERMINATED) {
+            if (config->stats != NULL) {
+                completion_stats_record(config->stats, p);
+            }
+            if (config->deadline_stats != NULL) {
+                deadline_stats_record(config->deadline_stats, p);
+            }
+        }
+    }
+
+    if (config->deadline_stats != NULL) {
+        config->deadline_stats->rejected += snap->deadline_rejected;
+    }
+    if (config->io_stats != NULL && snap->io_stats != NULL) {
+        *config->io_stats = *snap->io_stats;
+    }
+}
+
+// 按检查点中的顺序重建就绪队列，levels 非NULL时各进程放入其所在级别的队列；入队失败返回-1
+static int restore_queues(ProcessQueue **queues, const int *levels, PCB *processes, const SimSnapshot *snap) {
+    for (int k = 0; k < snap->queue_length; k++) {
+        int idx = snap->queue[k];
+        if (enqueue(queues[levels != NULL ? levels[idx] : 0], &processes[idx]) != 0) return -1;
+    }
+    return 0;
+}
+
+// 是否应在本次调度循环开始处写检查点
+static int checkpoint_due(int clock, const SchedConfig *config) {
+    const CheckpointConfig *cp = config->checkpoint;
+    if (cp == NULL || cp->path == NULL) return 0;
+    if (checkpoint_stop_requested()) return 1;
+    if (cp->stop_at > 0 && clock >= cp->stop_at) return 1;
+    return cp->interval > 0 && clock >= cp->next_clock;
+}
+
+// 填写所有算法共有的快照字段，算法相关的字段由调用者补充
+static void snapshot_init(SimSnapshot *snap, const EventSource *ev, int clock, int completed) {
+    const SchedConfig *config = ev->config;
+    memset(snap, 0, sizeof(*snap));
+    snap->clock = clock;
+    snap->completed = completed;
+    snap->next_arrival = ev->next_arrival;
+    memcpy(snap->device_free, ev->device_free, sizeof(snap->device_free));
+    snap->wake_time = ev->wake_time;
+    snap->current = -1;
+    snap->deadline_rejected = config->deadline_stats != NULL ? config->deadline_stats->rejected : 0;
+    snap->io_stats = config->io_stats;
+}
+
+// 写检查点，queues 中的就绪队列按顺序保存（num_queues 可为0）
+// @return 模拟是否应就此停止
+static int take_checkpoint(SimSnapshot *snap, ProcessQueue **queues, int num_queues, const EventSource *ev) {
+    const SchedConfig *config = ev->config;
+    CheckpointConfig *cp = config->checkpoint;
+    double start = now_ms();
+
+    int length = 0;
+    for (int q = 0; q < num_queues; q++) {
+        length += queues[q]->count;
+    }
+    int *queue = (int*)malloc(sizeof(int) * (length > 0 ? length : 1));
+    if (queue != NULL) {
+        int k = 0;
+        for (int q = 0; q < num_queues; q++) {
+            for (PCB *p = queues[q]->head; p != NULL; p = p->next) {
+                queue[k++] = (int)(p - ev->processes);
+            }
+        }
+        snap->queue = queue;
+        snap->queue_length = length;
+    }
+
+    if (queue == NULL || write_checkpoint(cp->path, ev->processes, ev->count, config, snap) != 0) {
+        cp->failed++;
+    } else {
+        cp->written++;
+        cp->last_clock = snap->clock;
+        if (config->verbose) {
+            print_colored("时间 %d: 写入检查点 %s\n", MAGENTA, snap->clock, cp->path);
+        }
+    }
+    free(queue);
+    cp->write_ms += now_ms() - start;
+    if (cp->interval > 0) {
+        cp->next_clock = (snap->clock / cp->interval + 1) * cp->interval;
+    }
+
+    cp->stopped = checkpoint_stop_requested() || (cp->stop_at > 0 && snap->clock >= cp->stop_at);
+    return cp->stopped;
+}
+
+// FCFS：按就绪顺序依次运行，直到完成或因I/O阻塞
+static int simulate_fcfs(PCB *processes, int count, const int *order, const SchedConfig *config,
+                         const SimSnapshot *resume) {
+    ProcessQueue *ready_queue = create_queue();
+    EventSource ev;
+    if (ready_queue == NULL || events_init(&ev, processes, count, order, config) != 0) {
+        destroy_queue(ready_queue);
+        return -1;
+    }
+
+    int clock = 0;
+    int completed = 0;
+    int idx;
+    int ok = 1;
+
+    if (resume != NULL) {
+        events_restore(&ev, resume);
+        ok = restore_queues(&ready_queue, NULL, processes, resume) == 0;
+        clock = resume->clock;
+        completed = resume->completed;
+    }
+
+    while (ok && completed < count) {
+        if (checkpoint_due(clock, config)) {
+            SimSnapshot snap;
+            snapshot_init(&snap, &ev, clock, completed);
+            if (take_checkpoint(&snap, &ready_queue, 1, &ev)) break;
+        }
+
+        while ((idx = events_next_ready(&ev, clock)) >= 0) {
+            if (enqueue(ready_queue, &processes[idx]) != 0) ok = 0;
+        }
+
+        PCB *p = dequeue(ready_queue);
+        if (p == NULL) {
+            clock = events_next_time(&ev);
+            continue;
+        }
+
+        dispatch_process(p, clock, config);
+        int run = clamp_to_burst(&ev, p, p->remaining_time);
+        charge_runtime(p, clock, run, config);
+        clock += run;
+
+        if (p->remaining_time <= 0) {
+            finish_process(p, clock, config);
+            completed++;
+        } else {
+            block_for_io(&ev, (int)(p - processes), clock, run);
+        }
+    }
+
+    // 写检查点后停止时队列中还有进程，它们属于调用者的数组，不能由 destroy_queue 释放
+    while (dequeue(ready_queue) != NULL);
+    events_destroy(&ev);
+    destroy_queue(ready_queue);
+    return ok ? clock : -1;
+}
+
+// RR：与 RR_scheduler 相同的语义，时间片结束时先接纳新到达的进程，再将被抢占进程放回队尾
+static int simulate_rr(PCB *processes, int count, const int *order, const SchedConfig *config,
+                       const SimSnapshot *resume) {
+    ProcessQueue *ready_queue = create_queue();
+    EventSource ev;
+    if (ready_queue == NULL || events_init(&ev, processes, count, order, config) != 0) {
+        destroy_queue(ready_queue);
+        return -1;
+    }
+
+    int quantum = config->time_quantum > 0 ? config->time_quantum : 1;
+    int clock = 0;
+    int completed = 0;
+    int idx;
+    int ok = 1;
+
+    if (resume != NULL) {
+        events_restore(&ev, resume);
+        ok = restore_queues(&ready_queue, NULL, processes, resume) == 0;
+        clock = resume->clock;
+        completed = resume->completed;
+    }
+
+    while (ok && completed < count && !time_limit_reached(clock, config)) {
+        if (checkpoint_due(clock, config)) {
+            SimSnapshot snap;
+            snapshot_init(&snap, &ev, clock, completed);
+            if (take_checkpoint(&snap, &ready_queue, 1, &ev)) break;
+        }
+
+        while ((idx = events_next_ready(&ev, clock)) >= 0) {
+            if (enqueue(ready_queue, &processes[idx]) != 0) ok = 0;
+        }
+
+        PCB *p = dequeue(ready_queue);
+        if (p == NULL) {
+            // CPU空闲，直接跳到下一个到达或唤醒时刻
+            clock = events_next_time(&ev);
+            continue;
+        }
+
+        dispatch_process(p, clock, config);
+        int run = (p->remaining_time < quantum) ? p->remaining_time : quantum;
+        run = clamp_to_limit(clock, clamp_to_burst(&ev, p, run), config);
+        charge_runtime(p, clock, run, config);
+        clock += run;
+
+        while ((idx = events_next_ready(&ev, clock)) >= 0) {
+            if (enqueue(ready_queue, &processes[idx]) != 0) ok = 0;
+        }
+
+        if (p->remaining_time <= 0) {
+            finish_process(p, clock, config);
+            completed++;
+        } else if (!block_for_io(&ev, (int)(p - processes), clock, run)) {
+            p->status = PROCESS_READY;
+            if (enqueue(ready_queue, p) != 0) ok = 0;
+        }
+    }
+
+    // 提前截止或写检查点后停止时队列中还有进程，它们属于调用者的数组，不能由 destroy_queue 释放
+    while (dequeue(ready_queue) != NULL);
+    events_destroy(&ev);
+    destroy_queue(ready_queue);
+    return ok ? clock : -1;
+}
+
+// 非抢占式调度：每次从就绪进程中选出键最小的一个，运行到完成或因I/O阻塞
+// Priority 的键为 -priority，SJF 的键为 service_time
+static int simulate_nonpreemptive(PCB *processes, int count, const int *order,
+                                  const SchedConfig *config, const SimSnapshot *resume) {
+    long long *keys = (long long*)malloc(sizeof(long long) * count);
+    IndexHeap ready;
+    EventSource ev;
+    if (heap_init(&ready, count) != 0 || keys == NULL) {
+        free(ready.items);
+        free(keys);
+        return -1;
+    }
+    if (events_init(&ev, processes, count, order, config) != 0) {
+        free(ready.items);
+        free(keys);
+        return -1;
+    }
+    ready.keys = keys;
+
+    for (int i = 0; i < count; i++) {
+        keys[i] = (config->algorithm == ALGO_SJF) ? processes[i].service_time : -processes[i].priority;
+    }
+
+    int clock = 0;
+    int completed = 0;
+    int idx;
+
+    if (resume != NULL) {
+        int pos = 0;
+        events_restore(&ev, resume);
+        while ((idx = events_next_restored(&ev, &pos)) >= 0) {
+            heap_push(&ready, idx);
+        }
+        clock = resume->clock;
+        completed = resume->completed;
+    }
+
+    while (completed < count) {
+        if (checkpoint_due(clock, config)) {
+            SimSnapshot snap;
+            snapshot_init(&snap, &ev, clock, completed);
+            if (take_checkpoint(&snap, NULL, 0, &ev)) break;
+        }
+
+        while ((idx = events_next_ready(&ev, clock)) >= 0) {
+            heap_push(&ready, idx);
+        }
+
+        if (ready.size == 0) {
+            clock = events_next_time(&ev);
+            continue;
+        }
+
+        idx = heap_pop(&ready);
+        PCB *p = &processes[idx];
+        dispatch_process(p, clock, config);
+        int run = clamp_to_burst(&ev, p, p->remaining_time);
+        charge_runtime(p, clock, run, config);
+        clock += run;
+
+        if (p->remaining_time <= 0) {
+            finish_process(p, clock, config);
+            completed++;
+        } else {
+            block_for_io(&ev, idx, clock, run);
+        }
+    }
+
+    events_destroy(&ev);
+    free(ready.items);
+    free(keys);
+    return clock;
+}
+
+// 进程进入就绪堆时的键
+// SRTF: 剩余时间；
+// EDF: 绝对截止期限，没有截止期限的进程按到达时间排在后面；
+// 抢占式优先级: 不老化时为 -priority；老化时有效优先级 = priority + 等待时长 / aging_interval，
+// 所有等待进程以相同速率老化，因此键 ready_since - priority * aging_interval 不随时间变化，
+// 堆顺序始终有效，每次抢占检查只需比较堆顶
+static long long ready_key(const PCB *p, int clock, const SchedConfig *config) {
+    if (config->algorithm == ALGO_SRTF) {
+        return p->remaining_time;
+    }
+    if (config->algorithm == ALGO_EDF) {
+        if (p->deadline > 0) {
+            return (long long)p->arrive_time + p->deadline;
+        }
+        return EDF_BACKGROUND_KEY + p->arrive_time;
+    }
+    if (config->aging_interval > 0) {
+        return (long long)clock - (long long)p->priority * config->aging_interval;
+    }
+    return -p->priority;
+}
+
+// 老化时与就绪堆顶比较的当前进程键：等待进程的有效优先级 priority + 等待时长 / aging_interval 取整，
+// 超过当前进程的基础优先级，即键不大于 clock - (priority + 1) * aging_interval 时才抢占，
+// 同优先级的进程至少运行 aging_interval 才会被换下
+static long long aging_running_key(const PCB *p, int clock, const SchedConfig *config) {
+    return (long long)clock - ((long long)p->priority + 1) * config->aging_interval + 1;
+}
+
+// EDF接纳控制（密度测试）：已接纳且未完成作业的 服务时间/相对截止期限 之和加上新作业后不超过1时接纳，
+// 否则清除其截止期限，作为后台作业在空闲时运行
+static void admit_deadline_job(PCB *p, double *density, const SchedConfig *config) {
+    double job_density = (double)p->service_time / p->deadline;
+
+    if (*density + job_density > 1.0 + 1e-9) {
+        if (config->deadline_stats != NULL) {
+            config->deadline_stats->rejected++;
+        }
+        if (config->verbose) {
+            print_colored("时间 %d: 进程[%d] %s 未通过接纳测试，降级为后台作业\n",
+                         RED, p->arrive_time, p->pid, p->name);
+        }
+        p->deadline = 0;
+        return;
+    }
+
+    *density += job_density;
+}
+
+// 抢占式调度 (SRTF / 带老化的抢占式优先级 / EDF)：在新进程到达、I/O完成时检查是否抢占，
+// 老化时还在堆顶进程的有效优先级超过当前进程的时刻检查，每次检查 O(log n)
+static int simulate_preemptive(PCB *processes, int count, const int *order, const SchedConfig *config,
+                               const SimSnapshot *resume) {
+    long long *keys = (long long*)malloc(sizeof(long long) * count);
+    IndexHeap ready;
+    EventSource ev;
+    if (heap_init(&ready, count) != 0 || keys == NULL) {
+        free(ready.items);
+        free(keys);
+        return -1;
+    }
+    if (events_init(&ev, processes, count, order, config) != 0) {
+        free(ready.items);
+        free(keys);
+        return -1;
+    }
+    ready.keys = keys;
+
+    int srtf = (config->algorithm == ALGO_SRTF);
+    int aging = (config->algorithm == ALGO_PRIORITY_AGING && config->aging_interval > 0);
+    int admission = (config->algorithm == ALGO_EDF && config->admission_control);
+    double density = 0.0;           // 已接纳截止期限作业的密度之和
+    int clock = 0;
+    int completed = 0;
+    int current = -1;               // 正在运行的进程下标
+    long long current_key = 0;      // 正在运行进程被调度时的键（EDF 与不老化的优先级在运行期间不变）
+    int idx;
+
+    if (resume != NULL) {
+        int pos = 0;
+        events_restore(&ev, resume);
+        memcpy(keys, resume->keys, sizeof(long long) * count);
+        while ((idx = events_next_restored(&ev, &pos)) >= 0) {
+            heap_push(&ready, idx);
+        }
+        density = resume->density;
+        current = resume->current;
+        current_key = resume->current_key;
+        clock = resume->clock;
+        completed = resume->completed;
+    }
+
+    while (completed < count) {
+        if (checkpoint_due(clock, config)) {
+            SimSnapshot snap;
+            snapshot_init(&snap, &ev, clock, completed);
+            snap.keys = keys;
+            snap.density = density;
+            snap.current = current;
+            snap.current_key = current_key;
+            if (take_checkpoint(&snap, NULL, 0, &ev)) break;
+        }
+
+        while ((idx = events_next_ready(&ev, clock)) >= 0) {
+            // 只在首次到达时做接纳测试，I/O完成后重新就绪的作业保持原来的结果
+            if (admission && processes[idx].deadline > 0 && processes[idx].dispatch_count == 0) {
+                admit_deadline_job(&processes[idx], &density, config);
+            }
+            keys[idx] = ready_key(&processes[idx], clock, config);
+            heap_push(&ready, idx);
+        }
+
+        // 就绪堆顶严格优于当前进程时抢占。老化只累计等待时间：正在运行的进程的有效优先级就是基础优先级，
+        // 否则长作业会在运行中不断积累老化，再也不会被抢占
+        if (current >= 0 && ready.size > 0) {
+            long long running_key = current_key;
+            if (srtf) {
+                running_key = processes[current].remaining_time;
+            } else if (aging) {
+                running_key = aging_running_key(&processes[current], clock, config);
+            }
+            if (keys[ready.items[0]] < running_key) {
+                PCB *p = &processes[current];
+                if (config->verbose) {
+                    print_colored("时间 %d: 进程[%d] %s 被抢占，剩余时间: %d\n",
+                                 YELLOW, clock, p->pid, p->name, p->remaining_time);
+                }
+                p->status = PROCESS_READY;
+                keys[current] = ready_key(p, clock, config);
+                heap_push(&ready, current);
+                current = -1;
+            }
+        }
+
+        if (current < 0) {
+            if (ready.size == 0) {
+                clock = events_next_time(&ev);
+                continue;
+            }
+            current = heap_pop(&ready);
+            current_key = keys[current];
+            dispatch_process(&processes[current], clock, config);
+        }
+
+        // 运行到完成、CPU突发结束或下一个事件
+        PCB *p = &processes[current];
+        int end = clock + clamp_to_burst(&ev, p, p->remaining_time);
+        int next_event = events_next_time(&ev);
+        if (next_event < end) {
+            end = next_event;
+        }
+        // 老化：堆顶进程在没有其他事件时也会在某一时刻超过当前进程，运行到那一刻再检查
+        if (aging && ready.size > 0) {
+            long long overtake = keys[ready.items[0]] + ((long long)p->priority + 1) * config->aging_interval;
+            if (overtake < end) {
+                end = (int)overtake;
+            }
+        }
+        int ran = end - clock;
+        charge_runtime(p, clock, ran, config);
+        clock = end;
+
+        if (p->remaining_time <= 0) {
+            if (admission && p->deadline > 0) {
+                density -= (double)p->service_time / p->deadline;
+            }
+            finish_process(p, clock, config);
+            completed++;
+            current = -1;
+        } else if (block_for_io(&ev, current, clock, ran)) {
+            current = -1;
+        }
+    }
+
+    events_destroy(&ev);
+    free(ready.items);
+    free(keys);
+    return clock;
+}
+
+// 将进程放入MLFQ的指定级别，入队失败返回-1
+static int mlfq_enqueue(ProcessQueue **queues, int *levels, PCB *p, int idx, int level) {
+    p->status = PROCESS_READY;
+    levels[idx] = level;
+    return enqueue(queues[level], p);
+}
+
+// MLFQ：新进程进入第0级；用完整个时间片则降一级；被更高级到达抢占或因I/O让出CPU则留在原级；
+// 每隔 boost_interval 把所有就绪进程提升回第0级，防止长作业饥饿
+static int simulate_mlfq(PCB *processes, int count, const int *order, const SchedConfig *config,
+                         const SimSnapshot *resume) {
+    int num_levels = config->mlfq_levels > 0 ? config->mlfq_levels : 3;
+    if (num_levels > MLFQ_MAX_LEVELS) num_levels = MLFQ_MAX_LEVELS;
+    int base_quantum = config->time_quantum > 0 ? config->time_quantum : 1;
+    int boost = config->boost_interval;
+
+    ProcessQueue *queues[MLFQ_MAX_LEVELS];
+    int quantum[MLFQ_MAX_LEVELS];
+    int *levels = (int*)calloc(count, sizeof(int));    // 各进程所在级别，阻塞期间保留
+    EventSource ev;
+    int ok = events_init(&ev, processes, count, order, config) == 0 && levels != NULL;
+
+    for (int l = 0; l < num_levels; l++) {
+        queues[l] = create_queue();
+        quantum[l] = base_quantum << l;
+        if (queues[l] == NULL) ok = 0;
+    }
+
+    int clock = 0;
+    int completed = 0;
+    int next_boost = boost;
+    int idx;
+
+    if (ok && resume != NULL) {
+        events_restore(&ev, resume);
+        memcpy(levels, resume->levels, sizeof(int) * count);
+        ok = restore_queues(queues, levels, processes, resume) == 0;
+        next_boost = resume->next_boost;
+        clock = resume->clock;
+        completed = resume->completed;
+    }
+
+    while (ok && completed < count) {
+        if (checkpoint_due(clock, config)) {
+            SimSnapshot snap;
+            snapshot_init(&snap, &ev, clock, completed);
+            snap.levels = levels;
+            snap.next_boost = next_boost;
+            if (take_checkpoint(&snap, queues, num_levels, &ev)) break;
+        }
+
+        while ((idx = events_next_ready(&ev, clock)) >= 0) {
+            PCB *arrived = &processes[idx];
+            if (mlfq_enqueue(queues, levels, arrived, idx, arrived->dispatch_count == 0 ? 0 : levels[idx]) != 0) ok = 0;
+        }
+
+        // 周期性优先级提升
+        if (boost > 0 && clock >= next_boost) {
+            for (int l = 1; l < num_levels; l++) {
+                PCB *p;
+                while ((p = dequeue(queues[l])) != NULL) {
+                    if (mlfq_enqueue(queues, levels, p, (int)(p - processes), 0) != 0) ok = 0;
+                }
+            }
+            next_boost = (clock / boost + 1) * boost;
+            if (config->verbose) {
+                print_colored("时间 %d: 优先级提升，所有就绪进程回到第0级\n", MAGENTA, clock);
+            }
+        }
+
+        // 选择最高的非空级别
+        int level = 0;
+        while (level < num_levels && queues[level]->head == NULL) level++;
+        if (level == num_levels) {
+            clock = events_next_time(&ev);
+            continue;
+        }
+
+        PCB *p = dequeue(queues[level]);
+        dispatch_process(p, clock, config);
+
+        int end = clock + clamp_to_burst(&ev, p, (p->remaining_time < quantum[level]) ? p->remaining_time
+                                                                                       : quantum[level]);
+        // 低级别进程会被新到达或I/O完成的进程抢占
+        int next_event = events_next_time(&ev);
+        if (level > 0 && next_event < end) {
+            end = next_event;
+        }
+        if (boost > 0 && next_boost < end) {
+            end = next_boost;
+        }
+
+        int ran = end - clock;
+        charge_runtime(p, clock, ran, config);
+        clock = end;
+
+        while ((idx = events_next_ready(&ev, clock)) >= 0) {
+            PCB *arrived = &processes[idx];
+            if (mlfq_enqueue(queues, levels, arrived, idx, arrived->dispatch_count == 0 ? 0 : levels[idx]) != 0) ok = 0;
+        }
+
+        if (p->remaining_time <= 0) {
+            finish_process(p, clock, config);
+            completed++;
+        } else if (!block_for_io(&ev, (int)(p - processes), clock, ran)) {
+            if (ran >= quantum[level]) {
+                int lower = (level + 1 < num_levels) ? level + 1 : level;
+                if (config->verbose) {
+                    print_colored("时间 %d: 进程[%d] %s 用完时间片，降至第%d级\n",
+                                 YELLOW, clock, p->pid, p->name, lower);
+                }
+                if (mlfq_enqueue(queues, levels, p, (int)(p - processes), lower) != 0) ok = 0;
+            } else if (mlfq_enqueue(queues, levels, p, (int)(p - processes), level) != 0) {
+                ok = 0;
+            }
+        }
+    }
+
+    // 写检查点后停止时队列中的进程属于调用者的数组，先取出再销毁队列
+    for (int l = 0; l < num_levels; l++) {
+        if (queues[l] == NULL) continue;
+        while (dequeue(queues[l]) != NULL);
+        destroy_queue(queues[l]);
+    }
+    events_destroy(&ev);
+    free(levels);
+    return ok ? clock : -1;
+}
+
+// CFS：就绪进程按虚拟运行时间存放在红黑树中，每次选择 vruntime 最小的进程；
+// 时间片 = target_latency * 权重 / 就绪总权重，但不少于 min_granularity。
+// 新到达或I/O完成的进程 vruntime 不低于当前 min_vruntime，避免长期占用CPU；不做唤醒抢占
+static int simulate_cfs(PCB *processes, int count, const int *order, const SchedConfig *config,
+                        const SimSnapshot *resume) {
+    long long *keys = (long long*)malloc(sizeof(long long) * count);
+    RBTree tree;
+    EventSource ev;
+    if (keys == NULL || rb_init(&tree, count) != 0) {
+        free(keys);
+        return -1;
+    }
+    if (events_init(&ev, processes, count, order, config) != 0) {
+        rb_destroy(&tree);
+        free(keys);
+        return -1;
+    }
+    tree.keys = keys;
+
+    int min_granularity = config->min_granularity > 0 ? config->min_granularity : 1;
+    int target_latency = config->target_latency > 0 ? config->target_latency : 24;
+    long long total_weight = 0;     // 就绪与运行进程的权重之和
+    long long min_vruntime = 0;     // 单调递增
+    int clock = 0;
+    int completed = 0;
+
+    if (resume != NULL) {
+        int pos = 0;
+        int idx;
+        events_restore(&ev, resume);
+        while ((idx = events_next_restored(&ev, &pos)) >= 0) {
+            keys[idx] = processes[idx].vruntime;
+            rb_insert(&tree, idx);
+            total_weight += priority_to_weight(processes[idx].priority);
+        }
+        min_vruntime = resume->min_vruntime;
+        clock = resume->clock;
+        completed = resume->completed;
+    }
+
+    while (completed < count && !time_limit_reached(clock, config)) {
+        if (checkpoint_due(clock, config)) {
+            SimSnapshot snap;
+            snapshot_init(&snap, &ev, clock, completed);
+            snap.min_vruntime = min_vruntime;
+            if (take_checkpoint(&snap, NULL, 0, &ev)) break;
+        }
+
+        int idx;
+        while ((idx = events_next_ready(&ev, clock)) >= 0) {
+            if (processes[idx].vruntime < min_vruntime) {
+                processes[idx].vruntime = min_vruntime;
+            }
+            keys[idx] = processes[idx].vruntime;
+            rb_insert(&tree, idx);
+            total_weight += priority_to_weight(processes[idx].priority);
+        }
+
+        idx = rb_first(&tree);
+        if (idx < 0) {
+            clock = events_next_time(&ev);
+            continue;
+        }
+        rb_erase(&tree, idx);
+
+        PCB *p = &processes[idx];
+        int weight = priority_to_weight(p->priority);
+        dispatch_process(p, clock, config);
+
+        long long slice = (long long)target_latency * weight / total_weight;
+        if (slice < min_granularity) slice = min_granularity;
+        int run = (p->remaining_time < slice) ? p->remaining_time : (int)slice;
+        run = clamp_to_limit(clock, clamp_to_burst(&ev, p, run), config);
+        charge_runtime(p, clock, run, config);
+        clock += run;
+
+        // min_vruntime 跟随运行进程与树中最小值中较小者，只增不减
+        long long floor_vruntime = p->vruntime;
+        int first = rb_first(&tree);
+        if (first >= 0 && keys[first] < floor_vruntime) {
+            floor_vruntime = keys[first];
+        }
+        if (floor_vruntime > min_vruntime) {
+            min_vruntime = floor_vruntime;
+        }
+
+        int arrived;
+        while ((arrived = events_next_ready(&ev, clock)) >= 0) {
+            if (processes[arrived].vruntime < min_vruntime) {
+                processes[arrived].vruntime = min_vruntime;
+            }
+            keys[arrived] = processes[arrived].vruntime;
+            rb_insert(&tree, arrived);
+            total_weight += priority_to_weight(processes[arrived].priority);
+        }
+
+        if (p->remaining_time <= 0) {
+            finish_process(p, clock, config);
+            total_weight -= weight;
+            completed++;
+        } else if (block_for_io(&ev, idx, clock, run)) {
+            total_weight -= weight;
+        } else {
+            p->status = PROCESS_READY;
+            keys[idx] = p->vruntime;
+            rb_insert(&tree, idx);
+        }
+    }
+
+    events_destroy(&ev);
+    rb_destroy(&tree);
+    free(keys);
+    return clock;
+}
+
+// 进入就绪堆时的行程：新进程从全局行程开始；I/O完成的进程保留领先于全局行程的部分，
+// 但不能补偿阻塞期间落后的部分
+static long long stride_join_pass(const long long *pass, const PCB *p, int idx, long long global_pass) {
+    if (p->dispatch_count > 0 && pass[idx] > global_pass) {
+        return pass[idx];
+    }
+    return global_pass;
+}
+
+// 步长调度：每个进程的步长 = STRIDE1 / 彩票数，每次选择行程 (pass) 最小的进程运行，
+// 运行后行程增加 步长 * 运行时间。新到达的进程从当前全局行程开始，不能补偿到达之前的时间
+static int simulate_stride(PCB *processes, int count, const int *order, const SchedConfig *config,
+                           const SimSnapshot *resume) {
+    long long *pass = (long long*)malloc(sizeof(long long) * count);
+    IndexHeap ready;
+    EventSource ev;
+    if (heap_init(&ready, count) != 0 || pass == NULL) {
+        free(ready.items);
+        free(pass);
+        return -1;
+    }
+    if (events_init(&ev, processes, count, order, config) != 0) {
+        free(ready.items);
+        free(pass);
+        return -1;
+    }
+    ready.keys = pass;
+
+    int quantum = config->time_quantum > 0 ? config->time_quantum : 1;
+    long long global_pass = 0;
+    int clock = 0;
+    int completed = 0;
+
+    if (resume != NULL) {
+        int pos = 0;
+        int idx;
+        events_restore(&ev, resume);
+        memcpy(pass, resume->keys, sizeof(long long) * count);
+        while ((idx = events_next_restored(&ev, &pos)) >= 0) {
+            heap_push(&ready, idx);
+        }
+        global_pass = resume->global_pass;
+        clock = resume->clock;
+        completed = resume->completed;
+    }
+
+    while (completed < count && !time_limit_reached(clock, config)) {
+        if (checkpoint_due(clock, config)) {
+            SimSnapshot snap;
+            snapshot_init(&snap, &ev, clock, completed);
+            snap.keys = pass;
+            snap.global_pass = global_pass;
+            if (take_checkpoint(&snap, NULL, 0, &ev)) break;
+        }
+
+        int idx;
+        while ((idx = events_next_ready(&ev, clock)) >= 0) {
+            pass[idx] = stride_join_pass(pass, &processes[idx], idx, global_pass);
+            heap_push(&ready, idx);
+        }
+
+        if (ready.size == 0) {
+            clock = events_next_time(&ev);
+            continue;
+        }
+
+        idx = heap_pop(&ready);
+        PCB *p = &processes[idx];
+        if (pass[idx] > global_pass) {
+            global_pass = pass[idx];
+        }
+        dispatch_process(p, clock, config);
+
+        int run = (p->remaining_time < quantum) ? p->remaining_time : quantum;
+        run = clamp_to_limit(clock, clamp_to_burst(&ev, p, run), config);
+        charge_runtime(p, clock, run, config);
+        clock += run;
+        pass[idx] += (long long)(STRIDE1 / priority_to_tickets(p->priority)) * run;
+
+        int arrived;
+        while ((arrived = events_next_ready(&ev, clock)) >= 0) {
+            pass[arrived] = stride_join_pass(pass, &processes[arrived], arrived, global_pass);
+            heap_push(&ready, arrived);
+        }
+
+        if (p->remaining_time <= 0) {
+            finish_process(p, clock, config);
+            completed++;
+        } else if (!block_for_io(&ev, idx, clock, run)) {
+            p->status = PROCESS_READY;
+            heap_push(&ready, idx);
+        }
+    }
+
+    events_destroy(&ev);
+    free(ready.items);
+    free(pass);
+    return clock;
+}
+
+// 树状数组 (Fenwick)：维护各进程彩票数的前缀和，下标从1开始
+static void fenwick_add(long long *tree, int size, int idx, long long delta) {
+    for (int i = idx + 1; i <= size; i += i & -i) {
+        tree[i] += delta;
+    }
+}
+
+// 找出前缀和首次超过 target 的进程下标，即抽中第 target 张彩票的进程，O(log n)
+static int fenwick_find(const long long *tree, int size, long long target) {
+    int pos = 0;
+    int step = 1;
+    while (step * 2 <= size) step *= 2;
+
+    for (; step > 0; step /= 2) {
+        if (pos + step <= size && tree[pos + step] <= target) {
+            pos += step;
+            target -= tree[pos];
+        }
+    }
+    return pos;  // 1起始下标 pos + 1 即0起始下标 pos
+}
+
+// 彩票调度：每个时间片从所有可运行进程的彩票中随机抽取一张，持有者运行一个时间片；
+// 阻塞的进程交出彩票，I/O完成后再放回
+static int simulate_lottery(PCB *processes, int count, const int *order, const SchedConfig *config,
+                            const SimSnapshot *resume) {
+    long long *tree = (long long*)calloc(count + 1, sizeof(long long));
+    EventSource ev;
+    if (tree == NULL) return -1;
+    if (events_init(&ev, processes, count, order, config) != 0) {
+        free(tree);
+        return -1;
+    }
+
+    int quantum = config->time_quantum > 0 ? config->time_quantum : 1;
+    unsigned int seed = config->random_seed;
+    long long total_tickets = 0;
+    int clock = 0;
+    int completed = 0;
+
+    if (resume != NULL) {
+        int pos = 0;
+        int idx;
+        events_restore(&ev, resume);
+        while ((idx = events_next_restored(&ev, &pos)) >= 0) {
+            int tickets = priority_to_tickets(processes[idx].priority);
+            fenwick_add(tree, count, idx, tickets);
+            total_tickets += tickets;
+        }
+        seed = resume->rng_state;
+        clock = resume->clock;
+        completed = resume->completed;
+    }
+
+    while (completed < count && !time_limit_reached(clock, config)) {
+        if (checkpoint_due(clock, config)) {
+            SimSnapshot snap;
+            snapshot_init(&snap, &ev, clock, completed);
+            snap.rng_state = seed;
+            if (take_checkpoint(&snap, NULL, 0, &ev)) break;
+        }
+
+        int idx;
+        while ((idx = events_next_ready(&ev, clock)) >= 0) {
+            int tickets = priority_to_tickets(processes[idx].priority);
+            fenwick_add(tree, count, idx, tickets);
+            total_tickets += tickets;
+        }
+
+        if (total_tickets == 0) {
+            clock = events_next_time(&ev);
+            continue;
+        }
+
+        // 两次 rand_r 分成两条语句，保证高低位的取值顺序固定，同一种子在各编译器下结果一致
+        long long high = rand_r(&seed);
+        long long low = rand_r(&seed);
+        long long draw = ((high << 31) | low) % total_tickets;
+        idx = fenwick_find(tree, count, draw);
+        PCB *p = &processes[idx];
+        dispatch_process(p, clock, config);
+
+        int run = (p->remaining_time < quantum) ? p->remaining_time : quantum;
+        run = clamp_to_limit(clock, clamp_to_burst(&ev, p, run), config);
+        charge_runtime(p, clock, run, config);
+        clock += run;
+
+        if (p->remaining_time <= 0 || block_for_io(&ev, idx, clock, run)) {
+            int tickets = priority_to_tickets(p->priority);
+            fenwick_add(tree, count, idx, -tickets);
+            total_tickets -= tickets;
+            if (p->remaining_time <= 0) {
+                finish_process(p, clock, config);
+                completed++;
+            }
+        } else {
+            p->status = PROCESS_READY;
+        }
+    }
+
+    events_destroy(&ev);
+    free(tree);
+    return clock;
+}
+
+/**
+ * 运行一次调度模拟
+ * 不打印进程表、不延时、不使用全局时钟，结果写入各PCB的统计字段。
+ * config->checkpoint 非NULL时按其设置写检查点或从检查点继续，写入检查点后停止时返回停止时刻
+ * @param processes 进程数组（会被修改）
+ * @param count 进程数量
+ * @param config 调度参数
+ * @return 所有进程完成时的时钟值，失败返回-1
+ */
+int run_simulation(PCB *processes, int count, const SchedConfig *config) {
+    if (processes == NULL || count <= 0 || config == NULL) return -1;
+
+    SimSnapshot resume_state;
+    const SimSnapshot *resume = NULL;
+    CheckpointConfig *cp = config->checkpoint;
+    if (cp != NULL) {
+        cp->stopped = 0;
+        cp->next_clock = cp->interval;
+        if (cp->resume != NULL) {
+            const CheckpointHeader *header = cp->resume->header;
+            if (header->count != count || header->algorithm != (int)config->algorithm) {
+                print_colored("检查点与进程数组或调度算法不符\n", RED);
+                return -1;
+            }
+            checkpoint_snapshot(cp->resume, &resume_state);
+            resume = &resume_state;
+            if (cp->interval > 0) {
+                cp->next_clock = (resume->clock / cp->interval + 1) * cp->interval;
+            }
+        }
+    }
+
+    int *order = sort_by_arrival(processes, count);
+    if (order == NULL) return -1;
+
+    int total_time = -1;
+    switch (config->algorithm) {
+        case ALGO_FCFS:
+            total_time = simulate_fcfs(processes, count, order, config, resume);
+            break;
+        case ALGO_RR:
+            total_time = simulate_rr(processes, count, order, config, resume);
+            break;
+        case ALGO_PRIORITY:
+        case ALGO_SJF:
+            total_time = simulate_nonpreemptive(processes, count, order, config, resume);
+            break;
+        case ALGO_SRTF:
+        case ALGO_PRIORITY_AGING:
+        case ALGO_EDF:
+            total_time = simulate_preemptive(processes, count, order, config, resume);
+            break;
+        case ALGO_MLFQ:
+            total_time = simulate_mlfq(processes, count, order, config, resume);
+            break;
+        case ALGO_CFS:
+            total_time = simulate_cfs(processes, count, order, config, resume);
+            break;
+        case ALGO_STRIDE:
+            total_time = simulate_stride(processes, count, order, config, resume);
+            break;
+        case ALGO_LOTTERY:
+            total_time = simulate_lottery(processes, count, order, config, resume);
+            break;
+        default:
+            break;
+    }
+
+    free(order);
+    if (total_time >= 0) {
+        metric_inc(simulations_metrics[config->algorithm], 1);
+    }
+    return total_time;
+}
+
+/**
+ * 用命令行工具共用的默认参数初始化调度配置：时间片4、MLFQ 3级、每500提升一次、每100老化一级、
+ * CFS最小时间片1、调度周期24，其余字段清零（不模拟I/O，不记录执行段和统计）
+ * @param config 要初始化的配置
+ * @param algorithm 调度算法
+ */
+void sched_config_defaults(SchedConfig *config, SchedAlgorithm algorithm) {
+    memset(config, 0, sizeof(*config));
+    config->algorithm = algorithm;
+    config->time_quantum = 4;
+    config->mlfq_levels = 3;
+    config->boost_interval = 500;
+    config->aging_interval = 100;
+    config->min_granularity = 1;
+    config->target_latency = 24;
+}
+
+/**
+ * 获取算法名称
+ */
+const char* sched_algorithm_name(SchedAlgorithm algorithm) {
+    if (algorithm < 0 || algorithm >= ALGO_COUNT) return "?";
+    return algorithm_names[algorithm];
+}
+
+/**
+ * 按名称解析算法（不区分大小写）
+ * @return 算法编号，未知名称返回-1
+ */
+int parse_sched_algorithm(const char *name) {
+    for (int i = 0; i < ALGO_COUNT; i++) {
+        if (strcasecmp(name, algorithm_names[i]) == 0) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+// 优先级到权重的映射，取自 Linux 的 nice 值权重表 (nice -20 ~ 19)，相邻级别约相差1.25倍
+static const int nice_to_weight[40] = {
+    88761, 71755, 56483, 46273, 36291,
+    29154, 23254, 18705, 14949, 11916,
+     9548,  7620,  6100,  4904,  3906,
+     3121,  2501,  1991,  1586,  1277,
+     1024,   820,   655,   526,   423,
+      335,   272,   215,   172,   137,
+      110,    87,    70,    56,    45,
+       36,    29,    23,    18,    15
+};
+
+/**
+ * 将进程优先级换算为调度权重
+ * 优先级5对应 nice 0 (权重 NICE_0_LOAD)，优先级每高1级 nice 减1
+ */
+int priority_to_weight(int priority) {
+    int nice = 5 - priority;
+    if (nice < -20) nice = -20;
+    if (nice > 19) nice = 19;
+    return nice_to_weight[nice + 20];
+}
+
+/**
+ * 判断算法是否使用时间片参数
+ */
+int sched_uses_quantum(SchedAlgorithm algorithm) {
+    return algorithm == ALGO_RR || algorithm == ALGO_MLFQ ||
+           algorithm == ALGO_STRIDE || algorithm == ALGO_LOTTERY;
+}
+
+/**
+ * 份额调度中进程持有的彩票数，直接取优先级，至少为1
+ */
+int priority_to_tickets(int priority) {
+    return priority > 0 ? priority : 1;
+}
+
+/**
+ * 生成随机工作负载：约70%短交互作业、30%长批处理作业，系统负载约为0.9
+ * @param count 进程数量
+ * @param seed 随机种子，相同种子生成相同负载
+ * @return 新分配的PCB数组，失败返回NULL
+ */
+PCB* generate_workload(int count, unsigned int seed) {
+    if (count <= 0) return NULL;
+
+    PCB *processes = (PCB*)malloc(sizeof(PCB) * count);
+    if (processes == NULL) {
+        perror("工作负载内存分配失败");
+        return NULL;
+    }
+
+    int arrive_time = 0;
+    char name[32];
+
+    for (int i = 0; i < count; i++) {
+        int service_time;
+        if (rand_r(&seed) % 10 < 7) {
+            service_time = 1 + rand_r(&seed) % 10;     // 短作业
+        } else {
+            service_time = 20 + rand_r(&seed) % 181;   // 长作业
+        }
+        int priority = 1 + rand_r(&seed) % 10;
+
+        snprintf(name, sizeof(name), "P%d", i + 1);
+        init_pcb(&processes[i], i + 1, name, priority, arrive_time, service_time);
+
+        arrive_time += rand_r(&seed) % 83;  // 平均到达间隔约41
+    }
+
+    return processes;
+}
+
+/**
+ * 从文本文件加载工作负载
+ * 每行格式: 名称 优先级 到达时间 服务时间 [相对截止期限 [CPU突发长度 I/O设备]]，'#' 开头的行为注释
+ * @param path 文件路径
+ * @param count 输出进程数量
+ * @return 新分配的PCB数组，失败返回NULL
+ */
+PCB* load_workload(const char *path, int *count) {
+    FILE *fp = fopen(path, "r");
+    if (fp == NULL) {
+        perror("无法打开工作负载文件");
+        return NULL;
+    }
+
+    int capacity = 64;
+    int size = 0;
+    PCB *processes = (PCB*)malloc(sizeof(PCB) * capacity);
+    char line[256];
+
+    while (processes != NULL && fgets(line, sizeof(line), fp) != NULL) {
+        char name[32];
+        int priority, arrive_time, service_time;
+        int deadline = 0, cpu_burst = 0, io_device = 0;
+
+        if (line[0] == '#' || line[0] == '\n') continue;
+        if (sscanf(line, "%31s %d %d %d %d %d %d", name, &priority, &arrive_time, &service_time,
+                   &deadline, &cpu_burst, &io_device) < 4 ||
+            arrive_time < 0 || service_time <= 0) {
+            print_colored("忽略无效的工作负载行: %s", RED, line);
+            continue;
+        }
+
+        if (size >= capacity) {
+            capacity *= 2;
+            PCB *grown = (PCB*)realloc(processes, sizeof(PCB) * capacity);
+            if (grown == NULL) {
+                free(processes);
+                processes = NULL;
+                break;
+            }
+            processes = grown;
+        }
+
+        init_pcb(&processes[size], size + 1, name, priority, arrive_time, service_time);
+        processes[size].deadline = deadline;
+        processes[size].cpu_burst = cpu_burst;
+        processes[size].io_device = io_device >= 0 ? io_device : 0;
+        size++;
+    }
+    fclose(fp);
+
+    if (processes == NULL || size == 0) {
+        print_colored("工作负载为空或内存不足: %s\n", RED, path);
+        free(processes);
+        return NULL;
+    }
+
+    *count = size;
+    return processes;
+}
+
+/**
+ * 为工作负载中约 percent% 的进程设置截止期限，模拟带延迟SLA的作业
+ * 相对截止期限为服务时间的 2~5 倍，与 generate_workload 使用独立的随机序列
+ */
+void assign_deadlines(PCB *processes, int count, unsigned int seed, int percent) {
+    for (int i = 0; i < count; i++) {
+        if ((int)(rand_r(&seed) % 100) < percent) {
+            processes[i].deadline = processes[i].service_time * (2 + rand_r(&seed) % 4);
+        } else {
+            processes[i].deadline = 0;
+        }
+    }
+}
+
+/**
+ * 把工作负载中约 percent% 的进程设为I/O密集型：每运行 1~5 个时间单位就向随机选择的设备发起一次I/O
+ */
+void assign_io_bursts(PCB *processes, int count, unsigned int seed, int percent, int devices) {
+    for (int i = 0; i < count; i++) {
+        if ((int)(rand_r(&seed) % 100) < percent) {
+            processes[i].cpu_burst = 1 + rand_r(&seed) % 5;
+            processes[i].io_device = devices > 0 ? (int)(rand_r(&seed) % devices) : 0;
+        } else {
+            processes[i].cpu_burst = 0;
+            processes[i].io_device = 0;
+        }
+    }
+}
+
+/**
+ * 复制PCB数组，使每次模拟都在独立的副本上进行
+ */
+PCB* copy_processes(const PCB *processes, int count) {
+    PCB *copy = (PCB*)malloc(sizeof(PCB) * count);
+    if (copy == NULL) {
+        perror("复制进程数组失败");
+        return NULL;
+    }
+    memcpy(copy, processes, sizeof(PCB) * count);
+    return copy;
+}
@@ -0,0 +1,86 @@
+#ifndef SIMULATOR_H
+#define SIMULATOR_H
+
+#include "process_control.h"
+#include "stats.h"
+
+#define MLFQ_MAX_LEVELS 8           // MLFQ最大队列级数
+#define NICE_0_LOAD 1024            // 优先级5 (nice 0) 的权重
+#define STRIDE1 (1 << 20)           // 步长调度中一张彩票对应的步长
+#define IO_MAX_DEVICES 8            // 模拟的I/O设备数上限
+#define IO_DEFAULT_LATENCY 10       // 设备服务一个I/O请求的默认时间
+#define EDF_BACKGROUND_KEY (1LL << 40) // EDF中没有截止期限的进程排在所有截止期限之后
+
+// 调度算法类型
+typedef enum {
+    ALGO_FCFS,          // 先来先服务
+    ALGO_RR,            // 时间片轮转
+    ALGO_PRIORITY,      // 非抢占式优先级
+    ALGO_SJF,           // 非抢占式短作业优先
+    ALGO_MLFQ,          // 多级反馈队列
+    ALGO_SRTF,          // 抢占式最短剩余时间优先
+    ALGO_PRIORITY_AGING,// 带老化的抢占式优先级
+    ALGO_CFS,           // 完全公平调度
+    ALGO_STRIDE,        // 步长调度（按份额）
+    ALGO_LOTTERY,       // 彩票调度（按份额）
+    ALGO_EDF,           // 抢占式最早截止期限优先
+    ALGO_COUNT
+} SchedAlgorithm;
+
+struct Checkpoint;
+
+// 检查点参数，写入情况由模拟函数回填
+typedef struct {
+    const char *path;           // 检查点文件，先写临时文件再原子替换，中途被杀也不会留下半个文件
+    int interval;               // >0 时每隔 interval 个时间单位在下一个调度点写一次检查点
+    int stop_at;                // >0 时在不早于该时刻的第一个调度点写入检查点后停止模拟
+    const struct Checkpoint *resume; // 非NULL时从该检查点继续，进程数组须由 checkpoint_processes 得到
+    int next_clock;             // 下一次定期检查点的时刻（由 run_simulation 初始化）
+    int written;                // 已写入的检查点数
+    int failed;                 // 写入失败的次数
+    int stopped;                // 模拟是否在写入检查点后提前停止
+    int last_clock;             // 最近一个检查点的时刻
+    double write_ms;            // 写检查点的累计耗时（毫秒）
+} CheckpointConfig;
+
+// 调度参数
+typedef struct {
+    SchedAlgorithm algorithm;   // 调度算法
+    int time_quantum;           // 时间片大小 (RR; MLFQ第0级, 之后每级翻倍)
+    int mlfq_levels;            // MLFQ队列级数 (<=0 时为3)
+    int boost_interval;         // MLFQ优先级提升周期 (<=0 时不提升)
+    int aging_interval;         // 抢占式优先级：每等待多少时间单位优先级加1 (<=0 时不老化)
+    int min_granularity;        // CFS最小时间片 (<=0 时为1)
+    int target_latency;         // CFS调度周期，所有就绪进程在此周期内各运行一次 (<=0 时为24)
+    int time_limit;             // >0 时运行到该时刻即停止 (RR/CFS/Stride/Lottery，用于公平性实验)
+    unsigned int random_seed;   // 彩票调度的随机种子
+    int admission_control;      // EDF：非零时对截止期限作业做利用率测试，未通过的降级为后台作业
+    int verbose;                // 非零时打印调度事件
+    ExecTrace *trace;           // 非NULL时记录执行段，用于绘制甘特图
+    CompletionStats *stats;     // 非NULL时每个进程完成时记录其周转、等待和响应时间
+    DeadlineStats *deadline_stats; // 非NULL时记录截止期限作业的错过率和超期时长
+    int io_devices;             // 模拟的I/O设备数 (<=0 时不模拟I/O，所有进程视为纯CPU作业)
+    int io_latency[IO_MAX_DEVICES]; // 各设备服务一个请求的时间 (<=0 时为 IO_DEFAULT_LATENCY)
+    IoStats *io_stats;          // 非NULL时记录CPU与设备的忙碌时间及其重叠
+    CheckpointConfig *checkpoint; // 非NULL时定期写检查点或从检查点恢复（执行记录不保存）
+} SchedConfig;
+
+// 调度模拟函数（无界面、无延时，可在多个线程中同时运行）
+int run_simulation(PCB *processes, int count, const SchedConfig *config);
+void sched_config_defaults(SchedConfig *config, SchedAlgorithm algorithm);
+const char* sched_algorithm_name(SchedAlgorithm algorithm);
+int parse_sched_algorithm(const char *name);
+int sched_uses_quantum(SchedAlgorithm algorithm);
+int priority_to_weight(int priority);
+int priority_to_tickets(int priority);
+void simulator_register_metrics();
+
+// 工作负载函数
+PCB* generate_workload(int count, unsigned int seed);
+PCB* load_workload(const char *path, int *count);
+PCB* copy_processes(const PCB *processes, int count);
+void assign_deadlines(PCB *processes, int count, unsigned int seed, int percent);
+void assign_io_bursts(PCB *processes, int count, unsigned int seed, int percent, int devices);
+int* sort_by_arrival(const PCB *processes, int count);
+
+#endif // SIMULATOR_H
@@ -0,0 +1,491 @@
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <sched.h>
+#include <poll.h>
+#include <signal.h>
+#include <spawn.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include "process_control.h"
+#include "spawn.h"
+#include "stats.h"
+#include "timeutil.h"
+#include "visualization.h"
+
+#define CLONE_STACK_SIZE (64 * 1024)
+#define POOL_QUEUE_DEPTH 16     // 每个预派生子进程最多排队的作业数，超过后 submit 阻塞
+
+// 结果表各列的显示宽度
+static const int spawn_widths[] = {11, 10, 8, 8, 8, 9, 8, 8, 8, 8};
+#define SPAWN_COLUMNS ((int)(sizeof(spawn_widths) / sizeof(spawn_widths[0])))
+static const int concurrent_widths[] = {11, 8, 10, 10};
+#define CONCURRENT_COLUMNS ((int)(sizeof(concurrent_widths) / sizeof(concurrent_widths[0])))
+
+extern char **environ;
+
+static const char *method_names[SPAWN_METHOD_COUNT] = {
+    "fork", "vfork", "clone", "posix_spawn", "fork+exec", "pool"
+};
+
+// 交给预派生子进程的作业
+typedef struct {
+    char name[32];
+    int service_time;
+} PoolJob;
+
+// 预派生子进程：通过 job_fd 接收作业，完成后向 done_fd 写一个字节
+typedef struct {
+    pid_t pid;
+    int job_fd;                 // 父进程写端
+    int done_fd;                // 父进程读端
+    long long submitted;        // 已交给该子进程的作业数
+    long long completed;        // 已读到完成回报的作业数
+} PoolWorker;
+
+static PoolWorker pool_workers[POOL_MAX_WORKERS];
+static int pool_count = 0;
+
+const char* spawn_method_name(SpawnMethod method) {
+    if (method < 0 || method >= SPAWN_METHOD_COUNT) return "?";
+    return method_names[method];
+}
+
+// 预派生子进程的主循环：读作业、执行、回报，父进程关闭管道后退出
+static void pool_worker_loop(int job_fd, int done_fd) {
+    PoolJob job;
+    char done = 1;
+
+    while (read(job_fd, &job, sizeof(job)) == (ssize_t)sizeof(job)) {
+        run_process_task(job.name, job.service_time);
+        fflush(stdout);
+        if (write(done_fd, &done, 1) != 1) break;
+    }
+    _exit(0);
+}
+
+/**
+ * 启动预派生进程池
+ * @param size 常驻子进程数，不超过 POOL_MAX_WORKERS
+ * @return 实际启动的子进程数，失败返回-1
+ */
+int process_pool_start(int size) {
+    if (pool_count > 0) process_pool_stop();
+    if (size > POOL_MAX_WORKERS) size = POOL_MAX_WORKERS;
+
+    fflush(stdout);
+    for (int i = 0; i < size; i++) {
+        int job_pipe[2], done_pipe[2];
+        if (pipe(job_pipe) != 0) break;
+        if (pipe(done_pipe) != 0) {
+            close(job_pipe[0]);
+            close(job_pipe[1]);
+            break;
+        }
+
+        pid_t pid = fork();
+        if (pid < 0) {
+            perror("fork失败");
+            close(job_pipe[0]);
+            close(job_pipe[1]);
+            close(done_pipe[0]);
+            close(done_pipe[1]);
+            break;
+        }
+        if (pid == 0) {
+            // 关闭继承来的其他子进程的管道，否则它们收不到结束信号
+            for (int w = 0; w < pool_count; w++) {
+                close(pool_workers[w].job_fd);
+                close(pool_workers[w].done_fd);
+            }
+            close(job_pipe[1]);
+            close(done_pipe[0]);
+            pool_worker_loop(job_pipe[0], done_pipe[1]);
+        }
+
+        close(job_pipe[0]);
+        close(done_pipe[1]);
+        pool_workers[pool_count].pid = pid;
+        pool_workers[pool_count].job_fd = job_pipe[1];
+        pool_workers[pool_count].done_fd = done_pipe[0];
+        pool_workers[pool_count].submitted = 0;
+        pool_workers[pool_count].completed = 0;
+        pool_count++;
+    }
+
+    return pool_count > 0 ? pool_count : -1;
+}
+
+/**
+ * 结束进程池中的所有子进程并回收
+ */
+void process_pool_stop(void) {
+    for (int i = 0; i < pool_count; i++) {
+        close(pool_workers[i].job_fd);
+        close(pool_workers[i].done_fd);
+        kill(pool_workers[i].pid, SIGTERM);
+    }
+    for (int i = 0; i < pool_count; i++) {
+        waitpid(pool_workers[i].pid, NULL, 0);
+    }
+    pool_count = 0;
+}
+
+/**
+ * 进程池中的子进程数
+ */
+int process_pool_size(void) {
+    return pool_count;
+}
+
+// 读取子进程的完成回报，timeout 为 poll 超时（毫秒，-1 表示一直等）
+// @return 读到回报的子进程数
+static int pool_collect(int timeout) {
+    struct pollfd fds[POOL_MAX_WORKERS];
+    int nfds = 0;
+
+    for (int i = 0; i < pool_count; i++) {
+        if (pool_workers[i].completed == pool_workers[i].submitted) continue;
+        fds[nfds].fd = pool_workers[i].done_fd;
+        fds[nfds].events = POLLIN;
+        fds[nfds].revents = 0;
+        nfds++;
+    }
+    if (nfds == 0) return 0;
+
+    int ready;
+    do {
+        ready = poll(fds, nfds, timeout);
+    } while (ready < 0 && errno == EINTR);
+    if (ready <= 0) return 0;
+
+    int collected = 0;
+    for (int k = 0; k < nfds; k++) {
+        if (fds[k].revents == 0) continue;
+        for (int i = 0; i < pool_count; i++) {
+            PoolWorker *w = &pool_workers[i];
+            if (w->done_fd != fds[k].fd) continue;
+
+            // 只读已交出的作业数，避免阻塞；子进程异常退出时把作业都记为完成
+            char done[POOL_QUEUE_DEPTH];
+            long long pending = w->submitted - w->completed;
+            ssize_t n = read(w->done_fd, done, pending < POOL_QUEUE_DEPTH ? (size_t)pending : sizeof(done));
+            if (n > 0) {
+                w->completed += n;
+            } else if (n == 0) {
+                w->completed = w->submitted;
+            }
+            collected++;
+        }
+    }
+    return collected;
+}
+
+/**
+ * 把作业交给预派生子进程：优先选空闲的，否则排到积压最少的子进程后面；
+ * 所有子进程都积压满 POOL_QUEUE_DEPTH 个作业时阻塞，直到有作业完成
+ * @param ticket 输出该作业在子进程上的序号，等待时传给 process_pool_wait
+ * @return 执行作业的子进程pid；进程池未启动或写管道失败时返回-1
+ */
+pid_t process_pool_submit(const char *name, int service_time, long long *ticket) {
+    if (pool_count == 0) return -1;
+
+    // 先不等待地收一遍完成回报，让 submitted - completed 反映真实积压
+    pool_collect(0);
+
+    PoolWorker *w = NULL;
+    while (w == NULL) {
+        for (int i = 0; i < pool_count; i++) {
+            PoolWorker *c = &pool_workers[i];
+            if (c->submitted - c->completed >= POOL_QUEUE_DEPTH) continue;
+            if (w == NULL || c->submitted - c->completed < w->submitted - w->completed) w = c;
+        }
+        if (w == NULL && pool_collect(-1) == 0) return -1;
+    }
+
+    PoolJob job;
+    memset(&job, 0, sizeof(job));
+    strncpy(job.name, name, sizeof(job.name) - 1);
+    job.service_time = service_time;
+
+    if (write(w->job_fd, &job, sizeof(job)) != (ssize_t)sizeof(job)) return -1;
+    w->submitted++;
+    if (ticket != NULL) *ticket = w->submitted;
+    return w->pid;
+}
+
+/**
+ * 等待预派生子进程完成指定作业（同一子进程上的作业按提交顺序完成）
+ * @param ticket process_pool_submit 返回的作业序号
+ * @return 成功返回0；worker 不属于进程池时返回-1
+ */
+int process_pool_wait(pid_t worker, long long ticket) {
+    for (int i = 0; i < pool_count; i++) {
+        PoolWorker *w = &pool_workers[i];
+        if (w->pid != worker) continue;
+
+        while (w->completed < ticket) {
+            if (pool_collect(-1) == 0) break;
+        }
+        return 0;
+    }
+    return -1;
+}
+
+static int clone_child(void *arg) {
+    (void)arg;
+    return 0;
+}
+
+// 用指定方式创建一个立即结束的子进程，返回其pid（进程池返回执行作业的子进程pid），失败返回-1
+static pid_t spawn_one(SpawnMethod method, char *stack_top, long long *ticket) {
+    static char *true_argv[] = { "/bin/true", NULL };
+    pid_t pid = -1;
+
+    switch (method) {
+        case SPAWN_FORK:
+            pid = fork();
+            if (pid == 0) _exit(0);
+            break;
+        case SPAWN_VFORK:
+            pid = vfork();
+            if (pid == 0) _exit(0);
+            break;
+        case SPAWN_CLONE:
+            pid = clone(clone_child, stack_top, SIGCHLD, NULL);
+            break;
+        case SPAWN_POSIX_SPAWN:
+            if (posix_spawn(&pid, true_argv[0], NULL, NULL, true_argv, environ) != 0) pid = -1;
+            break;
+        case SPAWN_FORK_EXEC:
+            pid = fork();
+            if (pid == 0) {
+                execv(true_argv[0], true_argv);
+                _exit(127);
+            }
+            break;
+        case SPAWN_POOL:
+            pid = process_pool_submit("bench", 0, ticket);
+            break;
+        default:
+            break;
+    }
+    return pid;
+}
+
+// 回收 spawn_one 创建的子进程
+static int reap_one(SpawnMethod method, pid_t pid, long long ticket) {
+    if (method == SPAWN_POOL) {
+        return process_pool_wait(pid, ticket);
+    }
+
+    int status;
+    pid_t r;
+    do {
+        r = waitpid(pid, &status, 0);
+    } while (r < 0 && errno == EINTR);
+    return r == pid ? 0 : -1;
+}
+
+// 对一种创建方式跑 iterations 次，创建和回收延迟分别记录到两个直方图（纳秒）
+static int bench_method(SpawnMethod method, int iterations, Histogram *create, Histogram *reap,
+                        double *elapsed_ms) {
+    char *stack = (char*)malloc(CLONE_STACK_SIZE);
+    if (stack == NULL) return -1;
+
+    hist_init(create);
+    hist_init(reap);
+
+    long long begin = now_ns();
+    for (int i = 0; i < iterations; i++) {
+        long long ticket = 0;
+        long long t0 = now_ns();
+        pid_t pid = spawn_one(method, stack + CLONE_STACK_SIZE, &ticket);
+        long long t1 = now_ns();
+        if (pid < 0) {
+            free(stack);
+            return -1;
+        }
+        if (reap_one(method, pid, ticket) != 0) {
+            free(stack);
+            return -1;
+        }
+        long long t2 = now_ns();
+
+        hist_record(create, (int)(t1 - t0));
+        hist_record(reap, (int)(t2 - t1));
+    }
+    *elapsed_ms = (now_ns() - begin) / 1e6;
+
+    free(stack);
+    return 0;
+}
+
+// 一次同时发起 jobs 个作业再逐个回收，进程池在子进程都忙时排队而不是另外 fork
+// @return 成功返回0，总耗时写入 elapsed_ms
+static int bench_concurrent(SpawnMethod method, int jobs, double *elapsed_ms) {
+    char *stack = (char*)malloc(CLONE_STACK_SIZE);
+    pid_t *pids = (pid_t*)malloc(sizeof(pid_t) * jobs);
+    long long *tickets = (long long*)malloc(sizeof(long long) * jobs);
+    if (stack == NULL || pids == NULL || tickets == NULL) {
+        free(stack);
+        free(pids);
+        free(tickets);
+        return -1;
+    }
+
+    int rc = 0;
+    int spawned = 0;
+    long long begin = now_ns();
+    for (; spawned < jobs; spawned++) {
+        tickets[spawned] = 0;
+        pids[spawned] = spawn_one(method, stack + CLONE_STACK_SIZE, &tickets[spawned]);
+        if (pids[spawned] < 0) {
+            rc = -1;
+            break;
+        }
+    }
+    // 失败时也要回收已创建的子进程
+    for (int i = 0; i < spawned; i++) {
+        if (reap_one(method, pids[i], tickets[i]) != 0) rc = -1;
+    }
+    *elapsed_ms = (now_ns() - begin) / 1e6;
+
+    free(stack);
+    free(pids);
+    free(tickets);
+    return rc;
+}
+
+static void print_spawn_usage(const char *prog) {
+    print_colored("用法: %s spawn [选项]\n", YELLOW, prog);
+    print_colored("  -n 次数    每种方式创建的进程数 (默认 2000)\n", WHITE);
+    print_colored("  -m MB      测试前父进程先占用并写入的内存，用于观察 fork 复制页表的开销 (默认 0)\n", WHITE);
+    print_colored("  -p 数量    预派生进程池大小 (默认 4)\n", WHITE);
+    print_colored("  -c 数量    并发测试中同时发起的作业数，0 表示跳过 (默认 64)\n", WHITE);
+}
+
+/**
+ * 进程创建与回收基准命令行入口：比较 fork/vfork/clone/posix_spawn/fork+exec 与预派生进程池
+ * @return 进程退出码
+ */
+int spawn_main(int argc, char *argv[]) {
+    int iterations = 2000;
+    int resident_mb = 0;
+    int pool_size = 4;
+    int concurrent = 64;
+
+    for (int i = 1; i < argc; i += 2) {
+        const char *opt = argv[i];
+        const char *value = (i + 1 < argc) ? argv[i + 1] : NULL;
+
+        if (value == NULL || opt[0] != '-' || opt[1] == '\0' || opt[2] != '\0') {
+            print_spawn_usage(argv[0]);
+            return 1;
+        }
+
+        switch (opt[1]) {
+            case 'n': iterations = atoi(value); break;
+            case 'm': resident_mb = atoi(value); break;
+            case 'p': pool_size = atoi(value); break;
+            case 'c': concurrent = atoi(value); break;
+            default:
+                print_spawn_usage(argv[0]);
+                return 1;
+        }
+    }
+    if (iterations <= 0 || concurrent < 0) {
+        print_colored("次数必须大于0，并发作业数不能为负\n", RED);
+        return 1;
+    }
+
+    // 父进程占用的内存越多，fork 复制页表越慢；vfork/posix_spawn 不受影响
+    char *resident = NULL;
+    if (resident_mb > 0) {
+        resident = (char*)malloc((size_t)resident_mb << 20);
+        if (resident != NULL) {
+            memset(resident, 1, (size_t)resident_mb << 20);
+        }
+    }
+
+    Histogram *create = (Histogram*)malloc(sizeof(Histogram));
+    Histogram *reap = (Histogram*)malloc(sizeof(Histogram));
+    if (create == NULL || reap == NULL) {
+        free(create);
+        free(reap);
+        free(resident);
+        return 1;
+    }
+
+    // 进程池子进程继承静默模式，执行基准作业时不输出
+    int was_quiet = is_quiet_mode();
+    set_quiet_mode(1);
+    int started = process_pool_start(pool_size);
+    set_quiet_mode(was_quiet);
+    if (started < 0) {
+        print_colored("预派生进程池启动失败\n", RED);
+    }
+
+    print_colored("进程创建基准: 每种方式 %d 次, 父进程常驻内存 %d MB, 进程池 %d 个子进程 (延迟单位: 微秒)\n",
+                 CYAN, iterations, resident_mb, process_pool_size());
+    print_table_rule(WHITE, spawn_widths, SPAWN_COLUMNS);
+    print_table_row(WHITE, spawn_widths, SPAWN_COLUMNS,
+                    "方式", "次数/秒", "创建P50", "创建P90", "创建P99", "创建P99.9", "创建最大",
+                    "回收P50", "回收P99", "回收最大");
+    print_table_rule(WHITE, spawn_widths, SPAWN_COLUMNS);
+
+    for (int m = 0; m < SPAWN_METHOD_COUNT; m++) {
+        SpawnMethod method = (SpawnMethod)m;
+        if (method == SPAWN_POOL && process_pool_size() == 0) continue;
+
+        double elapsed = 0.0;
+        fflush(stdout);
+        int rc = bench_method(method, iterations, create, reap, &elapsed);
+
+        if (rc != 0) {
+            print_colored("| %-11s | 失败: %s\n", RED, spawn_method_name(method), strerror(errno));
+            continue;
+        }
+
+        print_colored("| %-11s | %-10.0f | %-8.1f | %-8.1f | %-8.1f | %-9.1f | %-8.1f | %-8.1f | %-8.1f | %-8.1f |\n",
+                     WHITE, spawn_method_name(method), elapsed > 0 ? iterations * 1000.0 / elapsed : 0.0,
+                     hist_percentile(create, 0.50) / 1e3, hist_percentile(create, 0.90) / 1e3,
+                     hist_percentile(create, 0.99) / 1e3, hist_percentile(create, 0.999) / 1e3,
+                     create->max / 1e3, hist_percentile(reap, 0.50) / 1e3,
+                     hist_percentile(reap, 0.99) / 1e3, reap->max / 1e3);
+    }
+    print_table_rule(WHITE, spawn_widths, SPAWN_COLUMNS);
+    print_colored("vfork 的创建延迟包含子进程运行到 _exit；posix_spawn 与 fork+exec 的回收延迟包含执行 /bin/true\n", WHITE);
+
+    if (concurrent > 0) {
+        print_colored("\n并发创建: 每种方式同时发起 %d 个作业后再统一回收，进程池的子进程都忙时作业排队\n",
+                     CYAN, concurrent);
+        print_table_rule(WHITE, concurrent_widths, CONCURRENT_COLUMNS);
+        print_table_row(WHITE, concurrent_widths, CONCURRENT_COLUMNS, "方式", "作业数", "总耗时ms", "作业/秒");
+        print_table_rule(WHITE, concurrent_widths, CONCURRENT_COLUMNS);
+        for (int m = 0; m < SPAWN_METHOD_COUNT; m++) {
+            SpawnMethod method = (SpawnMethod)m;
+            if (method == SPAWN_POOL && process_pool_size() == 0) continue;
+
+            double elapsed = 0.0;
+            fflush(stdout);
+            if (bench_concurrent(method, concurrent, &elapsed) != 0) {
+                print_colored("| %-11s | 失败: %s\n", RED, spawn_method_name(method), strerror(errno));
+                continue;
+            }
+            print_colored("| %-11s | %-8d | %-10.2f | %-10.0f |\n", WHITE, spawn_method_name(method),
+                         concurrent, elapsed, elapsed > 0 ? concurrent * 1000.0 / elapsed : 0.0);
+        }
+        print_table_rule(WHITE, concurrent_widths, CONCURRENT_COLUMNS);
+    }
+
+    process_pool_stop();
+    free(create);
+    free(reap);
+    free(resident);
+    return 0;
+}
@@ -0,0 +1,30 @@
+#ifndef SPAWN_H
+#define SPAWN_H
+
+#include <sys/types.h>
+
+#define POOL_MAX_WORKERS 64
+
+// 进程创建方式
+typedef enum {
+    SPAWN_FORK,         // fork，子进程立即 _exit
+    SPAWN_VFORK,        // vfork，父进程挂起直到子进程 _exit
+    SPAWN_CLONE,        // clone(SIGCHLD)，不经过 glibc 的 fork 处理函数
+    SPAWN_POSIX_SPAWN,  // posix_spawn 执行 /bin/true
+    SPAWN_FORK_EXEC,    // fork + execv 执行 /bin/true，与 posix_spawn 对照
+    SPAWN_POOL,         // 把作业交给预派生进程池中的常驻子进程
+    SPAWN_METHOD_COUNT
+} SpawnMethod;
+
+// 预派生进程池函数（进程池启动后 create_process 把作业都交给池中子进程，忙时排队）
+int process_pool_start(int size);
+void process_pool_stop(void);
+int process_pool_size(void);
+pid_t process_pool_submit(const char *name, int service_time, long long *ticket);
+int process_pool_wait(pid_t worker, long long ticket);
+
+// 进程创建基准函数
+const char* spawn_method_name(SpawnMethod method);
+int spawn_main(int argc, char *argv[]);
+
+#endif // SPAWN_H
@@ -0,0 +1,250 @@
+#include <stdio.h>
+#include <string.h>
+#include "stats.h"
+#include "visualization.h"
+
+#define HIST_SUB_COUNT (1 << HIST_SUB_BITS)
+
+// 数值所在的桶：[0, 2^SUB) 每个值一个桶，之后每个2的幂区间 [2^k, 2^(k+1)) 分为 2^SUB 个桶
+static int bucket_of(int value) {
+    if (value < HIST_SUB_COUNT) return value;
+
+    int shift = (31 - __builtin_clz((unsigned int)value)) - HIST_SUB_BITS;
+    return (shift << HIST_SUB_BITS) + (value >> shift);
+}
+
+// 桶内的最大值
+static int bucket_upper(int bucket) {
+    if (bucket < 2 * HIST_SUB_COUNT) return bucket;
+
+    int shift = (bucket >> HIST_SUB_BITS) - 1;
+    long long low = (long long)(bucket - (shift << HIST_SUB_BITS)) << shift;
+    long long high = low + (1LL << shift) - 1;
+    return high > 0x7fffffff ? 0x7fffffff : (int)high;
+}
+
+/**
+ * 初始化直方图
+ */
+void hist_init(Histogram *hist) {
+    memset(hist->counts, 0, sizeof(hist->counts));
+    hist->total = 0;
+    hist->sum = 0.0;
+    hist->min = 0;
+    hist->max = 0;
+}
+
+/**
+ * 记录一个数值，负数按0计，O(1)
+ */
+void hist_record(Histogram *hist, int value) {
+    if (value < 0) value = 0;
+
+    hist->counts[bucket_of(value)]++;
+    if (hist->total == 0 || value < hist->min) hist->min = value;
+    if (hist->total == 0 || value > hist->max) hist->max = value;
+    hist->total++;
+    hist->sum += value;
+}
+
+/**
+ * 把 src 合并到 dst，合并结果与把两组数值记录到同一个直方图相同
+ */
+void hist_merge(Histogram *dst, const Histogram *src) {
+    if (src->total == 0) return;
+
+    for (int i = 0; i < HIST_BUCKETS; i++) {
+        dst->counts[i] += src->counts[i];
+    }
+    if (dst->total == 0 || src->min < dst->min) dst->min = src->min;
+    if (dst->total == 0 || src->max > dst->max) dst->max = src->max;
+    dst->total += src->total;
+    dst->sum += src->sum;
+}
+
+/**
+ * 最近秩法取分位数
+ * @param p 分位 (0, 1]
+ * @return 第 ceil(p * total) 个数值所在桶的上界（不超过最大值），直方图为空时返回0
+ */
+int hist_percentile(const Histogram *hist, double p) {
+    if (hist->total == 0) return 0;
+
+    long long rank = (long long)(p * hist->total + 0.999999);
+    if (rank < 1) rank = 1;
+    if (rank > hist->total) rank = hist->total;
+
+    long long seen = 0;
+    for (int i = 0; i < HIST_BUCKETS; i++) {
+        seen += hist->counts[i];
+        if (seen >= rank) {
+            int value = bucket_upper(i);
+            return value < hist->max ? value : hist->max;
+        }
+    }
+    return hist->max;
+}
+
+/**
+ * 均值，直方图为空时返回0
+ */
+double hist_mean(const Histogram *hist) {
+    return hist->total > 0 ? hist->sum / hist->total : 0.0;
+}
+
+/**
+ * 初始化完成统计
+ */
+void completion_stats_init(CompletionStats *stats) {
+    hist_init(&stats->turnaround);
+    hist_init(&stats->waiting);
+    hist_init(&stats->response);
+}
+
+/**
+ * 记录一个已完成进程的周转、等待和响应时间
+ */
+void completion_stats_record(CompletionStats *stats, const PCB *process) {
+    hist_record(&stats->turnaround, process->turnaround_time);
+    hist_record(&stats->waiting, process->waiting_time);
+    hist_record(&stats->response, process->start_time >= 0 ? process->start_time - process->arrive_time : 0);
+}
+
+/**
+ * 合并完成统计（并行实验或多个核的结果）
+ */
+void completion_stats_merge(CompletionStats *dst, const CompletionStats *src) {
+    hist_merge(&dst->turnaround, &src->turnaround);
+    hist_merge(&dst->waiting, &src->waiting);
+    hist_merge(&dst->response, &src->response);
+}
+
+static void print_hist_row(const char *label, const Histogram *hist) {
+    print_colored("| %-8s | %-10.2f | %-8d | %-8d | %-8d | %-8d | %-8d |\n", WHITE, label,
+                 hist_mean(hist), hist_percentile(hist, 0.50), hist_percentile(hist, 0.90),
+                 hist_percentile(hist, 0.99), hist_percentile(hist, 0.999), hist->max);
+}
+
+/**
+ * 打印完成统计的均值与尾部分位数
+ */
+void print_completion_stats(const CompletionStats *stats) {
+    print_colored("\n尾部统计 (%lld 个已完成进程):\n", CYAN, stats->turnaround.total);
+    print_colored("------------------------------------------------------------------------------\n", WHITE);
+    print_colored("| %-8s | %-10s | %-8s | %-8s | %-8s | %-8s | %-8s |\n", WHITE,
+                 "指标", "平均", "P50", "P90", "P99", "P99.9", "最大");
+    print_colored("------------------------------------------------------------------------------\n", WHITE);
+    print_hist_row("周转", &stats->turnaround);
+    print_hist_row("等待", &stats->waiting);
+    print_hist_row("响应", &stats->response);
+    print_colored("------------------------------------------------------------------------------\n", WHITE);
+}
+
+/**
+ * 初始化截止期限统计
+ */
+void deadline_stats_init(DeadlineStats *stats) {
+    stats->jobs = 0;
+    stats->missed = 0;
+    stats->rejected = 0;
+    stats->lateness_sum = 0.0;
+    hist_init(&stats->tardiness);
+}
+
+/**
+ * 记录一个已完成的截止期限作业，没有截止期限的进程被忽略
+ */
+void deadline_stats_record(DeadlineStats *stats, const PCB *process) {
+    if (process->deadline <= 0) return;
+
+    int lateness = process->completion_time - (process->arrive_time + process->deadline);
+    stats->jobs++;
+    stats->lateness_sum += lateness;
+    if (lateness > 0) stats->missed++;
+    hist_record(&stats->tardiness, lateness > 0 ? lateness : 0);
+}
+
+/**
+ * 合并截止期限统计
+ */
+void deadline_stats_merge(DeadlineStats *dst, const DeadlineStats *src) {
+    dst->jobs += src->jobs;
+    dst->missed += src->missed;
+    dst->rejected += src->rejected;
+    dst->lateness_sum += src->lateness_sum;
+    hist_merge(&dst->tardiness, &src->tardiness);
+}
+
+/**
+ * 错过率：错过截止期限的作业占已接纳作业的比例
+ */
+double deadline_miss_rate(const DeadlineStats *stats) {
+    return stats->jobs > 0 ? (double)stats->missed / stats->jobs : 0.0;
+}
+
+/**
+ * 打印错过率与超期时长分位数
+ */
+void print_deadline_stats(const DeadlineStats *stats) {
+    print_colored("\n截止期限统计 (%lld 个已接纳作业, %lld 个被拒绝):\n", CYAN, stats->jobs, stats->rejected);
+    print_colored("错过 %lld 个 (%.2f%%), 平均延迟 %.2f\n", stats->missed > 0 ? RED : GREEN,
+                 stats->missed, deadline_miss_rate(stats) * 100,
+                 stats->jobs > 0 ? stats->lateness_sum / stats->jobs : 0.0);
+    print_colored("------------------------------------------------------------------------------\n", WHITE);
+    print_colored("| %-8s | %-10s | %-8s | %-8s | %-8s | %-8s | %-8s |\n", WHITE,
+                 "指标", "平均", "P50", "P90", "P99", "P99.9", "最大");
+    print_colored("------------------------------------------------------------------------------\n", WHITE);
+    print_hist_row("超期", &stats->tardiness);
+    print_colored("------------------------------------------------------------------------------\n", WHITE);
+}
+
+/**
+ * 初始化I/O统计
+ */
+void io_stats_init(IoStats *stats) {
+    memset(stats, 0, sizeof(IoStats));
+}
+
+/**
+ * 记录一段CPU执行 [start, start + ran)
+ * 请求只在某个进程让出CPU时提交，执行段开始时所有可能与之重叠的设备忙碌区间都已知，
+ * 且它们都从 start 之前持续到 busy_until，因此重叠部分就是 [start, busy_until) 与执行段的交集
+ */
+void io_stats_record_cpu(IoStats *stats, int start, int ran) {
+    int overlap = stats->busy_until - start;
+    if (overlap > ran) overlap = ran;
+
+    stats->cpu_busy += ran;
+    if (overlap > 0) stats->overlap += overlap;
+}
+
+/**
+ * 记录一个在 issue 时刻提交、在 [start, end) 内被服务的I/O请求
+ * @param depth 提交时该设备上的请求数（含本次）
+ */
+void io_stats_record_request(IoStats *stats, int issue, int start, int end, int depth) {
+    // 设备忙碌区间的并集从 busy_until 或 issue 起向后延伸
+    int from = stats->busy_until > issue ? stats->busy_until : issue;
+    if (end > from) {
+        stats->io_busy += end - from;
+        stats->busy_until = end;
+    }
+
+    stats->requests++;
+    stats->queue_wait += start - issue;
+    if (depth > stats->max_queue) stats->max_queue = depth;
+}
+
+/**
+ * 打印CPU利用率、设备忙碌率与I/O重叠
+ */
+void print_io_stats(const IoStats *stats, int makespan) {
+    double span = makespan > 0 ? makespan : 1;
+
+    print_colored("\nI/O统计 (%lld 个请求):\n", CYAN, stats->requests);
+    print_colored("CPU利用率: %.2f%%, 设备忙碌: %.2f%%, CPU与I/O重叠: %.2f%% (占I/O时间的 %.2f%%)\n", WHITE,
+                 stats->cpu_busy / span * 100, stats->io_busy / span * 100, stats->overlap / span * 100,
+                 stats->io_busy > 0 ? (double)stats->overlap / stats->io_busy * 100 : 0.0);
+    print_colored("设备排队: 平均等待 %.2f, 最长队列 %d\n", WHITE,
+                 stats->requests > 0 ? (double)stats->queue_wait / stats->requests : 0.0, stats->max_queue);
+}
@@ -0,0 +1,73 @@
+#ifndef STATS_H
+#define STATS_H
+
+#include "process_control.h"
+
+// 对数-线性直方图 (HDR风格)：小于 2^HIST_SUB_BITS 的值精确记录，更大的值在每个2的幂区间内
+// 再均分为 2^HIST_SUB_BITS 个桶，分位数的相对误差小于 1/2^HIST_SUB_BITS。
+// 内存固定，与记录的数值个数无关，两个直方图相加即可合并
+#define HIST_SUB_BITS 7
+#define HIST_BUCKETS ((32 - HIST_SUB_BITS) << HIST_SUB_BITS)
+
+typedef struct {
+    long long counts[HIST_BUCKETS];
+    long long total;            // 记录的数值个数
+    double sum;                 // 数值之和，用于求均值
+    int min;
+    int max;
+} Histogram;
+
+// 完成统计：每个进程完成时更新一次
+typedef struct {
+    Histogram turnaround;       // 周转时间
+    Histogram waiting;          // 等待时间
+    Histogram response;         // 响应时间（首次运行 - 到达）
+} CompletionStats;
+
+// 截止期限统计：有截止期限的进程完成时更新一次
+typedef struct {
+    long long jobs;             // 完成的截止期限作业数
+    long long missed;           // 其中错过截止期限的个数
+    long long rejected;         // 被接纳控制拒绝（降级为后台作业）的个数
+    double lateness_sum;        // 延迟（完成时刻 - 绝对截止期限，可为负）之和
+    Histogram tardiness;        // 超期时长 max(0, 延迟)
+} DeadlineStats;
+
+// I/O统计：CPU与设备的忙碌时间及两者重叠的时间
+typedef struct {
+    long long cpu_busy;         // CPU执行时间
+    long long io_busy;          // 至少一个设备忙碌的时间
+    long long overlap;          // CPU与设备同时忙碌的时间
+    long long requests;         // I/O请求数
+    long long queue_wait;       // 请求在设备队列中等待服务的总时间
+    int max_queue;              // 单个设备上排队（含正在服务）的最大请求数
+    int busy_until;             // 已提交请求使设备保持忙碌到的时刻
+} IoStats;
+
+// 直方图函数
+void hist_init(Histogram *hist);
+void hist_record(Histogram *hist, int value);
+void hist_merge(Histogram *dst, const Histogram *src);
+int hist_percentile(const Histogram *hist, double p);
+double hist_mean(const Histogram *hist);
+
+// 完成统计函数
+void completion_stats_init(CompletionStats *stats);
+void completion_stats_record(CompletionStats *stats, const PCB *process);
+void completion_stats_merge(CompletionStats *dst, const CompletionStats *src);
+void print_completion_stats(const CompletionStats *stats);
+
+// 截止期限统计函数
+void deadline_stats_init(DeadlineStats *stats);
+void deadline_stats_record(DeadlineStats *stats, const PCB *process);
+void deadline_stats_merge(DeadlineStats *dst, const DeadlineStats *src);
+double deadline_miss_rate(const DeadlineStats *stats);
+void print_deadline_stats(const DeadlineStats *stats);
+
+// I/O统计函数
+void io_stats_init(IoStats *stats);
+void io_stats_record_cpu(IoStats *stats, int start, int ran);
+void io_stats_record_request(IoStats *stats, int issue, int start, int end, int depth);
+void print_io_stats(const IoStats *stats, int makespan);
+
+#endif // STATS_H
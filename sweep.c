@@ -0,0 +1,373 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <time.h>
+#include "dashboard.h"
+#include "process_control.h"
+#include "simulator.h"
+#include "sweep.h"
+#include "timeutil.h"
+#include "visualization.h"
+
+#define MAX_SWEEP_JOBS 256
+
+// 线程池共享状态：工作线程从 next_job 依次领取实验点
+typedef struct {
+    const PCB *workload;
+    int count;
+    SweepJob *jobs;
+    int num_jobs;
+    int next_job;
+    pthread_mutex_t mutex;
+    Dashboard *dashboard;       // 实时仪表盘，不显示时为NULL
+} SweepPool;
+
+// 根据模拟后的PCB数组和模拟中在线记录的完成统计汇总一个实验点的结果
+static void summarize_job(SweepJob *job, const PCB *processes, int count, const CompletionStats *stats) {
+    double sum_turnaround = 0.0, sum_weighted = 0.0, sum_waiting = 0.0;
+    double sum_response_short = 0.0, sum_turnaround_long = 0.0;
+    int num_short = 0, num_long = 0, last_long_completion = 0;
+    long long decisions = 0;
+
+    for (int i = 0; i < count; i++) {
+        const PCB *p = &processes[i];
+        sum_turnaround += p->turnaround_time;
+        sum_weighted += p->weighted_turnaround;
+        sum_waiting += p->waiting_time;
+        decisions += p->dispatch_count;
+
+        if (p->service_time <= SHORT_JOB_THRESHOLD) {
+            sum_response_short += p->start_time - p->arrive_time;
+            num_short++;
+        } else {
+            sum_turnaround_long += p->turnaround_time;
+            num_long++;
+            if (p->completion_time > last_long_completion) {
+                last_long_completion = p->completion_time;
+            }
+        }
+    }
+
+    job->avg_turnaround = sum_turnaround / count;
+    job->avg_weighted = sum_weighted / count;
+    job->avg_waiting = sum_waiting / count;
+    job->throughput = job->makespan > 0 ? (double)count / job->makespan : 0.0;
+    job->avg_response_short = num_short > 0 ? sum_response_short / num_short : 0.0;
+    job->avg_turnaround_long = num_long > 0 ? sum_turnaround_long / num_long : 0.0;
+    job->long_throughput = last_long_completion > 0 ? (double)num_long / last_long_completion : 0.0;
+    job->decisions = decisions;
+
+    job->p50_waiting = hist_percentile(&stats->waiting, 0.50);
+    job->p90_waiting = hist_percentile(&stats->waiting, 0.90);
+    job->p99_waiting = hist_percentile(&stats->waiting, 0.99);
+    job->p999_waiting = hist_percentile(&stats->waiting, 0.999);
+    job->max_waiting = stats->waiting.max;
+    job->p99_turnaround = hist_percentile(&stats->turnaround, 0.99);
+}
+
+// 工作线程：每个线程只分配一次PCB副本缓冲区，每个实验点开始前从原始负载复制
+static void* sweep_worker(void *arg) {
+    SweepPool *pool = (SweepPool*)arg;
+    PCB *processes = (PCB*)malloc(sizeof(PCB) * pool->count);
+    CompletionStats *stats = (CompletionStats*)malloc(sizeof(CompletionStats));
+    dashboard_attach(pool->dashboard);
+
+    while (processes != NULL && stats != NULL) {
+        pthread_mutex_lock(&pool->mutex);
+        int j = pool->next_job++;
+        pthread_mutex_unlock(&pool->mutex);
+
+        dashboard_set_depth(j < pool->num_jobs ? pool->num_jobs - j - 1 : 0);
+        if (j >= pool->num_jobs) break;
+
+        SweepJob *job = &pool->jobs[j];
+        memcpy(processes, pool->workload, sizeof(PCB) * pool->count);
+        completion_stats_init(stats);
+
+        SchedConfig config = job->config;
+        config.stats = stats;
+
+        double start = now_ms();
+        job->makespan = run_simulation(processes, pool->count, &config);
+        job->elapsed_ms = now_ms() - start;
+        job->ok = job->makespan >= 0;
+
+        if (job->ok) {
+            summarize_job(job, processes, pool->count, stats);
+        }
+    }
+
+    dashboard_detach();
+    free(processes);
+    free(stats);
+    return NULL;
+}
+
+/**
+ * 在线程池上并行运行所有实验点
+ * @param workload 原始工作负载（只读，每个实验点使用独立副本）
+ * @param count 进程数量
+ * @param jobs 实验点数组，结果写回其中
+ * @param num_jobs 实验点数量
+ * @param num_threads 线程数，<=0 时使用全部在线CPU
+ * @param refresh_hz 实时仪表盘每秒刷新次数，0 表示不显示
+ * @return 成功返回0，失败返回-1
+ */
+int run_sweep(const PCB *workload, int count, SweepJob *jobs, int num_jobs, int num_threads,
+              int refresh_hz) {
+    if (workload == NULL || count <= 0 || jobs == NULL || num_jobs <= 0) return -1;
+
+    if (num_threads <= 0) {
+        num_threads = (int)sysconf(_SC_NPROCESSORS_ONLN);
+    }
+    if (num_threads < 1) num_threads = 1;
+    if (num_threads > num_jobs) num_threads = num_jobs;
+
+    SweepPool pool = { workload, count, jobs, num_jobs, 0, PTHREAD_MUTEX_INITIALIZER, NULL };
+    pthread_t *threads = (pthread_t*)malloc(sizeof(pthread_t) * num_threads);
+    if (threads == NULL) {
+        perror("创建线程池失败");
+        return -1;
+    }
+
+    for (int i = 0; i < num_jobs; i++) {
+        jobs[i].ok = 0;
+    }
+
+    // 工作线程中不允许任何终端输出，仪表盘由单独的显示线程绘制
+    int was_quiet = is_quiet_mode();
+    set_quiet_mode(1);
+    if (refresh_hz > 0) {
+        pool.dashboard = create_dashboard("参数扫描", num_threads, refresh_hz);
+        start_dashboard(pool.dashboard);
+    }
+
+    int started = 0;
+    for (int i = 0; i < num_threads; i++) {
+        if (pthread_create(&threads[i], NULL, sweep_worker, &pool) != 0) {
+            break;
+        }
+        started++;
+    }
+    // 如果一个线程都没有创建成功，就在当前线程中完成
+    if (started == 0) {
+        sweep_worker(&pool);
+    }
+    for (int i = 0; i < started; i++) {
+        pthread_join(threads[i], NULL);
+    }
+
+    stop_dashboard(pool.dashboard);
+    destroy_dashboard(pool.dashboard);
+    set_quiet_mode(was_quiet);
+    pthread_mutex_destroy(&pool.mutex);
+    free(threads);
+    return 0;
+}
+
+// 结果表各列的显示宽度，与 print_sweep_results 中数据行的格式一致
+static const int sweep_widths[] = {10, 4, 9, 8, 6, 8, 6, 6, 6, 6, 8, 10, 10, 10, 7, 8};
+#define SWEEP_COLUMNS (int)(sizeof(sweep_widths) / sizeof(sweep_widths[0]))
+
+/**
+ * 打印参数扫描结果表
+ */
+void print_sweep_results(const SweepJob *jobs, int num_jobs) {
+    print_colored("\n参数扫描结果：\n", CYAN);
+    print_table_rule(WHITE, sweep_widths, SWEEP_COLUMNS);
+    print_table_row(WHITE, sweep_widths, SWEEP_COLUMNS, "算法", "片长", "吞吐量", "平均周转", "带权", "平均等待",
+                    "P50", "P90", "P99", "P99.9", "最大等待", "短作业响应", "长作业周转", "长作业吞吐", "ns/决策", "耗时ms");
+    print_table_rule(WHITE, sweep_widths, SWEEP_COLUMNS);
+
+    for (int i = 0; i < num_jobs; i++) {
+        const SweepJob *job = &jobs[i];
+        char quantum[16] = "-";
+
+        if (sched_uses_quantum(job->config.algorithm)) {
+            snprintf(quantum, sizeof(quantum), "%d", job->config.time_quantum);
+        }
+
+        if (!job->ok) {
+            print_colored("| %-10s | %-4s | 模拟失败\n", RED,
+                         sched_algorithm_name(job->config.algorithm), quantum);
+            continue;
+        }
+
+        print_colored("| %-10s | %-4s | %-9.5f | %-8.1f | %-6.2f | %-8.1f | %-6d | %-6d | %-6d | %-6d | %-8d | %-10.1f | %-10.1f | %-10.5f | %-7.1f | %-8.1f |\n",
+                     WHITE, sched_algorithm_name(job->config.algorithm), quantum,
+                     job->throughput, job->avg_turnaround, job->avg_weighted, job->avg_waiting,
+                     job->p50_waiting, job->p90_waiting, job->p99_waiting, job->p999_waiting, job->max_waiting,
+                     job->avg_response_short, job->avg_turnaround_long, job->long_throughput,
+                     job->decisions > 0 ? job->elapsed_ms * 1e6 / job->decisions : 0.0,
+                     job->elapsed_ms);
+    }
+
+    print_table_rule(WHITE, sweep_widths, SWEEP_COLUMNS);
+    print_colored("短作业: 服务时间 <= %d\n", WHITE, SHORT_JOB_THRESHOLD);
+}
+
+/**
+ * 解析逗号分隔的正整数列表，忽略非正数
+ * @return 解析出的个数
+ */
+int parse_int_list(const char *text, int *values, int max_values) {
+    int n = 0;
+    char buffer[256];
+    strncpy(buffer, text, sizeof(buffer) - 1);
+    buffer[sizeof(buffer) - 1] = '\0';
+
+    for (char *tok = strtok(buffer, ","); tok != NULL && n < max_values; tok = strtok(NULL, ",")) {
+        int v = atoi(tok);
+        if (v > 0) values[n++] = v;
+    }
+    return n;
+}
+
+/**
+ * 解析逗号分隔的调度算法名称列表（不区分大小写）
+ * @return 解析出的个数，遇到未知名称时打印错误并返回-1
+ */
+int parse_algorithm_list(const char *text, int *values, int max_values) {
+    int n = 0;
+    char buffer[256];
+    strncpy(buffer, text, sizeof(buffer) - 1);
+    buffer[sizeof(buffer) - 1] = '\0';
+
+    for (char *tok = strtok(buffer, ","); tok != NULL && n < max_values; tok = strtok(NULL, ",")) {
+        int a = parse_sched_algorithm(tok);
+        if (a < 0) {
+            print_colored("未知调度算法: %s\n", RED, tok);
+            return -1;
+        }
+        values[n++] = a;
+    }
+    return n;
+}
+
+static void print_sweep_usage(const char *prog) {
+    print_colored("用法: %s sweep [选项]\n", YELLOW, prog);
+    print_colored("  -n 数量    生成的进程数量 (默认 100000)\n", WHITE);
+    print_colored("  -s 种子    随机种子 (默认 1)\n", WHITE);
+    print_colored("  -f 文件    从文件加载工作负载 (每行: 名称 优先级 到达时间 服务时间 [截止期限 [CPU突发 设备]])\n", WHITE);
+    print_colored("  -a 算法    逗号分隔的算法列表 (默认全部算法)\n", WHITE);
+    print_colored("  -q 片长    逗号分隔的时间片列表，用于RR、Stride、Lottery和MLFQ第0级 (默认 1,2,4,8,16)\n", WHITE);
+    print_colored("  -l 级数    MLFQ队列级数 (默认 3)\n", WHITE);
+    print_colored("  -b 周期    MLFQ优先级提升周期，0表示不提升 (默认 500)\n", WHITE);
+    print_colored("  -g 周期    抢占式优先级每等待多少时间单位优先级加1，0表示不老化 (默认 100)\n", WHITE);
+    print_colored("  -M 片长    CFS最小时间片 (默认 1)\n", WHITE);
+    print_colored("  -L 周期    CFS调度周期 (默认 24)\n", WHITE);
+    print_colored("  -j 线程    线程数 (默认为全部CPU)\n", WHITE);
+    print_colored("  -r 频率    实时仪表盘每秒刷新次数，0表示不显示 (默认 0)\n", WHITE);
+}
+
+/**
+ * 参数扫描命令行入口
+ * @return 进程退出码
+ */
+int sweep_main(int argc, char *argv[]) {
+    int count = 100000;
+    unsigned int seed = 1;
+    const char *path = NULL;
+    int algorithms[ALGO_COUNT * 4];
+    int num_algorithms = 0;
+    int quanta[32] = {1, 2, 4, 8, 16};
+    int num_quanta = 5;
+    int num_threads = 0;
+    int mlfq_levels = 3;
+    int boost_interval = 500;
+    int aging_interval = 100;
+    int min_granularity = 1;
+    int target_latency = 24;
+    int refresh_hz = 0;
+
+    for (int i = 0; i < ALGO_COUNT; i++) {
+        algorithms[num_algorithms++] = i;
+    }
+
+    for (int i = 1; i < argc; i++) {
+        const char *opt = argv[i];
+        const char *value = (i + 1 < argc) ? argv[i + 1] : NULL;
+
+        if (value == NULL || opt[0] != '-' || opt[1] == '\0' || opt[2] != '\0') {
+            print_sweep_usage(argv[0]);
+            return 1;
+        }
+
+        switch (opt[1]) {
+            case 'n': count = atoi(value); break;
+            case 's': seed = (unsigned int)strtoul(value, NULL, 10); break;
+            case 'f': path = value; break;
+            case 'a':
+                num_algorithms = parse_algorithm_list(value, algorithms,
+                                                      sizeof(algorithms) / sizeof(algorithms[0]));
+                if (num_algorithms <= 0) return 1;
+                break;
+            case 'q':
+                num_quanta = parse_int_list(value, quanta, sizeof(quanta) / sizeof(quanta[0]));
+                if (num_quanta <= 0) {
+                    print_colored("无效的时间片列表: %s\n", RED, value);
+                    return 1;
+                }
+                break;
+            case 'j': num_threads = atoi(value); break;
+            case 'l': mlfq_levels = atoi(value); break;
+            case 'b': boost_interval = atoi(value); break;
+            case 'g': aging_interval = atoi(value); break;
+            case 'M': min_granularity = atoi(value); break;
+            case 'L': target_latency = atoi(value); break;
+            case 'r': refresh_hz = atoi(value); break;
+            default:
+                print_sweep_usage(argv[0]);
+                return 1;
+        }
+        i++;
+    }
+
+    PCB *workload;
+    if (path != NULL) {
+        workload = load_workload(path, &count);
+    } else if (count > 0) {
+        workload = generate_workload(count, seed);
+    } else {
+        print_colored("进程数量必须大于0\n", RED);
+        return 1;
+    }
+    if (workload == NULL) return 1;
+
+    // 展开参数网格：使用时间片的算法对每个时间片各跑一次，其他算法只跑一次
+    SweepJob jobs[MAX_SWEEP_JOBS];
+    int num_jobs = 0;
+    memset(jobs, 0, sizeof(jobs));
+
+    for (int a = 0; a < num_algorithms; a++) {
+        int repeats = sched_uses_quantum((SchedAlgorithm)algorithms[a]) ? num_quanta : 1;
+        for (int q = 0; q < repeats && num_jobs < MAX_SWEEP_JOBS; q++) {
+            jobs[num_jobs].config.algorithm = (SchedAlgorithm)algorithms[a];
+            jobs[num_jobs].config.time_quantum = quanta[q];
+            jobs[num_jobs].config.mlfq_levels = mlfq_levels;
+            jobs[num_jobs].config.boost_interval = boost_interval;
+            jobs[num_jobs].config.aging_interval = aging_interval;
+            jobs[num_jobs].config.min_granularity = min_granularity;
+            jobs[num_jobs].config.target_latency = target_latency;
+            jobs[num_jobs].config.random_seed = seed;
+            jobs[num_jobs].config.verbose = 0;
+            num_jobs++;
+        }
+    }
+
+    print_colored("工作负载: %d 个进程, 实验点: %d\n", CYAN, count, num_jobs);
+
+    double start = now_ms();
+    int result = run_sweep(workload, count, jobs, num_jobs, num_threads, refresh_hz);
+    double elapsed = now_ms() - start;
+
+    if (result == 0) {
+        print_sweep_results(jobs, num_jobs);
+        print_colored("总耗时: %.1f ms\n", YELLOW, elapsed);
+    }
+
+    free(workload);
+    return result == 0 ? 0 : 1;
+}
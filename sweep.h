@@ -0,0 +1,41 @@
+#ifndef SWEEP_H
+#define SWEEP_H
+
+#include "process_control.h"
+#include "simulator.h"
+
+#define SHORT_JOB_THRESHOLD 10      // 服务时间不超过此值的视为短作业
+
+// 单个实验点（一组调度参数）及其结果
+typedef struct {
+    SchedConfig config;         // 调度参数
+    int ok;                     // 模拟是否成功
+    int makespan;               // 全部完成的时刻
+    double throughput;          // 每时间单位完成的进程数
+    double avg_turnaround;      // 平均周转时间
+    double avg_weighted;        // 平均带权周转时间
+    double avg_waiting;         // 平均等待时间
+    int p50_waiting;            // 等待时间分位数
+    int p90_waiting;
+    int p99_waiting;
+    int p999_waiting;
+    int max_waiting;
+    int p99_turnaround;         // 周转时间p99
+    double avg_response_short;  // 短作业平均响应时间
+    double avg_turnaround_long; // 长作业平均周转时间
+    double long_throughput;     // 长作业吞吐量（长作业数 / 最后一个长作业完成时刻）
+    long long decisions;        // 调度决策次数
+    double elapsed_ms;          // 实际耗时（毫秒）
+} SweepJob;
+
+// 参数扫描函数
+int run_sweep(const PCB *workload, int count, SweepJob *jobs, int num_jobs, int num_threads,
+              int refresh_hz);
+void print_sweep_results(const SweepJob *jobs, int num_jobs);
+int sweep_main(int argc, char *argv[]);
+
+// 各实验命令行共用的参数解析
+int parse_int_list(const char *text, int *values, int max_values);
+int parse_algorithm_list(const char *text, int *values, int max_values);
+
+#endif // SWEEP_H
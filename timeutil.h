@@ -0,0 +1,20 @@
+#ifndef TIMEUTIL_H
+#define TIMEUTIL_H
+
+#include <time.h>
+
+// 单调时钟读数，只用于计算耗时，不受系统时间调整影响
+
+static inline double now_ms() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000.0 + ts.tv_nsec / 1e6;
+}
+
+static inline long long now_ns() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+
+#endif // TIMEUTIL_H
@@ -1,6 +1,9 @@
+#include <errno.h>
+#include <signal.h>
 #include <stdio.h>
 #include <stdarg.h>
 #include <stdlib.h>
+#include <string.h>
 #include <unistd.h>
 #include <math.h>
 #include "account.h"
@@ -21,28 +24,505 @@ const char* color_codes[] = {
 // 重置颜色代码
 const char* reset_color = "\033[0m";
 
+// 静默模式：批量实验时关闭所有输出
+static int quiet_mode = 0;
+
+// 是否输出控制序列，-1 表示尚未按 OUTPUT_AUTO 检测
+static int ansi_output = -1;
+
+// 是否处于备用屏幕，信号处理函数也会读取
+static volatile sig_atomic_t alternate_screen = 0;
+
+#define LEAVE_ALTERNATE_SCREEN "\033[?25h\033[?1049l"    // 恢复光标并回到主屏幕
+
+#define FRAME_DIFF_GAP 8        // 同一行两处改动相隔不超过此列数时连同中间的字符一起输出，比移动光标更省
+#define FRAME_TEXT_MAX 512      // frame_text 单次格式化的最大字节数
+
+/**
+ * 设置静默模式
+ * @param quiet 非零时 print_colored 不再输出任何内容
+ */
+void set_quiet_mode(int quiet) {
+    quiet_mode = quiet;
+}
+
+/**
+ * 查询是否处于静默模式
+ * @return 静默时返回1，否则返回0
+ */
+int is_quiet_mode() {
+    return quiet_mode;
+}
+
+// 标准输出是终端且 TERM 不是 dumb 时使用控制序列，结果在第一次调用时确定
+static int use_ansi() {
+    if (ansi_output < 0) {
+        const char *term = getenv("TERM");
+        ansi_output = isatty(STDOUT_FILENO) && term != NULL && strcmp(term, "dumb") != 0;
+    }
+    return ansi_output;
+}
+
+/**
+ * 设置输出模式，默认为 OUTPUT_AUTO
+ */
+void set_output_mode(OutputMode mode) {
+    ansi_output = (mode == OUTPUT_AUTO) ? -1 : (mode == OUTPUT_ANSI);
+}
+
 /**
- * 使用颜色打印格式化文本
+ * 是否输出到交互式终端（使用颜色和光标控制）
+ * @return 是返回1，纯文本输出返回0
+ */
+int is_interactive_output() {
+    return use_ansi();
+}
+
+/**
+ * 演示用的延时，只在交互式终端中生效，在脚本和基准测试中直接返回
+ * @param usec 微秒
+ */
+void display_delay(int usec) {
+    if (use_ansi() && !quiet_mode) {
+        usleep(usec);
+    }
+}
+
+/**
+ * 使用颜色打印格式化文本，纯文本模式下不输出颜色码
  * @param format 格式化字符串
  * @param color 文本颜色
  * @param ... 变量参数列表
  */
 void print_colored(const char* format, Color color, ...) {
-    printf("%s", color_codes[color]);
+    if (quiet_mode) return;
+    
+    int ansi = use_ansi();
+    if (ansi) {
+        fputs(color_codes[color], stdout);
+    }
     
     va_list args;
     va_start(args, color);
     vprintf(format, args);
     va_end(args);
     
-    printf("%s", reset_color);
+    if (ansi) {
+        fputs(reset_color, stdout);
+    }
+}
+
+// UTF-8 字符的字节数，非法的首字节按单字节处理
+static int glyph_length(unsigned char lead) {
+    if ((lead & 0xE0) == 0xC0) return 2;
+    if ((lead & 0xF0) == 0xE0) return 3;
+    if ((lead & 0xF8) == 0xF0) return 4;
+    return 1;
+}
+
+// 字符在终端中是否占两列（CJK文字、全角标点、韩文）
+static int glyph_is_wide(const char *glyph, int len) {
+    unsigned int cp;
+    if (len == 3) {
+        cp = ((glyph[0] & 0x0F) << 12) | ((glyph[1] & 0x3F) << 6) | (glyph[2] & 0x3F);
+    } else if (len == 4) {
+        return 1;   // 补充平面中的表意文字和表情符号
+    } else {
+        return 0;
+    }
+    return (cp >= 0x1100 && cp <= 0x115F) || (cp >= 0x2E80 && cp <= 0xA4CF) ||
+           (cp >= 0xAC00 && cp <= 0xD7A3) || (cp >= 0xF900 && cp <= 0xFAFF) ||
+           (cp >= 0xFE30 && cp <= 0xFE4F) || (cp >= 0xFF00 && cp <= 0xFF60) ||
+           (cp >= 0xFFE0 && cp <= 0xFFE6);
+}
+
+static int cell_is_blank(const FrameCell *cell) {
+    return cell->glyph[0] == ' ' && cell->glyph[1] == '\0';
+}
+
+// 宽字符的第二格
+static int cell_is_continuation(const FrameCell *cell) {
+    return cell->glyph[0] == '\0';
+}
+
+static void set_blank(FrameCell *cell) {
+    memset(cell->glyph, 0, sizeof(cell->glyph));
+    cell->glyph[0] = ' ';
+    cell->color = WHITE;
+}
+
+/**
+ * 创建帧缓冲，字符格和输出缓冲区一次分配，之后的组装和输出不再分配内存
+ * @param width 列数
+ * @param height 行数
+ * @return 新的帧缓冲（内容为空白），失败返回NULL
+ */
+Frame* create_frame(int width, int height) {
+    if (width <= 0 || height <= 0) return NULL;
+
+    Frame *frame = (Frame*)malloc(sizeof(Frame));
+    if (frame == NULL) return NULL;
+
+    size_t cells = (size_t)width * height;
+    frame->width = width;
+    frame->height = height;
+    frame->has_shown = 0;
+    frame->overlay = 0;
+    // 最坏情况：每格一个颜色码和4字节字符，每行若干光标移动
+    frame->out_capacity = cells * 12 + (size_t)height * 24 + 64;
+    frame->cells = (FrameCell*)malloc(sizeof(FrameCell) * cells);
+    frame->shown = (FrameCell*)malloc(sizeof(FrameCell) * cells);
+    frame->out = (char*)malloc(frame->out_capacity);
+    if (frame->cells == NULL || frame->shown == NULL || frame->out == NULL) {
+        destroy_frame(frame);
+        return NULL;
+    }
+
+    frame_clear(frame);
+    return frame;
 }
 
 /**
- * 清空屏幕
+ * 把帧内容清为空白，不影响差分重绘所比较的上一帧
+ */
+void frame_clear(Frame *frame) {
+    size_t cells = (size_t)frame->width * frame->height;
+    for (size_t i = 0; i < cells; i++) {
+        set_blank(&frame->cells[i]);
+    }
+}
+
+// 在 (row, col) 放一个字符，覆盖半个宽字符时把另一半清为空白
+// @return 占用的列数，超出帧范围时返回0
+static int put_glyph(Frame *frame, int row, int col, const char *glyph, int len, Color color) {
+    if (row < 0 || row >= frame->height || col < 0 || col >= frame->width) return 0;
+
+    int wide = glyph_is_wide(glyph, len);
+    if (wide && col + 1 >= frame->width) return 0;
+
+    FrameCell *line = &frame->cells[(size_t)row * frame->width];
+    int span = wide ? 2 : 1;
+    if (cell_is_continuation(&line[col]) && col > 0) {
+        set_blank(&line[col - 1]);
+    }
+    if (col + span < frame->width && cell_is_continuation(&line[col + span])) {
+        set_blank(&line[col + span]);
+    }
+
+    memset(line[col].glyph, 0, sizeof(line[col].glyph));
+    memcpy(line[col].glyph, glyph, len);
+    line[col].color = color;
+    if (wide) {
+        memset(line[col + 1].glyph, 0, sizeof(line[col + 1].glyph));
+        line[col + 1].color = color;
+    }
+    return span;
+}
+
+/**
+ * 在指定位置放一个字符
+ * @param glyph 一个UTF-8字符，多余的字节被忽略
+ */
+void frame_put(Frame *frame, int row, int col, const char *glyph, Color color) {
+    put_glyph(frame, row, col, glyph, glyph_length((unsigned char)glyph[0]), color);
+}
+
+/**
+ * 从指定位置起写入格式化文本，超出行尾的部分被截断，不处理换行
+ * @return 文本之后的列号
+ */
+int frame_text(Frame *frame, int row, int col, Color color, const char *format, ...) {
+    char text[FRAME_TEXT_MAX];
+    va_list args;
+    va_start(args, format);
+    vsnprintf(text, sizeof(text), format, args);
+    va_end(args);
+
+    for (const char *s = text; *s != '\0' && col < frame->width; ) {
+        int len = glyph_length((unsigned char)*s);
+        if ((int)strnlen(s, len) < len) break;      // 截断的多字节字符
+        int used = put_glyph(frame, row, col, s, len, color);
+        if (used == 0) break;
+        col += used;
+        s += len;
+    }
+    return col;
+}
+
+/**
+ * 文本在终端中占的列数，宽字符（如汉字）计2列
+ * @return 列数
+ */
+int text_width(const char *text) {
+    int width = 0;
+    for (const char *s = text; *s != '\0'; ) {
+        int len = glyph_length((unsigned char)*s);
+        if ((int)strnlen(s, len) < len) break;
+        width += glyph_is_wide(s, len) ? 2 : 1;
+        s += len;
+    }
+    return width;
+}
+
+/**
+ * 打印表格的一行 "| 单元格 | ... |"，每个单元格按显示宽度左对齐到 widths[i] 列，超宽时不截断
+ * @param widths 各列宽度
+ * @param count 列数，其后为 count 个已格式化的字符串
+ */
+void print_table_row(Color color, const int *widths, int count, ...) {
+    char line[FRAME_TEXT_MAX * 2];
+    size_t used = 0;
+    va_list args;
+    va_start(args, count);
+    for (int i = 0; i < count && used < sizeof(line); i++) {
+        const char *cell = va_arg(args, const char *);
+        int pad = widths[i] - text_width(cell);
+        used += snprintf(line + used, sizeof(line) - used, "| %s%*s ", cell, pad > 0 ? pad : 0, "");
+    }
+    va_end(args);
+    print_colored("%s|\n", color, line);
+}
+
+/**
+ * 打印与 print_table_row 同宽的分隔线
+ */
+void print_table_rule(Color color, const int *widths, int count) {
+    char line[FRAME_TEXT_MAX];
+    int total = 1;
+    for (int i = 0; i < count; i++) {
+        total += widths[i] + 3;
+    }
+    if (total >= (int)sizeof(line)) total = sizeof(line) - 1;
+    memset(line, '-', total);
+    line[total] = '\0';
+    print_colored("%s\n", color, line);
+}
+
+// 输出缓冲区的写入位置和当前颜色（-1 表示尚未输出颜色码）
+typedef struct {
+    char *buffer;
+    size_t length;
+    int color;
+    int ansi;               // 为0时不输出颜色码
+} FrameWriter;
+
+static void writer_append(FrameWriter *writer, const char *data, size_t size) {
+    memcpy(writer->buffer + writer->length, data, size);
+    writer->length += size;
+}
+
+// 光标控制序列 ESC [ n 后接 command
+static void writer_cursor(FrameWriter *writer, int n, char command) {
+    writer->length += sprintf(writer->buffer + writer->length, "\033[%d%c", n, command);
+}
+
+// 输出一个字符格；空白不关心颜色，其余字符只在颜色变化时输出颜色码
+static void writer_cell(FrameWriter *writer, const FrameCell *cell) {
+    if (cell_is_continuation(cell)) return;
+    if (writer->ansi && !cell_is_blank(cell) && cell->color != writer->color) {
+        const char *code = color_codes[cell->color];
+        writer_append(writer, code, strlen(code));
+        writer->color = cell->color;
+    }
+    writer_append(writer, cell->glyph, strnlen(cell->glyph, sizeof(cell->glyph)));
+}
+
+// 逐行输出整帧，省略行尾空白，输出后光标位于帧下方一行的行首
+static void render_full(const Frame *frame, FrameWriter *writer) {
+    for (int r = 0; r < frame->height; r++) {
+        const FrameCell *line = &frame->cells[(size_t)r * frame->width];
+        int last = frame->width - 1;
+        while (last >= 0 && cell_is_blank(&line[last])) last--;
+        for (int c = 0; c <= last; c++) {
+            writer_cell(writer, &line[c]);
+        }
+        writer_append(writer, "\n", 1);
+    }
+}
+
+// 光标从帧下方一行回到帧顶，只改写与上一帧不同的字符格，再回到帧下方一行
+static void render_diff(const Frame *frame, FrameWriter *writer) {
+    int width = frame->width;
+    int cur_row = 0, cur_col = 0;
+
+    writer_cursor(writer, frame->height, 'A');
+    writer_append(writer, "\r", 1);
+
+    for (int r = 0; r < frame->height; r++) {
+        const FrameCell *line = &frame->cells[(size_t)r * width];
+        const FrameCell *old = &frame->shown[(size_t)r * width];
+        int c = 0;
+
+        while (c < width) {
+            if (memcmp(&line[c], &old[c], sizeof(FrameCell)) == 0) {
+                c++;
+                continue;
+            }
+
+            // 向后合并相隔不远的改动，宽字符必须整体输出
+            int start = c, end = c;
+            for (int k = c + 1; k < width && k - end <= FRAME_DIFF_GAP; k++) {
+                if (memcmp(&line[k], &old[k], sizeof(FrameCell)) != 0) end = k;
+            }
+            if (start > 0 && cell_is_continuation(&line[start])) start--;
+            if (end + 1 < width && cell_is_continuation(&line[end + 1])) end++;
+
+            if (r > cur_row) {
+                writer_cursor(writer, r - cur_row, 'B');
+                cur_row = r;
+            }
+            if (start < cur_col) {
+                writer_append(writer, "\r", 1);
+                cur_col = 0;
+            }
+            if (start > cur_col) {
+                writer_cursor(writer, start - cur_col, 'C');
+            }
+            for (int k = start; k <= end; k++) {
+                writer_cell(writer, &line[k]);
+            }
+            cur_col = end + 1;
+            c = end + 1;
+        }
+    }
+
+    writer_cursor(writer, frame->height - cur_row, 'B');
+    writer_append(writer, "\r", 1);
+}
+
+// 写出全部数据，被信号中断时继续
+static int write_all(const char *data, size_t size) {
+    while (size > 0) {
+        ssize_t written = write(STDOUT_FILENO, data, size);
+        if (written < 0) {
+            if (errno == EINTR) continue;
+            return -1;
+        }
+        data += written;
+        size -= written;
+    }
+    return 0;
+}
+
+/**
+ * 输出帧：第一次输出整帧，之后光标回到帧顶只改写变化的字符格，没有变化时不输出。
+ * 纯文本模式下只输出第一次的整帧（不含颜色码），重绘被忽略。
+ * 先刷新 stdout，保证与之前 print_colored 的输出顺序一致
+ * @return 写出的字节数，失败返回-1
+ */
+int frame_render(Frame *frame) {
+    if (quiet_mode && !frame->overlay) return 0;
+
+    int ansi = use_ansi();
+    size_t cells = (size_t)frame->width * frame->height;
+    if (frame->has_shown && (!ansi || memcmp(frame->cells, frame->shown, sizeof(FrameCell) * cells) == 0)) {
+        return 0;
+    }
+
+    FrameWriter writer = { frame->out, 0, -1, ansi };
+    if (frame->has_shown) {
+        render_diff(frame, &writer);
+    } else {
+        render_full(frame, &writer);
+    }
+    if (writer.color >= 0) {
+        writer_append(&writer, reset_color, strlen(reset_color));
+    }
+
+    fflush(stdout);
+    if (write_all(writer.buffer, writer.length) != 0) {
+        return -1;
+    }
+    memcpy(frame->shown, frame->cells, sizeof(FrameCell) * cells);
+    frame->has_shown = 1;
+    return (int)writer.length;
+}
+
+/**
+ * 释放帧缓冲
+ */
+void destroy_frame(Frame *frame) {
+    if (frame == NULL) return;
+    free(frame->cells);
+    free(frame->shown);
+    free(frame->out);
+    free(frame);
+}
+
+/**
+ * 清空屏幕并把光标移到左上角，纯文本模式下不做任何事
  */
 void clear_screen() {
-    system("clear");
+    if (!use_ansi()) return;
+    move_cursor(1, 1);
+    fputs("\033[2J\033[3J", stdout);
+}
+
+/**
+ * 把光标移到第 row 行第 col 列（从1开始）
+ */
+void move_cursor(int row, int col) {
+    if (!use_ansi()) return;
+    printf("\033[%d;%dH", row, col);
+}
+
+/**
+ * 显示或隐藏光标，动画期间隐藏以免闪烁
+ */
+void set_cursor_visible(int visible) {
+    if (!use_ansi()) return;
+    fputs(visible ? "\033[?25h" : "\033[?25l", stdout);
+    fflush(stdout);
+}
+
+// 程序退出时回到主屏幕
+static void restore_screen_at_exit() {
+    leave_alternate_screen();
+}
+
+// 被信号终止前回到主屏幕，再按默认方式处理该信号
+static void restore_screen_on_signal(int sig) {
+    if (alternate_screen) {
+        write_all(LEAVE_ALTERNATE_SCREEN, sizeof(LEAVE_ALTERNATE_SCREEN) - 1);
+        alternate_screen = 0;
+    }
+    signal(sig, SIG_DFL);
+    raise(sig);
+}
+
+/**
+ * 切换到终端的备用屏幕，退出时恢复原来的屏幕内容；程序正常退出或被 SIGINT/SIGTERM/SIGHUP
+ * 终止时自动回到主屏幕。纯文本模式下不做任何事
+ */
+void enter_alternate_screen() {
+    static int handlers_installed = 0;
+    if (!use_ansi() || alternate_screen) return;
+
+    if (!handlers_installed) {
+        struct sigaction action;
+        memset(&action, 0, sizeof(action));
+        action.sa_handler = restore_screen_on_signal;
+        sigemptyset(&action.sa_mask);
+        sigaction(SIGINT, &action, NULL);
+        sigaction(SIGTERM, &action, NULL);
+        sigaction(SIGHUP, &action, NULL);
+        atexit(restore_screen_at_exit);
+        handlers_installed = 1;
+    }
+
+    fputs("\033[?1049h", stdout);
+    fflush(stdout);
+    alternate_screen = 1;
+}
+
+/**
+ * 回到主屏幕
+ */
+void leave_alternate_screen() {
+    if (!alternate_screen) return;
+    fflush(stdout);
+    write_all(LEAVE_ALTERNATE_SCREEN, sizeof(LEAVE_ALTERNATE_SCREEN) - 1);
+    alternate_screen = 0;
 }
 
 /**
@@ -50,25 +530,28 @@ void clear_screen() {
  * @param title 标题文本
  */
 void print_title(const char* title) {
-    int len = 0;
-    while (title[len] != '\0') len++;
-    
-    print_colored("\n", WHITE);
-    print_colored("┌", CYAN);
-    for (int i = 0; i < len + 4; i++) {
-        print_colored("─", CYAN);
+    // 字节数不小于显示宽度，按字节数分配列数足够
+    Frame *frame = create_frame((int)strlen(title) + 6, 5);
+    if (frame == NULL) {
+        print_colored("\n%s\n\n", YELLOW, title);
+        return;
     }
-    print_colored("┐\n", CYAN);
-    
-    print_colored("│  ", CYAN);
-    print_colored("%s", YELLOW, title);
-    print_colored("  │\n", CYAN);
-    
-    print_colored("└", CYAN);
-    for (int i = 0; i < len + 4; i++) {
-        print_colored("─", CYAN);
+
+    int end = frame_text(frame, 2, 0, CYAN, "│  ");
+    end = frame_text(frame, 2, end, YELLOW, "%s", title);
+    end = frame_text(frame, 2, end, CYAN, "  │");
+
+    frame_put(frame, 1, 0, "┌", CYAN);
+    frame_put(frame, 3, 0, "└", CYAN);
+    for (int c = 1; c < end - 1; c++) {
+        frame_put(frame, 1, c, "─", CYAN);
+        frame_put(frame, 3, c, "─", CYAN);
     }
-    print_colored("┘\n\n", CYAN);
+    frame_put(frame, 1, end - 1, "┐", CYAN);
+    frame_put(frame, 3, end - 1, "┘", CYAN);
+
+    frame_render(frame);
+    destroy_frame(frame);
 }
 
 /**
@@ -86,6 +569,8 @@ void print_menu() {
     print_colored("│ 6. 显示账户图表              │\n", WHITE);
     print_colored("│ 7. 显示余额历史              │\n", WHITE);
     print_colored("│ 8. 运行自动测试              │\n", WHITE);
+    print_colored("│ 9. 实时仪表盘压力测试        │\n", WHITE);
+    print_colored("│ 10. 导出账户数据             │\n", WHITE);
     print_colored("│ 0. 退出                     │\n", WHITE);
     print_colored("└─────────────────────────────┘\n", CYAN);
     print_colored("请选择操作: ", YELLOW);
@@ -97,6 +582,12 @@ void print_menu() {
  * @param num_accounts 账户数量
  */
 void draw_account_chart(Account** accounts, int num_accounts) {
+    // 账户很多时逐个画条形图既看不清也太慢，改为固定大小的总览
+    if (num_accounts > ACCOUNT_CHART_MAX_BARS) {
+        draw_account_overview(accounts, num_accounts);
+        return;
+    }
+    
     // 找出最大余额，用于缩放
     double max_balance = 1.0; // 防止所有账户余额为0的情况
     for (int i = 0; i < num_accounts; i++) {
@@ -106,73 +597,236 @@ void draw_account_chart(Account** accounts, int num_accounts) {
     }
     
     const int MAX_BAR_WIDTH = 50;
+    const int LABEL_WIDTH = 40;     // 账户信息最多占用的列数
     
     print_title("账户余额分布图");
     
+    Frame *frame = create_frame(LABEL_WIDTH + MAX_BAR_WIDTH, num_accounts + 1);
+    if (frame == NULL) {
+        perror("内存分配失败");
+        return;
+    }
+    
     for (int i = 0; i < num_accounts; i++) {
         int bar_width = (int)((accounts[i]->balance / max_balance) * MAX_BAR_WIDTH);
         if (bar_width < 1) bar_width = 1;
         
-        // 打印账户信息
-        print_colored("账户 %d (¥%.2f): ", WHITE, accounts[i]->account_id, accounts[i]->balance);
-        
-        // 打印余额条形图
+        // 账户信息后接余额条形图
+        int col = frame_text(frame, i, 0, WHITE, "账户 %d (¥%.2f): ", accounts[i]->account_id, accounts[i]->balance);
         for (int j = 0; j < bar_width; j++) {
-            print_colored("█", GREEN);
+            frame_put(frame, i, col + j, "█", GREEN);
         }
-        print_colored("\n", WHITE);
     }
-    print_colored("\n", WHITE);
+    
+    frame_render(frame);
+    destroy_frame(frame);
+}
+
+// 余额分桶的上界（不含），最后一个桶没有上界
+static const double overview_bounds[OVERVIEW_BUCKETS - 1] = {
+    1, 10, 100, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8
+};
+static const char *overview_bound_labels[OVERVIEW_BUCKETS - 1] = {
+    "1", "10", "100", "1千", "1万", "10万", "100万", "1000万", "1亿"
+};
+
+// 把 (id, balance) 放入以余额为键的小顶堆，堆满时只替换比堆顶大的账户
+static void top_push(AccountOverview *overview, int id, double balance) {
+    int *ids = overview->top_ids;
+    double *values = overview->top_balances;
+    int i;
+    
+    if (overview->top_count < OVERVIEW_TOP) {
+        i = overview->top_count++;
+        while (i > 0 && values[(i - 1) / 2] > balance) {
+            ids[i] = ids[(i - 1) / 2];
+            values[i] = values[(i - 1) / 2];
+            i = (i - 1) / 2;
+        }
+    } else {
+        if (balance <= values[0]) return;
+        i = 0;
+        while (1) {
+            int child = 2 * i + 1;
+            if (child >= OVERVIEW_TOP) break;
+            if (child + 1 < OVERVIEW_TOP && values[child + 1] < values[child]) child++;
+            if (values[child] >= balance) break;
+            ids[i] = ids[child];
+            values[i] = values[child];
+            i = child;
+        }
+    }
+    ids[i] = id;
+    values[i] = balance;
 }
 
 /**
- * 绘制账户余额历史图表
- * @param account 要显示历史的账户
+ * 一次遍历计算账户总览：总额、最值、按数量级的余额分布、余额最高的账户和各分片的汇总。
+ * 读取余额时不加锁，并发转账期间得到的是近似值
+ * @param accounts 账户数组
+ * @param num_accounts 账户数量
+ * @param overview 输出的汇总
  */
-void draw_balance_history(Account* account) {
-    if (account == NULL || account->history_size == 0) {
-        print_colored("没有可用的历史数据\n", RED);
+void compute_account_overview(Account** accounts, int num_accounts, AccountOverview *overview) {
+    memset(overview, 0, sizeof(AccountOverview));
+    if (num_accounts <= 0) return;
+    
+    overview->count = num_accounts;
+    overview->min_balance = accounts[0]->balance;
+    overview->max_balance = accounts[0]->balance;
+    
+    for (int i = 0; i < num_accounts; i++) {
+        double balance = accounts[i]->balance;
+        int id = accounts[i]->account_id;
+        
+        overview->total += balance;
+        overview->min_balance = balance < overview->min_balance ? balance : overview->min_balance;
+        overview->max_balance = balance > overview->max_balance ? balance : overview->max_balance;
+        
+        // 桶号等于不超过余额的上界个数，没有分支
+        int bucket = 0;
+        for (int k = 0; k < OVERVIEW_BUCKETS - 1; k++) {
+            bucket += balance >= overview_bounds[k];
+        }
+        overview->buckets[bucket]++;
+        
+        int shard = (id % OVERVIEW_SHARDS + OVERVIEW_SHARDS) % OVERVIEW_SHARDS;
+        overview->shard_counts[shard]++;
+        overview->shard_totals[shard] += balance;
+        
+        if (overview->top_count < OVERVIEW_TOP || balance > overview->top_balances[0]) {
+            top_push(overview, id, balance);
+        }
+    }
+    
+    // 堆排序为从高到低
+    for (int n = overview->top_count - 1; n > 0; n--) {
+        int id = overview->top_ids[n];
+        double balance = overview->top_balances[n];
+        overview->top_ids[n] = overview->top_ids[0];
+        overview->top_balances[n] = overview->top_balances[0];
+        
+        int i = 0;
+        while (1) {
+            int child = 2 * i + 1;
+            if (child >= n) break;
+            if (child + 1 < n && overview->top_balances[child + 1] < overview->top_balances[child]) child++;
+            if (overview->top_balances[child] >= balance) break;
+            overview->top_ids[i] = overview->top_ids[child];
+            overview->top_balances[i] = overview->top_balances[child];
+            i = child;
+        }
+        overview->top_ids[i] = id;
+        overview->top_balances[i] = balance;
+    }
+}
+
+// 在 frame 的一行中画长度按 peak 缩放的条形图，非零值至少画一格
+static void overview_bar(Frame *frame, int row, int col, int width, double value, double peak, Color color) {
+    int length = peak > 0 ? (int)(value / peak * width) : 0;
+    if (length < 1 && value > 0) length = 1;
+    for (int j = 0; j < length; j++) {
+        frame_put(frame, row, col + j, "█", color);
+    }
+}
+
+/**
+ * 绘制账户总览：余额分布、余额最高的账户和分片汇总，占用的屏幕空间与账户数无关
+ * @param accounts 账户数组
+ * @param num_accounts 账户数量
+ */
+void draw_account_overview(Account** accounts, int num_accounts) {
+    const int LABEL_WIDTH = 22;
+    const int BAR_WIDTH = 40;
+    
+    AccountOverview overview;
+    compute_account_overview(accounts, num_accounts, &overview);
+    
+    print_title("账户总览");
+    
+    // 汇总行，三个小节各有一个标题行，小节之间空一行
+    int height = 1 + (2 + OVERVIEW_BUCKETS) + (2 + overview.top_count) + (2 + OVERVIEW_SHARDS);
+    Frame *frame = create_frame(LABEL_WIDTH + BAR_WIDTH + 24, height);
+    if (frame == NULL) {
+        perror("内存分配失败");
         return;
     }
     
-    // 找出最大和最小余额，用于缩放
-    double max_balance = account->history[0];
-    double min_balance = account->history[0];
+    int row = 0;
+    frame_text(frame, row++, 0, WHITE, "账户 %d 个  总余额 ¥%.2f  平均 ¥%.2f  最低 ¥%.2f  最高 ¥%.2f",
+               overview.count, overview.total, overview.count > 0 ? overview.total / overview.count : 0.0,
+               overview.min_balance, overview.max_balance);
     
-    for (int i = 1; i < account->history_size; i++) {
-        if (account->history[i] > max_balance) {
-            max_balance = account->history[i];
-        }
-        if (account->history[i] < min_balance) {
-            min_balance = account->history[i];
+    long long peak_bucket = 0;
+    for (int b = 0; b < OVERVIEW_BUCKETS; b++) {
+        if (overview.buckets[b] > peak_bucket) peak_bucket = overview.buckets[b];
+    }
+    row++;
+    frame_text(frame, row++, 0, CYAN, "余额分布（按数量级）");
+    for (int b = 0; b < OVERVIEW_BUCKETS; b++, row++) {
+        if (b == 0) {
+            frame_text(frame, row, 0, WHITE, "< ¥%s", overview_bound_labels[0]);
+        } else if (b == OVERVIEW_BUCKETS - 1) {
+            frame_text(frame, row, 0, WHITE, ">= ¥%s", overview_bound_labels[b - 1]);
+        } else {
+            frame_text(frame, row, 0, WHITE, "¥%s ~ ¥%s", overview_bound_labels[b - 1], overview_bound_labels[b]);
         }
+        overview_bar(frame, row, LABEL_WIDTH, BAR_WIDTH, (double)overview.buckets[b], (double)peak_bucket, GREEN);
+        frame_text(frame, row, LABEL_WIDTH + BAR_WIDTH + 1, WHITE, "%lld", overview.buckets[b]);
     }
     
-    if (max_balance == min_balance) {
-        max_balance += 100; // 防止最大和最小值相等
+    row++;
+    frame_text(frame, row++, 0, CYAN, "余额最高的 %d 个账户", overview.top_count);
+    for (int i = 0; i < overview.top_count; i++, row++) {
+        frame_text(frame, row, 0, WHITE, "账户 %d", overview.top_ids[i]);
+        overview_bar(frame, row, LABEL_WIDTH, BAR_WIDTH, overview.top_balances[i], overview.top_balances[0], YELLOW);
+        frame_text(frame, row, LABEL_WIDTH + BAR_WIDTH + 1, WHITE, "¥%.2f", overview.top_balances[i]);
+    }
+    
+    double peak_shard = 0.0;
+    for (int s = 0; s < OVERVIEW_SHARDS; s++) {
+        if (overview.shard_totals[s] > peak_shard) peak_shard = overview.shard_totals[s];
+    }
+    row++;
+    frame_text(frame, row++, 0, CYAN, "分片汇总（账户ID %% %d）", OVERVIEW_SHARDS);
+    for (int s = 0; s < OVERVIEW_SHARDS; s++, row++) {
+        frame_text(frame, row, 0, WHITE, "分片 %d (%d 个)", s, overview.shard_counts[s]);
+        overview_bar(frame, row, LABEL_WIDTH, BAR_WIDTH, overview.shard_totals[s], peak_shard, MAGENTA);
+        frame_text(frame, row, LABEL_WIDTH + BAR_WIDTH + 1, WHITE, "¥%.2f", overview.shard_totals[s]);
+    }
+    
+    frame_render(frame);
+    destroy_frame(frame);
+}
+
+/**
+ * 绘制账户余额历史图表
+ * @param account 要显示历史的账户
+ */
+void draw_balance_history(Account* account) {
+    if (account == NULL || account->history_size == 0) {
+        print_colored("没有可用的历史数据\n", RED);
+        return;
     }
     
     const int CHART_HEIGHT = 10;
     const int CHART_WIDTH = 60;
     
-    char chart[CHART_HEIGHT][CHART_WIDTH];
+    // 整个历史压缩为每列一个 [最小值, 最大值] 区间，历史再长也只扫描一遍
+    double mins[CHART_WIDTH];
+    double maxs[CHART_WIDTH];
+    int columns = downsample_minmax(account->history, (size_t)account->history_size, CHART_WIDTH, mins, maxs);
     
-    // 初始化图表
-    for (int i = 0; i < CHART_HEIGHT; i++) {
-        for (int j = 0; j < CHART_WIDTH; j++) {
-            chart[i][j] = ' ';
-        }
+    // 找出最大和最小余额，用于缩放
+    double max_balance = maxs[0];
+    double min_balance = mins[0];
+    for (int j = 1; j < columns; j++) {
+        if (maxs[j] > max_balance) max_balance = maxs[j];
+        if (mins[j] < min_balance) min_balance = mins[j];
     }
     
-    // 绘制数据点
-    for (int i = 0; i < account->history_size && i < CHART_WIDTH; i++) {
-        double normalized = (account->history[i] - min_balance) / (max_balance - min_balance);
-        int y = CHART_HEIGHT - 1 - (int)(normalized * (CHART_HEIGHT - 1));
-        
-        if (y < 0) y = 0;
-        if (y >= CHART_HEIGHT) y = CHART_HEIGHT - 1;
-        
-        chart[y][i] = '*';
+    if (max_balance == min_balance) {
+        max_balance += 100; // 防止最大和最小值相等
     }
     
     // 修复后的代码：使用sprintf而不是+运算符拼接字符串
@@ -180,37 +834,97 @@ void draw_balance_history(Account* account) {
     sprintf(title_buffer, "账户 %d 余额历史", account->account_id);
     print_title(title_buffer);
     
-    // 打印Y轴标签
-    print_colored("¥%.2f ", WHITE, max_balance);
+    // 图表行、X轴、X轴标签和一个空行；Y轴标签最多占用 LABEL_WIDTH 列
+    const int LABEL_WIDTH = 32;
+    Frame *frame = create_frame(LABEL_WIDTH + CHART_WIDTH, CHART_HEIGHT + 3);
+    if (frame == NULL) {
+        perror("内存分配失败");
+        return;
+    }
     
-    // 打印图表
-    for (int i = 0; i < CHART_HEIGHT; i++) {
-        if (i > 0) {
-            print_colored("      ", WHITE);
-        }
+    // Y轴标签，图表从较长的标签之后开始
+    int left = frame_text(frame, 0, 0, WHITE, "¥%.2f ", max_balance);
+    int bottom_left = frame_text(frame, CHART_HEIGHT, 0, WHITE, "¥%.2f ", min_balance);
+    if (bottom_left > left) left = bottom_left;
+    
+    // 每列从最大值所在行画到最小值所在行，只有一个值时画一个点
+    double range = max_balance - min_balance;
+    for (int j = 0; j < columns; j++) {
+        int top = CHART_HEIGHT - 1 - (int)((maxs[j] - min_balance) / range * (CHART_HEIGHT - 1));
+        int bottom = CHART_HEIGHT - 1 - (int)((mins[j] - min_balance) / range * (CHART_HEIGHT - 1));
+        if (top < 0) top = 0;
+        if (bottom >= CHART_HEIGHT) bottom = CHART_HEIGHT - 1;
         
-        for (int j = 0; j < CHART_WIDTH && j < account->history_size; j++) {
-            if (chart[i][j] == '*') {
-                print_colored("●", CYAN);
-            } else {
-                print_colored(" ", WHITE);
-            }
+        for (int y = top; y <= bottom; y++) {
+            frame_put(frame, y, left + j, top == bottom ? "●" : "│", CYAN);
         }
-        print_colored("\n", WHITE);
     }
     
-    print_colored("¥%.2f ", WHITE, min_balance);
     for (int j = 0; j < CHART_WIDTH; j++) {
-        print_colored("─", WHITE);
+        frame_put(frame, CHART_HEIGHT, left + j, "─", WHITE);
+    }
+    frame_text(frame, CHART_HEIGHT + 1, left, YELLOW, "最早");
+    if (account->history_size > CHART_WIDTH) {
+        frame_text(frame, CHART_HEIGHT + 1, left + 14, WHITE, "共 %d 条，每列约 %d 条",
+                   account->history_size, (account->history_size + CHART_WIDTH - 1) / CHART_WIDTH);
     }
-    print_colored("\n      ", WHITE);
-    print_colored("最早", YELLOW);
+    frame_text(frame, CHART_HEIGHT + 1, left + CHART_WIDTH - 4, YELLOW, "最新");
     
-    for (int j = 0; j < CHART_WIDTH - 10; j++) {
-        print_colored(" ", WHITE);
+    frame_render(frame);
+    destroy_frame(frame);
+}
+
+// 求 values[start, end) 的最小值和最大值（end > start）。四组累加器互不依赖，
+// 循环体没有分支，便于编译器展开和向量化
+static void range_minmax(const double *values, size_t start, size_t end, double *min_out, double *max_out) {
+    double lo0 = values[start], lo1 = lo0, lo2 = lo0, lo3 = lo0;
+    double hi0 = lo0, hi1 = lo0, hi2 = lo0, hi3 = lo0;
+    size_t i = start;
+    
+    for (; i + 4 <= end; i += 4) {
+        double v0 = values[i], v1 = values[i + 1], v2 = values[i + 2], v3 = values[i + 3];
+        lo0 = v0 < lo0 ? v0 : lo0;
+        lo1 = v1 < lo1 ? v1 : lo1;
+        lo2 = v2 < lo2 ? v2 : lo2;
+        lo3 = v3 < lo3 ? v3 : lo3;
+        hi0 = v0 > hi0 ? v0 : hi0;
+        hi1 = v1 > hi1 ? v1 : hi1;
+        hi2 = v2 > hi2 ? v2 : hi2;
+        hi3 = v3 > hi3 ? v3 : hi3;
+    }
+    for (; i < end; i++) {
+        lo0 = values[i] < lo0 ? values[i] : lo0;
+        hi0 = values[i] > hi0 ? values[i] : hi0;
     }
     
-    print_colored("最新\n\n", YELLOW);
+    lo0 = lo1 < lo0 ? lo1 : lo0;
+    lo2 = lo3 < lo2 ? lo3 : lo2;
+    hi0 = hi1 > hi0 ? hi1 : hi0;
+    hi2 = hi3 > hi2 ? hi3 : hi2;
+    *min_out = lo2 < lo0 ? lo2 : lo0;
+    *max_out = hi2 > hi0 ? hi2 : hi0;
+}
+
+/**
+ * 最小/最大值降采样：把 count 个按时间排列的样本均分为 columns 段，求每段的最小值和最大值。
+ * 每个样本只读一次，绘出的图保留所有尖峰，不会像只取前若干个点那样丢掉后面的历史
+ * @param values 样本
+ * @param count 样本数
+ * @param columns 最多输出的列数
+ * @param mins 每列的最小值，至少 columns 个元素
+ * @param maxs 每列的最大值，至少 columns 个元素
+ * @return 实际输出的列数（样本少于 columns 时每个样本一列）
+ */
+int downsample_minmax(const double *values, size_t count, int columns, double *mins, double *maxs) {
+    if (values == NULL || count == 0 || columns <= 0) return 0;
+    if (count < (size_t)columns) columns = (int)count;
+    
+    for (int j = 0; j < columns; j++) {
+        size_t start = (size_t)j * count / columns;
+        size_t end = (size_t)(j + 1) * count / columns;
+        range_minmax(values, start, end, &mins[j], &maxs[j]);
+    }
+    return columns;
 }
 
 /**
@@ -222,20 +936,24 @@ void draw_balance_history(Account* account) {
 void draw_transaction_animation(int from_id, int to_id, double amount) {
     print_colored("\n转账进行中: ¥%.2f 从账户 %d -> 账户 %d\n", YELLOW, amount, from_id, to_id);
     
-    for (int i = 0; i < 10; i++) {
-        print_colored("\r[", WHITE);
-        for (int j = 0; j < 20; j++) {
-            if (j < i * 2) {
-                print_colored("=", GREEN);
-            } else {
-                print_colored(" ", WHITE);
+    // 进度条只占一行，之后每一帧只改写新增的 '=' 和百分比；纯文本模式下只输出最终状态
+    Frame *frame = create_frame(32, 1);
+    if (frame != NULL) {
+        set_cursor_visible(0);
+        for (int i = 0; i < 10 && is_interactive_output(); i++) {
+            frame_put(frame, 0, 0, "[", WHITE);
+            for (int j = 0; j < 20; j++) {
+                frame_put(frame, 0, 1 + j, j < i * 2 ? "=" : " ", j < i * 2 ? GREEN : WHITE);
             }
+            frame_text(frame, 0, 21, WHITE, "] %d%%", i * 10);
+            frame_render(frame);
+            display_delay(100000); // 100ms 延迟
         }
-        print_colored("] %d%%", WHITE, i * 10);
-        fflush(stdout);
-        usleep(100000); // 100ms 延迟
+        
+        frame_text(frame, 0, 0, GREEN, "[====================] 100%%");
+        frame_render(frame);
+        set_cursor_visible(1);
+        destroy_frame(frame);
     }
-    
-    print_colored("\r[====================] 100%%\n", GREEN);
     print_colored("转账完成!\n\n", GREEN);
 }
\ No newline at end of file
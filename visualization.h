@@ -1,6 +1,14 @@
 #ifndef VISUALIZATION_H
 #define VISUALIZATION_H
 
+#include <stddef.h>
+#include "account.h"
+
+#define ACCOUNT_CHART_MAX_BARS 20   // 账户数超过此值时 draw_account_chart 改为绘制总览
+#define OVERVIEW_BUCKETS 10         // 余额按数量级分桶：<1, [1,10), ..., >=1亿
+#define OVERVIEW_TOP 10             // 总览中显示余额最高的账户数
+#define OVERVIEW_SHARDS 8           // 按账户ID对分片数取模汇总
+
 // 颜色定义
 typedef enum {
     BLACK,
@@ -13,13 +21,82 @@ typedef enum {
     WHITE
 } Color;
 
+// 输出模式
+typedef enum {
+    OUTPUT_AUTO,        // 标准输出是终端时为 OUTPUT_ANSI，否则为 OUTPUT_PLAIN
+    OUTPUT_ANSI,        // 颜色、清屏、光标控制和差分重绘
+    OUTPUT_PLAIN        // 不含控制序列的纯文本：帧只输出一次，动画和演示延时被跳过
+} OutputMode;
+
+// 帧缓冲中的一个字符格，对应终端的一列。宽字符（如汉字）占两格，第二格的 glyph[0] 为0
+typedef struct {
+    char glyph[4];          // 一个UTF-8字符，不足4字节时以0结尾
+    unsigned char color;
+} FrameCell;
+
+// 帧缓冲：先在预分配的字符格中组装整帧，再一次 write() 输出；
+// 相同颜色的连续字符只输出一次颜色码，重绘时只输出与上一次不同的字符格
+typedef struct {
+    int width;
+    int height;
+    FrameCell *cells;       // 正在组装的帧
+    FrameCell *shown;       // 上一次输出到终端的帧
+    int has_shown;          // shown 是否有效，无效时下一次输出整帧
+    char *out;              // 输出缓冲区，容量按最坏情况预分配
+    size_t out_capacity;
+    int overlay;            // 为1时静默模式下仍然输出（实时仪表盘在静默的工作线程之上显示）
+} Frame;
+
+// 账户总览：一次遍历所有账户得到的汇总，大小与账户数无关
+typedef struct {
+    int count;
+    double total;
+    double min_balance;
+    double max_balance;
+    long long buckets[OVERVIEW_BUCKETS];
+    int top_count;
+    int top_ids[OVERVIEW_TOP];          // 按余额从高到低
+    double top_balances[OVERVIEW_TOP];
+    int shard_counts[OVERVIEW_SHARDS];
+    double shard_totals[OVERVIEW_SHARDS];
+} AccountOverview;
+
 // 可视化函数
 void print_colored(const char* format, Color color, ...);
+void set_quiet_mode(int quiet);
+int is_quiet_mode();
+void set_output_mode(OutputMode mode);
+int is_interactive_output();
+void display_delay(int usec);
 void clear_screen();
 void print_title(const char* title);
 void print_menu();
 void draw_account_chart(Account** accounts, int num_accounts);
+void compute_account_overview(Account** accounts, int num_accounts, AccountOverview *overview);
+void draw_account_overview(Account** accounts, int num_accounts);
 void draw_balance_history(Account* account);
 void draw_transaction_animation(int from_id, int to_id, double amount);
 
+// 表格函数：按显示宽度对齐，汉字计2列
+int text_width(const char *text);
+void print_table_row(Color color, const int *widths, int count, ...);
+void print_table_rule(Color color, const int *widths, int count);
+
+// 终端控制函数
+void enter_alternate_screen();
+void leave_alternate_screen();
+void move_cursor(int row, int col);
+void set_cursor_visible(int visible);
+
+// 帧缓冲函数
+Frame* create_frame(int width, int height);
+void frame_clear(Frame *frame);
+void frame_put(Frame *frame, int row, int col, const char *glyph, Color color);
+int frame_text(Frame *frame, int row, int col, Color color, const char *format, ...);
+int frame_render(Frame *frame);
+void destroy_frame(Frame *frame);
+
+// 图表数据函数
+int downsample_minmax(const double *values, size_t count, int columns, double *mins, double *maxs);
+
 #endif // VISUALIZATION_H
\ No newline at end of file